@@ -3,3 +3,4 @@
 
 #include <sini2D/geometry/Line.hpp>
 #include <sini2D/geometry/Polygon.hpp>
+#include <sini2D/geometry/Triangulation.hpp>
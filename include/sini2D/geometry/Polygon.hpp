@@ -25,23 +25,58 @@ struct Polygon {
     Polygon(std::initializer_list<vec2> vertices);
 
     std::vector<LineSegment> lines();
-    bool envelops(vec2 point);
+    // Even-odd (crossing number) test, in a single pass over the edges and
+    // without allocating. Points exactly on an edge may go either way.
+    bool envelops(vec2 point) const noexcept;
+    // Batched envelops() for 'count' points given as separate x and y arrays.
+    // out[i] is set to 1 if (xs[i], ys[i]) is inside the polygon and 0
+    // otherwise. Points are tested 8 at a time per edge with AVX2 or SSE2,
+    // depending on what the library is compiled for, with a scalar fallback.
+    // Points (almost) exactly on an edge may be classified differently than
+    // by envelops().
+    void envelopsBatch(const float* xs, const float* ys, size_t count,
+                       uint8_t* out) const;
+    // Triangulate the polygon, see sini2D/geometry/Triangulation.hpp. Goes
+    // through TriangulationCache::shared(), so rebuilding the mesh of a
+    // polygon with the same vertices is cheap.
     void buildTriangleMesh();
+};
+
+// Copy of a polygon's edges in a static interval tree over their y ranges,
+// for repeated point-in-polygon queries. Each edge is kept at the node whose
+// split line it spans, so the index takes O(n) memory. A query visits
+// O(log n) nodes and only tests the edges spanning the y of the point, which
+// for most polygons is a small number of edges rather than all n.
+// The index is a snapshot; later changes to the polygon are not reflected.
+class PreparedPolygon {
+public:
+    PreparedPolygon() noexcept = delete;
+    explicit PreparedPolygon(const Polygon& polygon);
+    explicit PreparedPolygon(const std::vector<vec2>& vertices);
+
+    // Same result as Polygon::envelops()
+    bool envelops(vec2 point) const noexcept;
 
 private:
-    std::vector<vec2i> outerEdgeList();
-    bool edgeUsedInExistingTriangles(vec2i edge_indices) noexcept;
-    bool intersectsOuterEdge(vec3i triangle_indices);
-    bool intersectsExistingTriangle(vec3i triangle_indices) noexcept;
-    bool trianglesIntersect(vec3i vertex_indices1, vec3i vertex_indices2) noexcept;
-    bool envelopsAnyVertex(vec3i vertex_indices);
-    bool hasEdgesOutsidePolygon(vec3i triangle_indices,
-                                const std::vector<vec2i>& outer_edges);
-    void updateOpenAndClosedEdges(std::vector<vec2i>& open_edges,
-                                  const std::vector<vec2i>& outer_edges,
-                                  vec3i triangle_indices);
-    bool tryCloseOpenEdges(std::vector<vec2i>& open_edges,
-                           std::vector<vec2i>& closed_edges);
+    struct Edge {
+        vec2 a, b;
+
+        float bottom() const noexcept { return a.y < b.y ? a.y : b.y; }
+        float top() const noexcept { return a.y < b.y ? b.y : a.y; }
+    };
+
+    struct Node {
+        float split;            // The node's edges all span this y
+        size_t first, last;     // Range of the node's edges in both arrays
+        int32_t below, above;   // Children, or -1
+    };
+
+    vec2 box_min, box_max;
+    std::vector<Node> nodes;    // The root first
+    // The edges of each node by increasing lower y, and by decreasing upper y
+    std::vector<Edge> edges_by_bottom, edges_by_top;
+
+    int32_t addNode(std::vector<Edge> edges);
 };
 
 } // namespace sini
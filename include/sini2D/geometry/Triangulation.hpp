@@ -0,0 +1,22 @@
+// Triangulation of simple polygons through ear clipping. Reflex vertices, the
+// only ones that can make a convex corner fail the ear test, are kept in a
+// uniform grid so that each ear test only visits the reflex vertices close to
+// the candidate triangle.
+#pragma once
+
+#include <sini2D/math/Vector.hpp>
+
+#include <vector>
+
+
+namespace sini {
+
+// Triangulate the polygon described by 'vertices', given in either clockwise
+// or counter-clockwise order. Triangles are stored as (sorted) indices into
+// 'vertices', n-2 of them for a polygon with n >= 3 vertices. Fewer than three
+// vertices gives an empty mesh.
+// If the polygon is not simple (i.e. it intersects itself) the result is still
+// n-2 triangles, but they are not guaranteed to cover the polygon exactly.
+std::vector<vec3i> triangulate(const std::vector<vec2>& vertices);
+
+} // namespace sini
@@ -0,0 +1,78 @@
+// Bounded cache of triangulations, keyed by the vertices of the polygon, so
+// that polygons rebuilt from the same vertices (e.g. by a level loader, or
+// every frame) are only triangulated once. The cache is bounded by the total
+// number of vertices of the cached polygons, since each entry keeps a copy of
+// the vertices and about as many triangles. Least recently used
+// triangulations are evicted first. Polygon::buildTriangleMesh() goes through
+// the shared cache.
+#pragma once
+
+#include <sini2D/math/Vector.hpp>
+
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::uint64_t
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace sini {
+
+class TriangulationCache {
+public:
+    struct Stats {
+        uint64_t hits = 0,
+                 misses = 0,
+                 evictions = 0;
+        size_t size = 0,        // Cached triangulations
+               vertices = 0,    // Of the cached triangulations, in total
+               capacity = 0;    // In vertices
+    };
+
+    // Keeps triangulations of at most 'capacity' vertices in total. Polygons
+    // with more vertices than that are never cached, and zero disables
+    // caching.
+    explicit TriangulationCache(size_t capacity);
+    TriangulationCache(const TriangulationCache&) = delete;
+    TriangulationCache& operator= (const TriangulationCache&) = delete;
+
+    // Same result as sini::triangulate(vertices), from the cache if the same
+    // vertices (compared exactly) have been triangulated before. Thread-safe;
+    // triangulating on a miss doesn't block other threads.
+    std::vector<vec3i> triangulate(const std::vector<vec2>& vertices);
+
+    Stats stats() const;
+    void resetStats() noexcept;
+    // Evicts the least recently used triangulations if the capacity shrinks
+    void setCapacity(size_t capacity);
+    void clear() noexcept;
+
+    // Process-wide cache, used by Polygon::buildTriangleMesh(), with room for
+    // 2^20 vertices (about 20 MB of vertices and triangles)
+    static TriangulationCache& shared();
+
+    // Hash of the vertices, combining sini::hash() of each vertex
+    static size_t hash(const std::vector<vec2>& vertices) noexcept;
+
+private:
+    struct Entry {
+        size_t hash;
+        std::vector<vec2> vertices;
+        std::vector<vec3i> triangles;
+    };
+
+    mutable std::mutex mutex;
+    // Most recently used first. Entries with colliding hashes replace each
+    // other.
+    std::list<Entry> entries;
+    std::unordered_map<size_t, std::list<Entry>::iterator> index;
+    size_t capacity,
+           n_vertices = 0;  // Cached
+    Stats counts;
+
+    // Evict until at most 'max_vertices' are cached
+    void evictDownTo(size_t max_vertices) noexcept;
+};
+
+} // namespace sini
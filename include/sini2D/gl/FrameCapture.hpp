@@ -0,0 +1,83 @@
+// Reads back every frame rendered by a SimpleRenderer without stalling it (see
+// SimpleRenderer::setFrameCapture()), e.g. for screenshots or video capture.
+// Each frame is copied into one of a ring of pixel buffer objects, guarded by a
+// fence, and only mapped once the GPU is done with the copy. Frames are handed
+// to the callback in order, typically two or three frames after they were
+// rendered, and the renderer only waits if it gets a full ring ahead of the GPU.
+#pragma once
+
+#include <sini2D/gl/GLStateCache.hpp>
+#include <sini2D/math/Vector.hpp>
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::uint8_t, std::uint64_t
+#include <functional>
+#include <vector>
+
+
+namespace sini {
+
+class SimpleRenderer;
+
+struct CapturedFrame {
+    // Number of frames captured before this one
+    uint64_t index;
+    vec2i dimensions;
+    // 8-bit RGBA with rows from top to bottom (4 * width * height bytes)
+    std::vector<uint8_t> pixels;
+};
+
+class FrameCapture {
+public:
+    // Called on the rendering thread, from SimpleRenderer::updateScreen() or
+    // finish(), so it should pass heavy work on (see FrameWriter)
+    using Callback = std::function<void(CapturedFrame frame)>;
+    // Frames in flight
+    static constexpr size_t n_buffers = 3;
+
+    FrameCapture() = delete;
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator= (const FrameCapture&) = delete;
+    explicit FrameCapture(Callback callback);
+    // The pixel buffers are created when the first frame is captured, and
+    // the GL context of that renderer must still be current when the capture
+    // is destroyed. Frames still in flight are dropped; call finish() first to
+    // get them.
+    ~FrameCapture();
+
+    // Hand all frames still in flight to the callback, waiting for the GPU.
+    // Throws OpenGlException if the wait fails, dropping that frame.
+    void finish();
+
+    uint64_t numCapturedFrames() const noexcept { return n_captured_frames; }
+
+private:
+    friend class SimpleRenderer;
+
+    struct Readback {
+        GLuint buffer = 0;
+        size_t buffer_size = 0;
+        GLsync fence = nullptr; // Set while in flight
+        uint64_t index;
+        vec2i dimensions;
+    };
+
+    Callback callback;
+    std::array<Readback, n_buffers> readbacks;
+    size_t oldest = 0;          // Oldest readback in flight, if any
+    size_t n_in_flight = 0;
+    uint64_t n_captured_frames = 0;
+
+    // Start reading back the color attachment of 'framebuffer', first handing
+    // finished frames to the callback. Returns the number of bytes copied.
+    size_t capture(GLStateCache& gl_state, GLuint framebuffer, vec2i dimensions);
+    // Hand the oldest frame in flight to the callback, if the GPU is done
+    // with it or if 'wait'. Returns whether it was handed over. Throws
+    // OpenGlException, dropping the frame, if waiting for it fails.
+    bool deliverOldest(bool wait);
+};
+
+} // namespace sini
@@ -0,0 +1,68 @@
+// Per-frame statistics of a SimpleRenderer, and a log of them that can be
+// exported for dashboards. With a FrameLog attached (see
+// SimpleRenderer::setFrameLog()) the renderer also measures GPU time with
+// timer queries, which are read back a few frames later, without waiting.
+#pragma once
+
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::uint32_t, std::uint64_t
+#include <ostream>
+#include <vector>
+
+
+namespace sini {
+
+// Work done by a SimpleRenderer during one frame
+struct FrameStats {
+    // Frames finished by updateScreen() before this one
+    uint64_t frame_index = 0;
+    uint32_t draw_calls = 0;
+    // Vertices and elements (vertex indices) drawn, counting the unit mesh
+    // once per instance with instanced shapes
+    uint64_t vertices = 0,
+             elements = 0;
+    // Vertex, element and instance data written to GPU buffers
+    uint64_t bytes_uploaded = 0;
+    // Framebuffer pixels copied, including presenting the frame on the screen
+    uint64_t framebuffer_bytes_copied = 0;
+    // GL calls made by the renderer, not counting those made by stream buffers
+    // (with VertexStreaming::RING_BUFFER) or timer queries
+    uint32_t gl_calls = 0;
+    // Reallocations of the renderer's vertex, element and instance buffers,
+    // and of static meshes drawn during the frame, to make them larger
+    uint32_t buffer_growths = 0;
+    // CPU time spent submitting GL commands (flushing queued primitives,
+    // drawing static meshes, clearing and presenting), and wall-clock time
+    // since the previous frame was finished
+    double cpu_submit_ms = 0.0,
+           cpu_frame_ms = 0.0;
+    // GPU time spent clearing and drawing, and presenting (and capturing) the
+    // frame. Negative if not measured.
+    double gpu_draw_ms = -1.0,
+           gpu_present_ms = -1.0;
+
+    double gpuMs() const noexcept
+    {
+        return gpu_draw_ms < 0.0 ? -1.0 : gpu_draw_ms + gpu_present_ms;
+    }
+};
+
+class FrameLog {
+public:
+    FrameLog() = default;
+
+    void add(const FrameStats& stats) { log.push_back(stats); }
+    void clear() noexcept { log.clear(); }
+    // In order of frame index
+    const std::vector<FrameStats>& frames() const noexcept { return log; }
+
+    // An array with one object per frame, with the member names of
+    // FrameStats (and "gpu_ms"), as used by writeCsv() for the header
+    void writeJson(std::ostream& out) const;
+    void writeCsv(std::ostream& out) const;
+
+private:
+    std::vector<FrameStats> log;
+};
+
+} // namespace sini
@@ -0,0 +1,65 @@
+// Writes captured frames (see FrameCapture) to a file on a background thread,
+// so that the rendering thread only has to queue them. All frames go to the
+// same file, one after another:
+//   RAW_RGBA: just the pixels, e.g. for
+//             ffmpeg -f rawvideo -pix_fmt rgba -video_size <w>x<h> -i <file>
+//   PPM:      a binary (P6) PPM image per frame, without alpha, which netpbm
+//             tools and ffmpeg (-f image2pipe) read as a sequence of images
+#pragma once
+
+#include <sini2D/gl/FrameCapture.hpp>
+
+#include <condition_variable>
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::uint64_t
+#include <deque>
+#include <exception>    // For std::exception_ptr
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+
+namespace sini {
+
+class FrameWriter {
+public:
+    enum class Format { RAW_RGBA, PPM };
+
+    FrameWriter() = delete;
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator= (const FrameWriter&) = delete;
+    // Create or truncate the file at 'path'. Throws std::runtime_error if it
+    // can't be opened.
+    FrameWriter(const std::string& path, Format format, size_t max_queued_frames = 4);
+    // Writes the queued frames before closing the file
+    ~FrameWriter();
+
+    // Queue a frame for writing. Blocks while 'max_queued_frames' are queued,
+    // rather than dropping frames or using up memory if the disk can't keep
+    // up. Throws std::runtime_error if writing an earlier frame failed.
+    void write(CapturedFrame frame);
+    // Wait for all queued frames to be written and flushed to the file
+    void flush();
+
+    uint64_t numWrittenFrames() const noexcept;
+
+private:
+    std::ofstream file;
+    const Format format;
+    const size_t max_queued_frames;
+    std::deque<CapturedFrame> queue;
+    mutable std::mutex mutex;
+    std::condition_variable frame_queued, frame_written;
+    bool writing = false,   // The writer thread holds a frame
+         stopping = false;
+    uint64_t n_written_frames = 0;
+    std::exception_ptr error;
+    std::thread thread;
+
+    void writerLoop();
+    void writeFrame(const CapturedFrame& frame);
+    void rethrowError();
+};
+
+} // namespace sini
@@ -0,0 +1,59 @@
+// Shadow copy of the GL state that is changed between draw calls, so that
+// binds and toggles that wouldn't change anything are skipped. The GL calls
+// that are actually made are counted.
+//
+// All changes of the shadowed state must go through the cache, or be followed
+// by invalidate(). The state is unknown until first set, so nothing is assumed
+// about the context the cache is used with.
+#pragma once
+
+#include <GL/glew.h>
+#include <sini2D/math/Matrix.hpp>
+
+#include <cstdint>      // For std::uint32_t
+
+
+namespace sini {
+
+class ShaderProgram;
+
+class GLStateCache {
+public:
+    GLStateCache() noexcept { invalidate(); }
+
+    void useProgram(GLuint program) noexcept;
+    void bindVertexArray(GLuint vertex_array) noexcept;
+    // GL_ARRAY_BUFFER binding, which (unlike the element array buffer) is not
+    // part of the vertex array state
+    void bindArrayBuffer(GLuint buffer) noexcept;
+    // 'target' is GL_FRAMEBUFFER (both), GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER
+    void bindFramebuffer(GLenum target, GLuint framebuffer) noexcept;
+    void setBlending(bool enabled) noexcept;
+    // See ShaderProgram::setUniform()
+    void setUniform(ShaderProgram& program, GLint location, float value) noexcept;
+    void setUniform(ShaderProgram& program, GLint location, const vec4& value) noexcept;
+    void setUniform(ShaderProgram& program, GLint location, const mat2& value) noexcept;
+    void setUniform(ShaderProgram& program, GLint location, const mat3& value) noexcept;
+
+    // Forget the shadowed state, e.g. after it was changed behind the cache's
+    // back
+    void invalidate() noexcept;
+
+    // For GL calls made beside the cache, to have them included in the count
+    void countCalls(uint32_t n_calls) noexcept { call_count += n_calls; }
+    uint32_t callCount() const noexcept { return call_count; }
+    void resetCallCount() noexcept { call_count = 0; }
+
+private:
+    static constexpr GLuint unknown = ~GLuint(0);
+
+    GLuint program,
+           vertex_array,
+           array_buffer,
+           draw_framebuffer,
+           read_framebuffer;
+    int blending; // -1 if unknown
+    uint32_t call_count = 0;
+};
+
+} // namespace sini
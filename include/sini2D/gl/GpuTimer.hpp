@@ -0,0 +1,75 @@
+// Measures the GPU time of sections of a frame with GL_TIMESTAMP queries. The
+// results of a frame are read back once they're available, typically a few
+// frames later, so that the CPU never waits for the GPU unless it gets a full
+// ring of frames ahead. Used by SimpleRenderer with a FrameLog attached.
+#pragma once
+
+#include <sini2D/gl/FrameStats.hpp>
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>      // For std::size_t
+#include <vector>
+
+
+namespace sini {
+
+class GpuTimer {
+public:
+    enum Section { DRAW, PRESENT };
+    static constexpr int n_sections = PRESENT + 1;
+    // Frames in flight
+    static constexpr size_t n_frames = 4;
+
+    // Times the GL commands issued during its lifetime, if 'timer' is not null
+    class Scope {
+    public:
+        Scope(GpuTimer* timer, Section section) noexcept;
+        Scope(const Scope&) = delete;
+        Scope& operator= (const Scope&) = delete;
+        ~Scope();
+    private:
+        GpuTimer* const timer;
+    };
+
+    // Requires a current GL context, which must also be current when the
+    // timer is destroyed
+    GpuTimer() noexcept = default;
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator= (const GpuTimer&) = delete;
+    ~GpuTimer();
+
+    // Sections must not overlap
+    void begin(Section section) noexcept;
+    void end() noexcept;
+
+    // Finish the current frame, whose GPU times are filled into 'stats' once
+    // available. Adds the frames whose times became available to 'log', in
+    // order.
+    void endFrame(const FrameStats& stats, FrameLog& log);
+    // Add all frames in flight to 'log', waiting for the GPU
+    void finish(FrameLog& log);
+
+private:
+    struct Frame {
+        FrameStats stats;
+        // Pairs of timestamps, and the section of each pair
+        std::vector<GLuint> queries;
+        std::vector<Section> sections;
+        size_t n_used_queries = 0;
+    };
+
+    std::array<Frame, n_frames> frames;
+    size_t oldest = 0;  // Oldest frame in flight, if any
+    size_t n_in_flight = 0;
+    Section open_section = DRAW;
+
+    Frame& currentFrame() noexcept { return frames[(oldest + n_in_flight) % n_frames]; }
+    GLuint nextQuery() noexcept;
+    // Add the oldest frame in flight to 'log', if its results are available
+    // or if 'wait'. Returns whether it was added.
+    bool logOldest(FrameLog& log, bool wait);
+};
+
+} // namespace sini
@@ -0,0 +1,36 @@
+// A class wrapping the creation and deletion of an OpenGL context without a
+// window, using EGL. Meant for rendering offscreen, e.g. for image tests and
+// benchmarks on machines without a display, where Mesa's software rasterizer
+// (llvmpipe) provides the context. Like GLContext, the HeadlessContext object
+// must be alive as long as OpenGL function calls are made.
+//
+// The context has no default framebuffer, so all rendering must be done to
+// framebuffer objects. Only available if sini2D is built with
+// SINI_2D_ENABLE_HEADLESS.
+#pragma once
+
+#include <EGL/egl.h>
+
+
+namespace sini {
+
+class HeadlessContext {
+public:
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext handle = EGL_NO_CONTEXT;
+
+    HeadlessContext() noexcept = delete;
+    HeadlessContext(const HeadlessContext&) noexcept = delete;
+    HeadlessContext& operator= (const HeadlessContext&) noexcept = delete;
+    // Create a core profile context and make it current. Uses Mesa's
+    // surfaceless platform if available, the default EGL display otherwise.
+    HeadlessContext(int gl_major_version, int gl_minor_version);
+
+    ~HeadlessContext();
+
+private:
+    // Only used if the display doesn't support surfaceless contexts
+    EGLSurface surface = EGL_NO_SURFACE;
+};
+
+}
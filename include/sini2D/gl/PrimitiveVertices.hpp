@@ -0,0 +1,120 @@
+// Vertices and elements (vertex indices) of the primitives drawn by
+// SimpleRenderer, written to memory reserved by the caller. Shared by
+// SimpleRenderer, RenderCommandList and StaticMesh.
+#pragma once
+
+#include <sini2D/math/Matrix.hpp>
+#include <sini2D/math/Vector.hpp>
+
+#include <GL/glew.h>
+
+#include <cstddef>      // For std::size_t
+
+
+namespace sini {
+
+struct Polygon;
+
+// Position (x, y) followed by color (r, g, b, alpha)
+using ColorVertex = Vector<float,6>;
+
+// Where to write the vertices and elements of a primitive. An element with
+// value i refers to vertices[i - first_vertex].
+struct VertexCursor {
+    ColorVertex* vertices;
+    GLuint* elements;
+    GLuint first_vertex;
+};
+
+// Unit circle of 64 segments with its triangle mesh, i.e. unitCircle(64). Used
+// for unit shapes and instanced circles, whose size isn't known when their
+// mesh is chosen. Thread-safe.
+const Polygon& unitCircle();
+
+// Unit shapes, placed with an affine transform (see SimpleRenderer::fillShape())
+enum class Shape {
+    SQUARE,     // From (-0.5, -0.5) to (0.5, 0.5)
+    CIRCLE      // Radius 1, centered at the origin
+};
+// 4 for the square, and as many as unitCircle() for the circle
+size_t numShapeVertices(Shape shape) noexcept;
+// Elements of writeFilledShape(); writeShapeOutline() uses 2 per vertex
+size_t numFilledShapeElements(Shape shape) noexcept;
+
+// Segments of a full circle with a radius of 'radius' world units, at
+// 'pixels_per_unit', such that its chords stay within a quarter of a pixel of
+// the circle. Rounded up to a power of two from 8 to 1024, the levels of
+// detail, so that curves of similar size share their tessellation. Gives 64,
+// as unitCircle(), if 'pixels_per_unit' isn't positive (size unknown).
+int curveSegments(float radius, float pixels_per_unit) noexcept;
+// Unit circle with 'n_segments' vertices and its triangle mesh, tessellated
+// once per level of detail. 'n_segments' must come from curveSegments().
+// Thread-safe.
+const Polygon& unitCircle(int n_segments);
+// Segments of an arc sweeping 'sweep' radians (at most a full turn either
+// way) of a circle tessellated with 'n_segments'
+size_t numArcSegments(float sweep, int n_segments) noexcept;
+// Corner radius of a rounded rectangle as drawn, i.e. at most half of the
+// shorter side. The level of detail should be chosen for this radius.
+float roundedCornerRadius(vec2 bottom_left, vec2 upper_right, float corner_radius) noexcept;
+
+// Primitives drawn as lines (two elements per line segment)
+// -----------------------------------------------------------------------------
+// n vertices, 2n elements
+void writePolygonOutline(VertexCursor cursor, const Polygon& polygon, vec3 color,
+                         float alpha) noexcept;
+// n vertices, 6 elements per triangle. Requires the triangle mesh.
+void writePolygonTriangleMesh(VertexCursor cursor, const Polygon& polygon, vec3 color,
+                              float alpha) noexcept;
+// 4 vertices, 8 elements
+void writeRectangleOutline(VertexCursor cursor, vec2 bottom_left, vec2 upper_right,
+                           vec3 color, float alpha) noexcept;
+// Same counts as writePolygonOutline() for unitCircle()
+void writeCircleOutline(VertexCursor cursor, vec2 center, float radius, vec3 color,
+                        float alpha) noexcept;
+// numShapeVertices() vertices, twice as many elements
+void writeShapeOutline(VertexCursor cursor, Shape shape, const mat3& model_to_world,
+                       vec3 color, float alpha) noexcept;
+// Curves tessellated with 'n_segments' from curveSegments()
+// n_segments vertices, 2*n_segments elements
+void writeEllipseOutline(VertexCursor cursor, vec2 center, vec2 radii, int n_segments,
+                         vec3 color, float alpha) noexcept;
+// Open arc from 'start_angle', sweeping 'sweep' radians counterclockwise
+// (clockwise if negative). With m = numArcSegments(): m+1 vertices, 2m
+// elements.
+void writeArc(VertexCursor cursor, vec2 center, float radius, float start_angle,
+              float sweep, int n_segments, vec3 color, float alpha) noexcept;
+// The corner radius is at most half of the shorter side. n_segments+4
+// vertices, twice as many elements.
+void writeRoundedRectangleOutline(VertexCursor cursor, vec2 bottom_left, vec2 upper_right,
+                                  float corner_radius, int n_segments, vec3 color,
+                                  float alpha) noexcept;
+
+// Primitives drawn as triangles (three elements per triangle)
+// -----------------------------------------------------------------------------
+// n vertices, 3 elements per triangle. Requires the triangle mesh.
+void writeFilledPolygon(VertexCursor cursor, const Polygon& polygon, vec3 color,
+                        float alpha) noexcept;
+// 4 vertices, 6 elements
+void writeFilledRectangle(VertexCursor cursor, vec2 bottom_left, vec2 upper_right,
+                          vec3 color, float alpha) noexcept;
+// Same counts as writeFilledPolygon() for unitCircle()
+void writeFilledCircle(VertexCursor cursor, vec2 center, float radius, vec3 color,
+                       float alpha) noexcept;
+// numShapeVertices() vertices, numFilledShapeElements() elements
+void writeFilledShape(VertexCursor cursor, Shape shape, const mat3& model_to_world,
+                      vec3 color, float alpha) noexcept;
+// Curves tessellated with 'n_segments' from curveSegments()
+// n_segments vertices, 3*(n_segments-2) elements
+void writeFilledEllipse(VertexCursor cursor, vec2 center, vec2 radii, int n_segments,
+                        vec3 color, float alpha) noexcept;
+// Circular sector of the arc of writeArc(). With m = numArcSegments(): m+2
+// vertices, 3m elements.
+void writeFilledArc(VertexCursor cursor, vec2 center, float radius, float start_angle,
+                    float sweep, int n_segments, vec3 color, float alpha) noexcept;
+// n_segments+4 vertices, 3*(n_segments+2) elements
+void writeFilledRoundedRectangle(VertexCursor cursor, vec2 bottom_left, vec2 upper_right,
+                                 float corner_radius, int n_segments, vec3 color,
+                                 float alpha) noexcept;
+
+} // namespace sini
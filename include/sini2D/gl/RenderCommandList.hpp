@@ -0,0 +1,107 @@
+// Draw calls recorded into CPU memory, to be submitted to a SimpleRenderer
+// later (see SimpleRenderer::submit()). Recording needs no GL context, so
+// several threads can each fill their own list in parallel, including the
+// triangulation of polygons and the generation of vertices. The GL thread
+// then submits the lists in a fixed order, which makes the result independent
+// of how the threads were scheduled.
+//
+// Filling a polygon without a triangle mesh builds the mesh, i.e. modifies the
+// polygon, so a polygon shared between threads should be triangulated before
+// it is recorded into several lists concurrently.
+#pragma once
+
+#include <sini2D/gl/PrimitiveVertices.hpp>
+#include <sini2D/math/Vector.hpp>
+
+#include <GL/glew.h>
+
+#include <cstddef>      // For std::size_t
+#include <vector>
+
+
+namespace sini {
+
+struct Polygon;
+class SimpleRenderer;
+class SoftwareRenderer;
+
+class RenderCommandList {
+public:
+    RenderCommandList() noexcept = default;
+
+    // Same as the corresponding SimpleRenderer functions. Rectangles, circles
+    // and unit shapes are always recorded as vertices, also if the renderer draws
+    // them instanced.
+    void drawPolygon(Polygon& polygon, vec3 color, float alpha);
+    void drawPolygonTriangleMesh(Polygon& polygon, vec3 color, float alpha);
+    void fillPolygon(Polygon& polygon, vec3 color, float alpha);
+
+    void drawRectangle(vec2 bottom_left, vec2 upper_right, vec3 color, float alpha);
+    void fillRectangle(vec2 bottom_left, vec2 upper_right, vec3 color, float alpha);
+
+    void drawCircle(vec2 center, float radius, vec3 color, float alpha);
+    void fillCircle(vec2 center, float radius, vec3 color, float alpha);
+
+    void drawShape(Shape shape, const mat3& model_to_world, vec3 color, float alpha);
+    void fillShape(Shape shape, const mat3& model_to_world, vec3 color, float alpha);
+
+    // Tessellated for 'pixels_per_unit' (see setPixelsPerUnit())
+    void drawEllipse(vec2 center, vec2 radii, vec3 color, float alpha);
+    void fillEllipse(vec2 center, vec2 radii, vec3 color, float alpha);
+    void drawArc(vec2 center, float radius, float start_angle, float sweep, vec3 color,
+                 float alpha);
+    void fillArc(vec2 center, float radius, float start_angle, float sweep, vec3 color,
+                 float alpha);
+    void drawRoundedRectangle(vec2 bottom_left, vec2 upper_right, float corner_radius,
+                              vec3 color, float alpha);
+    void fillRoundedRectangle(vec2 bottom_left, vec2 upper_right, float corner_radius,
+                              vec3 color, float alpha);
+
+    // Level of detail of curves recorded from now on, usually the
+    // pixelsPerUnit() of the renderer the list is submitted to. Zero, the
+    // default, tessellates all curves like unitCircle().
+    void setPixelsPerUnit(float value) noexcept { pixels_per_unit = value; }
+
+    // See SimpleRenderer::reserveTriangles(). The cursor is valid until the
+    // next call to any other member function.
+    VertexCursor reserveTriangles(size_t n_vertices, size_t n_elements);
+    VertexCursor reserveLines(size_t n_vertices, size_t n_elements);
+
+    // Remove all recorded draw calls, but keep the memory for reuse
+    void clear() noexcept;
+
+    bool empty() const noexcept { return batches.empty(); }
+    size_t numVertices() const noexcept { return n_vertices; }
+    size_t numElements() const noexcept { return n_elements; }
+    // Consecutive draw calls of the same kind (lines or triangles) are
+    // recorded as one batch
+    size_t numBatches() const noexcept { return batches.size(); }
+
+private:
+    friend class SimpleRenderer;
+    friend class SoftwareRenderer;
+
+    struct Batch {
+        bool triangles; // Or lines
+        bool translucent;
+        size_t first_vertex,
+               n_vertices,
+               first_element,
+               n_elements;
+    };
+
+    // Only resized to grow, like SimpleRenderer's queue, so that vertices
+    // aren't zeroed before being written
+    std::vector<ColorVertex> vertices;
+    // Relative to the first vertex of the batch
+    std::vector<GLuint> elements;
+    std::vector<Batch> batches;
+    size_t n_vertices = 0,
+           n_elements = 0;
+    float pixels_per_unit = 0.0f;
+
+    VertexCursor reserve(bool triangles, size_t n_new_vertices, size_t n_new_elements,
+                         bool translucent);
+};
+
+} // namespace sini
@@ -0,0 +1,56 @@
+// Linked shader program that resolves the locations of its active uniforms
+// once, when it is loaded, and remembers the values last uploaded to them so
+// that uploads that wouldn't change anything can be skipped
+#pragma once
+
+#include <GL/glew.h>
+#include <sini2D/math/Matrix.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+
+namespace sini {
+
+class ShaderProgram {
+public:
+    ShaderProgram() = delete;
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator= (const ShaderProgram&) = delete;
+    // Compile and link using loadShaderProgram(). The geometry shader is
+    // optional (nullptr). Throws OpenGlException, with the compile log if
+    // there is one, on failure.
+    ShaderProgram(const char* vertex_shader_src, const char* geometry_shader_src,
+                  const char* fragment_shader_src);
+    ~ShaderProgram();
+
+    GLuint handle() const noexcept { return program; }
+
+    // Location of an active uniform, or -1 if there is none with that name
+    GLint uniformLocation(const char* name) const noexcept;
+
+    // Upload a uniform value unless the uniform already has it. The program
+    // doesn't need to be in use. Returns whether a GL call was made.
+    bool setUniform(GLint location, float value) noexcept;
+    bool setUniform(GLint location, const vec4& value) noexcept;
+    bool setUniform(GLint location, const mat2& value) noexcept;
+    bool setUniform(GLint location, const mat3& value) noexcept;
+
+private:
+    struct Uniform {
+        std::string name;
+        GLint location;
+        std::array<float,16> value;
+        bool uploaded = false;
+    };
+
+    GLuint program;
+    std::vector<Uniform> uniforms;
+
+    // Remember 'value' for the uniform at 'location'. Returns false if the
+    // uniform already has the value, or doesn't exist.
+    bool updateCachedValue(GLint location, const float* value, size_t size) noexcept;
+};
+
+} // namespace sini
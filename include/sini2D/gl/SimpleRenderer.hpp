@@ -1,11 +1,26 @@
 #pragma once
 
 #include <sini2D/gl/Camera.hpp>
+#include <sini2D/gl/FrameCapture.hpp>
+#include <sini2D/gl/FrameStats.hpp>
 #include <sini2D/gl/GLContext.hpp>
+#include <sini2D/gl/GLStateCache.hpp>
+#include <sini2D/gl/GpuTimer.hpp>
+#ifdef SINI_HEADLESS
+#include <sini2D/gl/HeadlessContext.hpp>
+#endif
+#include <sini2D/gl/PrimitiveVertices.hpp>
+#include <sini2D/gl/RenderCommandList.hpp>
+#include <sini2D/gl/ShaderProgram.hpp>
+#include <sini2D/gl/StaticMesh.hpp>
+#include <sini2D/gl/StreamBuffer.hpp>
 #include <sini2D/math/Vector.hpp>
 
 #include <GL/glew.h>
 
+#include <chrono>
+#include <cstdint>      // For std::uint8_t
+#include <memory>
 #include <vector>
 
 
@@ -16,18 +31,68 @@ class GLContext;
 struct Polygon;
 
 
+// How vertex data of drawn primitives gets to the GPU.
+// BUFFER_SUB_DATA: primitives are queued in std::vectors, which are copied
+//     with glBufferSubData to the start of a single buffer. This makes the
+//     driver wait for (or copy around) the previous draw call.
+// RING_BUFFER: primitives are written straight into a ring of persistently
+//     mapped buffer segments guarded by fences, or orphaned buffers if
+//     GL_ARB_buffer_storage is not supported (see StreamBuffer).
+enum class VertexStreaming {
+    BUFFER_SUB_DATA,
+    RING_BUFFER
+};
+
+struct RenderSettings {
+    VertexStreaming vertex_streaming = VertexStreaming::BUFFER_SUB_DATA;
+    // Draw rectangles and circles as instances of a static unit rectangle or
+    // circle mesh, so that each shape only costs a small per-instance record.
+    // Consecutive shapes of the same kind are drawn with one draw call.
+    // Instanced circles all share the 64-segment unitCircle(), whatever their
+    // size on screen, so that circles of any size batch together.
+    bool instanced_shapes = false;
+};
+
+enum class LineJoin { MITER, ROUND };
+enum class LineCap { BUTT, SQUARE, ROUND };
+
+// Thick lines, see SimpleRenderer::drawPolyline()
+struct LineStyle {
+    float width;    // In world units
+    LineJoin join = LineJoin::MITER;
+    LineCap cap = LineCap::BUTT;
+    // Miters reaching further than this many half widths from the joined
+    // point are beveled
+    float miter_limit = 4.0f;
+};
+
+
 class SimpleRenderer {
 public:
+    // Vertex layout: position (x, y) followed by color (r, g, b, alpha)
+    using Vertex = ColorVertex;
+    // Where to write the vertices and elements (vertex indices) of reserved
+    // primitives
+    using VertexCursor = sini::VertexCursor;
+
     Camera camera;
 
     SimpleRenderer(const Window& window);
     SimpleRenderer(const Window& window, Camera camera);
+    SimpleRenderer(const Window& window, Camera camera, RenderSettings settings);
+#ifdef SINI_HEADLESS
+    // Render offscreen, without a window, to a framebuffer of the given
+    // dimensions (see HeadlessContext). updateScreen() then only finishes the
+    // frame, which can be read back with readPixels().
+    SimpleRenderer(vec2i dimensions, Camera camera,
+                   RenderSettings settings = RenderSettings());
+#endif
     SimpleRenderer() noexcept = delete;
     ~SimpleRenderer();
 
     void clear(vec4 clear_color = vec4(0.0f, 0.0f, 0.0f, 1.0f)) noexcept;
 
-    void drawPolygon(Polygon& polygon, vec3 color, float alpha) noexcept;
+    void drawPolygon(Polygon& polygon, vec3 color, float alpha);
     void drawPolygonTriangleMesh(Polygon& polygon, vec3 color, float alpha);
     void fillPolygon(Polygon& polygon, vec3 color, float alpha);
 
@@ -37,43 +102,284 @@ public:
     void drawCircle(vec2 position, float radius, vec3 color, float alpha);
     void fillCircle(vec2 position, float radius, vec3 color, float alpha);
 
+    // Unit shape placed by an affine 'model_to_world' matrix, so that the
+    // shape may also be rotated or sheared. Drawn as one instance of the
+    // shared unit mesh when instanced shapes are enabled.
+    void drawShape(Shape shape, const mat3& model_to_world, vec3 color, float alpha);
+    void fillShape(Shape shape, const mat3& model_to_world, vec3 color, float alpha);
+
+    // Curves tessellated for their size on screen (see curveSegments()),
+    // also when instanced shapes are enabled. An ellipse with equal radii is
+    // a circle with adaptive detail. Arcs go from 'start_angle', sweeping
+    // 'sweep' radians counterclockwise (clockwise if negative), and are
+    // filled as circular sectors.
+    void drawEllipse(vec2 center, vec2 radii, vec3 color, float alpha);
+    void fillEllipse(vec2 center, vec2 radii, vec3 color, float alpha);
+    void drawArc(vec2 center, float radius, float start_angle, float sweep, vec3 color,
+                 float alpha);
+    void fillArc(vec2 center, float radius, float start_angle, float sweep, vec3 color,
+                 float alpha);
+    void drawRoundedRectangle(vec2 bottom_left, vec2 upper_right, float corner_radius,
+                              vec3 color, float alpha);
+    void fillRoundedRectangle(vec2 bottom_left, vec2 upper_right, float corner_radius,
+                              vec3 color, float alpha);
+
+    // Thick, antialiased line through 'n_points' points, also joining the
+    // last point to the first if 'closed'. The line segments are instances of
+    // a quad expanded by the vertex shader, so the points are the only data
+    // uploaded and the whole polyline is drawn with one draw call. Repeated
+    // consecutive points are skipped. Translucent lines with round joins are
+    // more opaque where the segments overlap.
+    void drawPolyline(const vec2* points, size_t n_points, const LineStyle& line_style,
+                      vec3 color, float alpha, bool closed = false);
+    void drawPolyline(const std::vector<vec2>& points, const LineStyle& line_style,
+                      vec3 color, float alpha, bool closed = false);
+    // Closed thick outline
+    void drawPolygon(const Polygon& polygon, const LineStyle& line_style, vec3 color,
+                     float alpha);
+
+    // Shapes evaluated per pixel from their signed distance field, with
+    // antialiased edges, each drawn as one instanced quad without any
+    // tessellation. Outlines are 'line_width' world units wide, inside the
+    // edge of the shape, so drawSdfCircle() draws a ring. A capsule is the
+    // line segment from 'a' to 'b' with 'radius' around it.
+    void fillSdfCircle(vec2 center, float radius, vec3 color, float alpha);
+    void drawSdfCircle(vec2 center, float radius, float line_width, vec3 color,
+                       float alpha);
+    void fillSdfCapsule(vec2 a, vec2 b, float radius, vec3 color, float alpha);
+    void drawSdfCapsule(vec2 a, vec2 b, float radius, float line_width, vec3 color,
+                        float alpha);
+    void fillSdfRoundedBox(vec2 bottom_left, vec2 upper_right, float corner_radius,
+                           vec3 color, float alpha);
+    void drawSdfRoundedBox(vec2 bottom_left, vec2 upper_right, float corner_radius,
+                           float line_width, vec3 color, float alpha);
+
+    // Queue the draw calls recorded in a command list, as if they were made
+    // now. A vector of lists is submitted in index order.
+    void submit(const RenderCommandList& list);
+    void submit(const std::vector<RenderCommandList>& lists);
+
+    // Draw all polygons of a static mesh with one draw call, transformed by
+    // an affine 'model_to_world' matrix. Uploads the parts of the mesh that
+    // changed since it was last drawn.
+    void drawStaticMesh(StaticMesh& mesh, const mat3& model_to_world = mat3::identity());
+
+    // Reserve room for triangles (three elements each) or lines (two elements
+    // each), written directly by the caller through the returned cursor. With
+    // VertexStreaming::RING_BUFFER the cursor points into mapped GPU memory,
+    // which should only be written to. The cursor is valid until the next call
+    // to any other member function.
+    VertexCursor reserveTriangles(size_t n_vertices, size_t n_elements);
+    VertexCursor reserveLines(size_t n_vertices, size_t n_elements);
+
     // Update the screen to make drawings visible. Actual rendering is not
     // guaranteed until updateScreen is called.
-    void updateScreen() noexcept;
+    void updateScreen();
+
+    // Read back what has been drawn so far, as 8-bit RGB with rows from top
+    // to bottom (3 * width * height bytes). Renders the queued primitives
+    // first, and waits for the GPU to finish.
+    void readPixels(uint8_t* rgb_out);
+    std::vector<uint8_t> readPixels();
+    // Read back every frame finished by updateScreen() from now on, without
+    // waiting for the GPU, until called with nullptr. The capture must outlive
+    // its use here.
+    void setFrameCapture(FrameCapture* capture) noexcept { frame_capture = capture; }
+    // Of the window, or the offscreen framebuffer
+    vec2i dimensions() const noexcept { return framebuffer_dimensions; }
+    // Framebuffer pixels per world unit, with the current camera
+    float pixelsPerUnit() const noexcept
+    {
+        return framebuffer_dimensions.x / camera.width;
+    }
+
+    // Stats of the latest frame finished by updateScreen(), without GPU times
+    const FrameStats& frameStats() const noexcept { return last_frame_stats; }
+    // Add the stats of every frame from now on to 'log', including GPU times
+    // measured with timer queries. The frames are added in order once their
+    // GPU times are available, typically a few frames late. Stops with
+    // nullptr, which first adds the frames still in flight to the previous log,
+    // waiting for the GPU; they're dropped if the renderer is destroyed
+    // first. The log must outlive its use here.
+    void setFrameLog(FrameLog* log);
+
+    // The renderer leaves its shader programs, vertex arrays etc. bound
+    // between calls and skips binding them again. Call this after changing
+    // the bindings (or the blending state) outside of the renderer.
+    void invalidateGlState() noexcept { gl_state.invalidate(); }
 
 private:
-    enum RenderStyle { DRAW, FILL };
+    // The instanced shape styles are only used with instanced_shapes
+    enum RenderStyle {
+        DRAW, FILL,
+        RECTANGLE_OUTLINES, FILLED_RECTANGLES, CIRCLE_OUTLINES, FILLED_CIRCLES,
+        SDF_SHAPES
+    };
+    static constexpr int n_render_styles = SDF_SHAPES + 1;
+    // Per-instance data of instanced shapes, i.e. the affine transform of the
+    // unit mesh: position = offset + x*axis_x + y*axis_y
+    struct ShapeInstance {
+        vec2 offset;
+        vec2 axis_x,
+             axis_y;
+        uint8_t color[4]; // RGBA, normalized
+    };
+    // Per-instance data of SDF shapes, which are all rounded boxes in a frame
+    // with 'axis' as its x axis
+    struct SdfShape {
+        vec2 center;
+        vec2 axis;          // Unit length
+        vec2 half_extents;
+        float corner_radius,
+              line_width;   // Zero if filled
+        uint8_t color[4];   // RGBA, normalized
+    };
+    // Location of a unit shape in shape_vertex_buffer and shape_element_buffer
+    struct ShapeMesh {
+        GLsizei n_vertices,
+                n_elements;
+        size_t element_offset;  // In bytes
+        GLint base_vertex;
+    };
 
+    // nullptr when rendering offscreen
     const Window* const window;
-    const GLContext context;
-    Polygon* circle_polygon = nullptr;
-    std::vector<Vector<float,5>> queued_vertex_data;
+    const vec2i framebuffer_dimensions;
+    // Only one of the contexts is created
+    const std::unique_ptr<GLContext> context;
+#ifdef SINI_HEADLESS
+    const std::unique_ptr<HeadlessContext> headless_context;
+#endif
+    const RenderSettings settings;
+    // Queued primitives with VertexStreaming::BUFFER_SUB_DATA. The vectors
+    // are only resized to grow, so that the vertices aren't zeroed before
+    // being written every time.
+    std::vector<Vertex> queued_vertex_data;
     std::vector<GLuint> queued_elements;
-    GLuint shader_program,
-           screen_shader,
-           framebuffer,
+    size_t n_queued_vertices = 0,
+           n_queued_elements = 0;
+    // Drawings are rendered to 'framebuffer' and copied to the screen once
+    // per frame, by updateScreen()
+    GLStateCache gl_state;
+    std::unique_ptr<ShaderProgram> shader_program;
+    GLint model_to_world_loc,
+          world_to_cam_loc;
+    // World to camera matrix, computed for the camera with these parameters
+    struct CameraMatrix {
+        vec2 position;
+        float width,
+              orientation;
+        mat3 matrix;
+        bool valid = false;
+    } camera_matrix;
+    GLuint framebuffer,
            framebuffer_texture,
-           backbuffer,
-           backbuffer_texture,
-           quad_vertex_array,
-           quad_vertex_buffer,
            vertex_array,
-           vertex_buffer,
-           element_buffer;
+           vertex_buffer = 0,
+           element_buffer = 0;
     size_t vertex_buffer_size = 8*1024*1024,  // (initial) size in bytes
            element_buffer_size = 8*1024*1024; // (initial) size in bytes
+    // Replace vertex_buffer and element_buffer with VertexStreaming::RING_BUFFER
+    std::unique_ptr<StreamBuffer> vertex_stream,
+                                  element_stream;
+    // Primitives written to mapped stream buffer memory, but not yet drawn
+    struct MappedBatch {
+        Vertex* vertices = nullptr;
+        GLuint* elements = nullptr;
+        size_t vertex_capacity = 0,
+               element_capacity = 0,
+               n_vertices = 0,
+               n_elements = 0;
+    } mapped_batch;
     RenderStyle render_style = FILL; // arbitrary choice of initial value
+    // Whether blending is needed for the queued primitives
+    bool translucent_primitives_queued = false;
+    FrameStats frame_stats,
+               last_frame_stats;
+    FrameCapture* frame_capture = nullptr;
+    uint64_t n_finished_frames = 0;
+    std::chrono::steady_clock::time_point frame_start_time;
+    // Only with a frame log
+    FrameLog* frame_log = nullptr;
+    std::unique_ptr<GpuTimer> gpu_timer;
+
+    // Instanced shapes
+    std::unique_ptr<ShaderProgram> instance_shader;
+    GLint instance_world_to_cam_loc = -1;
+    GLuint shape_vertex_array = 0,
+           shape_vertex_buffer = 0,
+           shape_element_buffer = 0,
+           instance_buffer = 0;
+    size_t instance_buffer_size = 8*1024*1024; // (initial) size in bytes
+    ShapeMesh shape_meshes[n_render_styles] = {};
+    // Queued instances, or (with VertexStreaming::RING_BUFFER) written to
+    // mapped memory. instance_buffer is replaced by instance_stream in the
+    // latter case.
+    std::vector<ShapeInstance> queued_instances;
+    std::unique_ptr<StreamBuffer> instance_stream;
+    struct MappedInstances {
+        ShapeInstance* instances = nullptr;
+        size_t capacity = 0,
+               n_instances = 0;
+    } mapped_instances;
+
+    // SDF shapes, set up when first drawn. The quads' corners are generated
+    // by the vertex shader, so there is only an instance buffer. Queued or
+    // written to mapped memory like the instanced shapes.
+    std::unique_ptr<ShaderProgram> sdf_shader;
+    GLint sdf_world_to_cam_loc = -1,
+          sdf_pixel_size_loc = -1;
+    GLuint sdf_vertex_array = 0,
+           sdf_instance_buffer = 0;
+    size_t sdf_instance_buffer_size = 1024*1024; // (initial) size in bytes
+    std::vector<SdfShape> queued_sdf_shapes;
+    std::unique_ptr<StreamBuffer> sdf_stream;
+    struct MappedSdfShapes {
+        SdfShape* shapes = nullptr;
+        size_t capacity = 0,
+               n_shapes = 0;
+    } mapped_sdf_shapes;
+
+    // Thick polylines, set up when first drawn. Each segment reads the point
+    // before it, its end points and the point after it from polyline_points.
+    std::unique_ptr<ShaderProgram> polyline_shader;
+    GLint polyline_world_to_cam_loc = -1,
+          polyline_pixel_size_loc = -1,
+          polyline_style_loc = -1,
+          polyline_color_loc = -1,
+          polyline_last_segment_loc = -1;
+    GLuint polyline_vertex_array = 0;
+    std::unique_ptr<StreamBuffer> polyline_points;
+
+    SimpleRenderer(const Window* window, vec2i dimensions, Camera camera,
+                   RenderSettings settings);
 
-    void flushRenderQueue(RenderStyle style, float alpha = 1.0f) noexcept;
-    void setUniforms(float alpha) noexcept;
+    void flushRenderQueue(RenderStyle style) noexcept;
+    // Room for primitives in the queue (or mapped batch), flushing first if
+    // the render style changes or the mapped batch is full
+    VertexCursor reserve(RenderStyle style, size_t n_vertices, size_t n_elements,
+                         bool translucent);
+    void mapBatch(size_t min_vertices, size_t min_elements);
+    void queueShapeInstance(RenderStyle style, vec2 offset, vec2 axis_x, vec2 axis_y,
+                            vec3 color, float alpha);
+    void flushShapeInstances(RenderStyle style) noexcept;
+    void queueSdfShape(vec2 center, vec2 axis, vec2 half_extents, float corner_radius,
+                       float line_width, vec3 color, float alpha);
+    void flushSdfShapes() noexcept;
+    void setupSdfShapes();
+    void bindSdfInstanceBuffer(GLuint buffer) noexcept;
+    void setupPolylines();
+    void bindPolylineBuffer() noexcept;
+    void setupShapeMeshes();
+    void bindInstanceBuffer(GLuint buffer) noexcept;
+    const mat3& worldToCameraMatrix() noexcept;
     void setupInternalFramebuffer();
-    void setupInternalVertexObjects() noexcept;
-    void setupQuadVertexArray() noexcept;
-    Polygon setupCircle(vec2 offset, float radius);
+    void setupInternalVertexObjects();
+    void bindStreamBuffers() noexcept;
     void growInternalVertexBuffer(size_t minimum_capacity) noexcept;
     void growInternalElementBuffer(size_t minimum_capacity) noexcept;
-    // Render 'framebuffer' to another frame buffer, target = 0 being the screen
-    void renderFramebuffer(GLuint target_framebuffer = 0) noexcept;
+    // Copy 'framebuffer' to the screen
+    void presentFramebuffer() noexcept;
 };
 
 } // namespace sini
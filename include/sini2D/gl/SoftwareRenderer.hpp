@@ -0,0 +1,109 @@
+// Renders the same primitives as SimpleRenderer on the CPU, for machines
+// without a usable GL implementation. Needs no GL context or window.
+//
+// Primitives are triangulated like SimpleRenderer does (lines become one pixel
+// wide quads), snapped to 1/16 pixel and rasterized with integer edge
+// functions and the top-left fill rule. Each triangle is binned to the 8x8
+// pixel tiles it overlaps, and rows of tiles are rasterized in parallel, each
+// tile drawing its triangles in submission order. All arithmetic after the
+// snapping is exact, so images are the same byte for byte regardless of the
+// number of threads, and with or without SIMD. They do differ slightly from
+// SimpleRenderer's, e.g. colors are constant per primitive (taken from its
+// first vertex) and lines are not drawn with GL's diamond rule.
+#pragma once
+
+#include <sini2D/gl/Camera.hpp>
+#include <sini2D/gl/RenderCommandList.hpp>
+#include <sini2D/math/Vector.hpp>
+
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::int64_t, std::uint8_t, std::uint32_t
+#include <vector>
+
+
+namespace sini {
+
+class ThreadPool;
+struct Polygon;
+
+class SoftwareRenderer {
+public:
+    static constexpr int tile_size = 8;
+
+    Camera camera;
+
+    // Uses ThreadPool::shared() unless given a pool
+    SoftwareRenderer(vec2i dimensions, Camera camera);
+    SoftwareRenderer(vec2i dimensions, Camera camera, ThreadPool& thread_pool);
+    SoftwareRenderer() = delete;
+
+    // Same as the corresponding SimpleRenderer functions
+    void clear(vec4 clear_color = vec4(0.0f, 0.0f, 0.0f, 1.0f));
+
+    void drawPolygon(Polygon& polygon, vec3 color, float alpha);
+    void drawPolygonTriangleMesh(Polygon& polygon, vec3 color, float alpha);
+    void fillPolygon(Polygon& polygon, vec3 color, float alpha);
+
+    void drawRectangle(vec2 bottom_left, vec2 upper_right, vec3 color, float alpha);
+    void fillRectangle(vec2 bottom_left, vec2 upper_right, vec3 color, float alpha);
+
+    void drawCircle(vec2 center, float radius, vec3 color, float alpha);
+    void fillCircle(vec2 center, float radius, vec3 color, float alpha);
+
+    void drawShape(Shape shape, const mat3& model_to_world, vec3 color, float alpha);
+    void fillShape(Shape shape, const mat3& model_to_world, vec3 color, float alpha);
+
+    void drawEllipse(vec2 center, vec2 radii, vec3 color, float alpha);
+    void fillEllipse(vec2 center, vec2 radii, vec3 color, float alpha);
+    void drawArc(vec2 center, float radius, float start_angle, float sweep, vec3 color,
+                 float alpha);
+    void fillArc(vec2 center, float radius, float start_angle, float sweep, vec3 color,
+                 float alpha);
+    void drawRoundedRectangle(vec2 bottom_left, vec2 upper_right, float corner_radius,
+                              vec3 color, float alpha);
+    void fillRoundedRectangle(vec2 bottom_left, vec2 upper_right, float corner_radius,
+                              vec3 color, float alpha);
+
+    void submit(const RenderCommandList& list);
+    void submit(const std::vector<RenderCommandList>& lists);
+
+    // Rasterize the queued primitives
+    void updateScreen();
+
+    // Same format as SimpleRenderer::readPixels(). Rasterizes the queued
+    // primitives first.
+    void readPixels(uint8_t* rgb_out);
+    std::vector<uint8_t> readPixels();
+    vec2i dimensions() const noexcept { return framebuffer_dimensions; }
+    float pixelsPerUnit() const noexcept { return framebuffer_dimensions.x / camera.width; }
+
+private:
+    // Pixel (x, y), at the pixel center, is covered if a*x + b*y + c >= 0 for
+    // all three edges. The fill rule is folded into c.
+    struct Triangle {
+        int64_t a[3],
+                b[3],
+                c[3];
+        vec2i min_pixel,    // Bounding box on the screen, inclusive
+              max_pixel;
+        uint32_t color;     // RGBA, 8 bits each, red in the lowest byte
+    };
+
+    const vec2i framebuffer_dimensions;
+    const vec2i n_tiles;
+    ThreadPool& thread_pool;
+    // RGBA like Triangle::color, rows from top to bottom. Alpha is unused.
+    std::vector<uint32_t> pixels;
+    RenderCommandList queue;
+    std::vector<Triangle> triangles;
+    // Indices of the triangles overlapping each tile, in submission order
+    std::vector<std::vector<uint32_t>> tile_bins;
+
+    void setupTriangles(const RenderCommandList& list);
+    void addTriangle(vec2 p0, vec2 p1, vec2 p2, uint32_t color);
+    void addLine(vec2 p0, vec2 p1, uint32_t color);
+    void rasterizeQueue();
+    void rasterizeTile(int tile_x, int tile_y) noexcept;
+};
+
+} // namespace sini
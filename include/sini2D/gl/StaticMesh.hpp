@@ -0,0 +1,80 @@
+// Filled polygons kept in GPU buffers, for geometry that rarely changes. The
+// polygons are uploaded once and drawn with a single draw call per frame (see
+// SimpleRenderer::drawStaticMesh()), instead of being queued vertex by vertex
+// every frame. Changing a polygon only re-uploads the changed range.
+#pragma once
+
+#include <sini2D/gl/GLStateCache.hpp>
+#include <sini2D/gl/PrimitiveVertices.hpp>
+#include <sini2D/math/Vector.hpp>
+
+#include <GL/glew.h>
+
+#include <cstddef>      // For std::size_t
+#include <vector>
+
+
+namespace sini {
+
+struct Polygon;
+class SimpleRenderer;
+
+class StaticMesh {
+public:
+    using Vertex = ColorVertex;
+
+    StaticMesh() noexcept = default;
+    StaticMesh(const StaticMesh&) = delete;
+    StaticMesh& operator= (const StaticMesh&) = delete;
+    // The GPU buffers are created when the mesh is first drawn, and the GL
+    // context of that renderer must still be current when the mesh is
+    // destroyed.
+    ~StaticMesh();
+
+    // Add a polygon, triangulating it if needed. Returns its index.
+    size_t addPolygon(Polygon& polygon, vec3 color, float alpha);
+    // Replace polygon 'index'. If the vertex and triangle counts are the same
+    // as before, only the polygon's own range is uploaded again, otherwise
+    // also the ranges of all polygons after it.
+    void updatePolygon(size_t index, Polygon& polygon, vec3 color, float alpha);
+    void clear() noexcept;
+
+    size_t numPolygons() const noexcept { return ranges.size(); }
+
+private:
+    friend class SimpleRenderer;
+
+    // Where a polygon is stored in 'vertices' and 'elements'
+    struct Range {
+        size_t first_vertex,
+               n_vertices,
+               first_element,
+               n_elements;
+        bool translucent;
+    };
+
+    std::vector<Vertex> vertices;
+    std::vector<GLuint> elements;
+    std::vector<Range> ranges;
+    size_t n_translucent_polygons = 0;
+    // Ranges changed since the last upload, empty if begin >= end
+    size_t dirty_vertices_begin = 0,
+           dirty_vertices_end = 0,
+           dirty_elements_begin = 0,
+           dirty_elements_end = 0;
+    GLuint vertex_array = 0,
+           vertex_buffer = 0,
+           element_buffer = 0;
+    size_t vertex_capacity = 0,   // In vertices
+           element_capacity = 0;  // In elements
+
+    void writePolygon(const Range& range, const Polygon& polygon, vec3 color,
+                      float alpha) noexcept;
+    void markDirty(size_t vertices_begin, size_t vertices_end,
+                   size_t elements_begin, size_t elements_end) noexcept;
+    // Create the buffers if needed and upload the dirty ranges, or everything
+    // if the buffers had to grow. Returns the number of bytes uploaded.
+    size_t upload(GLStateCache& gl_state);
+};
+
+} // namespace sini
@@ -0,0 +1,76 @@
+// A GL buffer object for streaming data that is rewritten every frame, e.g.
+// vertices. The buffer is split into a ring of segments, and data is written
+// straight into mapped buffer memory instead of being copied by
+// glBufferSubData, which would make the driver wait for earlier draws reading
+// the same memory.
+//
+// With GL_ARB_buffer_storage, the whole buffer is mapped persistently once and
+// each segment is guarded by a fence, created by fence() after the draw calls
+// reading it, so that the CPU only waits if it gets a full ring ahead of the
+// GPU. Otherwise the buffer is orphaned when the ring
+// wraps around, i.e. the driver hands out fresh memory while draws still read
+// the old.
+#pragma once
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>      // For std::size_t
+
+
+namespace sini {
+
+class StreamBuffer {
+public:
+    enum class Mode { PERSISTENT_MAPPING, ORPHANING };
+    static constexpr size_t n_segments = 3;
+
+    StreamBuffer() = delete;
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator= (const StreamBuffer&) = delete;
+    // Requires a current GL context. Uses persistent mapping if supported.
+    explicit StreamBuffer(size_t segment_size);
+    StreamBuffer(size_t segment_size, Mode mode);
+    ~StreamBuffer();
+
+    GLuint handle() const noexcept { return buffer; }
+    Mode mode() const noexcept { return mapping_mode; }
+    size_t segmentSize() const noexcept { return segment_size; }
+
+    // Reserve 'size' bytes for writing and return a pointer to them. The
+    // returned memory starts at a multiple of 'alignment' bytes from the start
+    // of the buffer (see offset()) and is valid until commit() is called. It
+    // should only be written to, since it may be uncached GPU memory.
+    // If 'size' doesn't fit in a segment, the buffer is reallocated and its
+    // handle changes.
+    void* map(size_t size, size_t alignment = 4);
+    // Make the first 'used_size' bytes written since map() available to draw
+    // calls. The rest of the mapped range is reused by the next map().
+    void commit(size_t used_size) noexcept;
+    // Offset in bytes of the latest mapped range, for use in draw calls
+    size_t offset() const noexcept { return mapped_offset; }
+    // Fence the data committed since the last call, which must be after the
+    // draw calls reading it and before the ring wraps around to it again.
+    // map() waits for the newest fence of each segment it enters.
+    void fence() noexcept;
+
+private:
+    GLuint buffer = 0;
+    Mode mapping_mode;
+    size_t segment_size;
+    size_t head = 0; // Next free byte
+    size_t mapped_offset = 0;
+    // Persistent mapping only
+    char* persistent_ptr = nullptr;
+    size_t segment_of_last_write = 0;
+    std::array<GLsync, n_segments> segment_fences{};
+    // Segments with committed data that hasn't been fenced yet
+    std::array<bool, n_segments> unfenced_segments{};
+
+    void allocate();
+    void release() noexcept;
+    void fenceSegment(size_t segment) noexcept;
+    void waitForSegment(size_t segment) noexcept;
+};
+
+} // namespace sini
@@ -364,12 +364,18 @@ SINI_CUDA_COMPAT Matrix<T,4,4> adj(const Matrix<T,4,4>& mat) noexcept;
 template<typename T, uint32_t M, uint32_t N>
 SINI_CUDA_COMPAT Matrix<T,M,N> abs(const Matrix<T,M,N>& mat) noexcept;
 
-// Inverse of 2x2 and 3x3 matrices
+// Inverse of 2x2, 3x3 and 4x4 matrices
 // More general inverse and pseudo-inverse in "sini/math/MatrixMath.h"
 template<typename T>
 SINI_CUDA_COMPAT Matrix<T,2,2> inverse(const Matrix<T,2,2>& mat) noexcept;
 template<typename T>
 SINI_CUDA_COMPAT Matrix<T,3,3> inverse(const Matrix<T,3,3>& mat) noexcept;
+template<typename T>
+SINI_CUDA_COMPAT Matrix<T,4,4> inverse(const Matrix<T,4,4>& mat) noexcept;
+#ifdef SINI_SIMD_SSE
+// SIMD version, see sini2D/math/Simd.hpp
+inline Matrix<float,4,4> inverse(const Matrix<float,4,4>& mat) noexcept;
+#endif
 
 // Max and min element
 template<typename T, uint32_t M, uint32_t N>
@@ -407,6 +413,10 @@ SINI_CUDA_COMPAT Matrix<T,M,N> operator- (const Matrix<T,M,N>& mat) noexcept;
 // Multiplication for general matrices
 template<typename T, uint32_t M, uint32_t N, uint32_t O>
 SINI_CUDA_COMPAT Matrix<T,M,O> operator* (const Matrix<T,M,N>& left, const Matrix<T,N,O>& right) noexcept;
+#ifdef SINI_SIMD
+// SIMD version, see sini2D/math/Simd.hpp
+inline Matrix<float,4,4> operator* (const Matrix<float,4,4>& left, const Matrix<float,4,4>& right) noexcept;
+#endif
 // Multiplication for square matrices
 template<typename T, uint32_t N>
 SINI_CUDA_COMPAT Matrix<T,N,N> operator*= (Matrix<T,N,N>& left, const Matrix<T,N,N>& right) noexcept;
@@ -414,6 +424,11 @@ SINI_CUDA_COMPAT Matrix<T,N,N> operator*= (Matrix<T,N,N>& left, const Matrix<T,N
 // Multiplication with vector (matrix*vector)
 template<typename T, uint32_t M, uint32_t N>
 SINI_CUDA_COMPAT Vector<T,M> operator* (const Matrix<T,M,N>& mat, const Vector<T,N>& vec) noexcept;
+#ifdef SINI_SIMD
+// SIMD versions, see sini2D/math/Simd.hpp
+inline Vector<float,3> operator* (const Matrix<float,3,3>& mat, const Vector<float,3>& vec) noexcept;
+inline Vector<float,4> operator* (const Matrix<float,4,4>& mat, const Vector<float,4>& vec) noexcept;
+#endif
 // vector*matrix multiplication must be done by converting the vector
 // to a row vector, i.e. a 1xN matrix. The reason for this design is
 // to only allow vector*matrix multiplication when you really want it
@@ -861,7 +861,7 @@ SINI_CUDA_COMPAT Matrix<T,3,3> inverse(const Matrix<T,3,3>& mat) noexcept
     if (det_ == T(0)) return Matrix<T, 3, 3>(T(0));
 
     // Compute the adjugate matrix
-    T minor00 = mat.e11*mat.e22 - mat.e21*mat.e21;
+    T minor00 = mat.e11*mat.e22 - mat.e21*mat.e12;
     T minor01 = mat.e10*mat.e22 - mat.e20*mat.e12;
     T minor02 = mat.e10*mat.e21 - mat.e20*mat.e11;
     T minor10 = mat.e01*mat.e22 - mat.e21*mat.e02;
@@ -894,6 +894,93 @@ SINI_CUDA_COMPAT Matrix<T,4,4> inverse(const Matrix<T,4,4>& mat) noexcept
     }
     return adj /= det_;
 }
+#ifdef SINI_SIMD_SSE
+// Block-wise inversion, treating the matrix as four 2x2 matrices
+//     | A B |
+//     | C D |
+// each stored row-major in one register. Uses that A#, the adjugate of a 2x2
+// matrix, is cheap to form, and that |M| = |A||D| + |B||C| - tr((A#B)(D#C)).
+namespace simd {
+namespace detail {
+
+template<int x, int y, int z, int w>
+inline __m128 swizzle(__m128 v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x)); }
+// (a[x], a[y], b[z], b[w])
+template<int x, int y, int z, int w>
+inline __m128 shuffle(__m128 a, __m128 b) noexcept { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x)); }
+
+// 2x2 matrix products A*B, A#*B and A*B#
+inline __m128 mat2Mul(__m128 a, __m128 b) noexcept
+{
+    return _mm_add_ps(_mm_mul_ps(a, swizzle<0,3,0,3>(b)),
+                      _mm_mul_ps(swizzle<1,0,3,2>(a), swizzle<2,1,2,1>(b)));
+}
+inline __m128 mat2AdjMul(__m128 a, __m128 b) noexcept
+{
+    return _mm_sub_ps(_mm_mul_ps(swizzle<3,3,0,0>(a), b),
+                      _mm_mul_ps(swizzle<1,1,2,2>(a), swizzle<2,3,0,1>(b)));
+}
+inline __m128 mat2MulAdj(__m128 a, __m128 b) noexcept
+{
+    return _mm_sub_ps(_mm_mul_ps(a, swizzle<3,0,3,0>(b)),
+                      _mm_mul_ps(swizzle<1,0,3,2>(a), swizzle<2,1,2,1>(b)));
+}
+
+} // namespace detail
+} // namespace simd
+
+inline Matrix<float,4,4> inverse(const Matrix<float,4,4>& mat) noexcept
+{
+    using namespace simd::detail;
+    const __m128 row0 = simd::load(mat.row_vectors[0].data()),
+                 row1 = simd::load(mat.row_vectors[1].data()),
+                 row2 = simd::load(mat.row_vectors[2].data()),
+                 row3 = simd::load(mat.row_vectors[3].data());
+    const __m128 A = _mm_movelh_ps(row0, row1),
+                 B = _mm_movehl_ps(row1, row0),
+                 C = _mm_movelh_ps(row2, row3),
+                 D = _mm_movehl_ps(row3, row2);
+
+    // (|A|, |B|, |C|, |D|)
+    const __m128 sub_dets = _mm_sub_ps(
+        _mm_mul_ps(shuffle<0,2,0,2>(row0, row2), shuffle<1,3,1,3>(row1, row3)),
+        _mm_mul_ps(shuffle<1,3,1,3>(row0, row2), shuffle<0,2,0,2>(row1, row3)));
+    const __m128 det_A = simd::splatLane<0>(sub_dets),
+                 det_B = simd::splatLane<1>(sub_dets),
+                 det_C = simd::splatLane<2>(sub_dets),
+                 det_D = simd::splatLane<3>(sub_dets);
+
+    const __m128 D_adj_C = mat2AdjMul(D, C),
+                 A_adj_B = mat2AdjMul(A, B);
+    // The inverse is 1/|M| * | X# Y# |, with
+    //                        | Z# W# |
+    // X = |D|A - B(D#C), Y = |B|C - D(A#B)#, Z = |C|B - A(D#C)#, W = |A|D - C(A#B)
+    __m128 X = _mm_sub_ps(_mm_mul_ps(det_D, A), mat2Mul(B, D_adj_C)),
+           Y = _mm_sub_ps(_mm_mul_ps(det_B, C), mat2MulAdj(D, A_adj_B)),
+           Z = _mm_sub_ps(_mm_mul_ps(det_C, B), mat2MulAdj(A, D_adj_C)),
+           W = _mm_sub_ps(_mm_mul_ps(det_A, D), mat2Mul(C, A_adj_B));
+
+    const float trace = simd::sumLanes(_mm_mul_ps(A_adj_B, swizzle<0,2,1,3>(D_adj_C)));
+    const float det_ = _mm_cvtss_f32(det_A)*_mm_cvtss_f32(det_D)
+                     + _mm_cvtss_f32(det_B)*_mm_cvtss_f32(det_C) - trace;
+    if (det_ == 0.0f) return Matrix<float, 4, 4>(0.0f);
+
+    // The signs make the adjugates of X, Y, Z and W when combined with the
+    // shuffles below
+    const __m128 inv_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), _mm_set1_ps(det_));
+    X = _mm_mul_ps(X, inv_det);
+    Y = _mm_mul_ps(Y, inv_det);
+    Z = _mm_mul_ps(Z, inv_det);
+    W = _mm_mul_ps(W, inv_det);
+
+    Matrix<float, 4, 4> inv;
+    simd::store(inv.row_vectors[0].data(), shuffle<3,1,3,1>(X, Y));
+    simd::store(inv.row_vectors[1].data(), shuffle<2,0,2,0>(X, Y));
+    simd::store(inv.row_vectors[2].data(), shuffle<3,1,3,1>(Z, W));
+    simd::store(inv.row_vectors[3].data(), shuffle<2,0,2,0>(Z, W));
+    return inv;
+}
+#endif
 
 // Max and min element
 template<typename T, uint32_t M, uint32_t N>
@@ -979,12 +1066,51 @@ SINI_CUDA_COMPAT Matrix<T,M,N> operator- (const Matrix<T,M,N>& mat) noexcept
 template<typename T, uint32_t M, uint32_t N, uint32_t O>
 SINI_CUDA_COMPAT Matrix<T,M,O> operator* (const Matrix<T,M,N>& left, const Matrix<T,N,O>& right) noexcept
 {
+    // Each row of the result is a linear combination of the rows of 'right',
+    // which avoids copying out the columns of 'right'
     Matrix<T, M, O> mat;
-    for (uint32_t i = 0; i < M; i++)
-        for (uint32_t j = 0; j < O; j++)
-            mat.at(i, j) = dot(left.row_vectors[i], right.column(j));
+    for (uint32_t i = 0; i < M; i++) {
+        mat.row_vectors[i] = left(i, 0) * right.row_vectors[0];
+        for (uint32_t k = 1; k < N; k++)
+            mat.row_vectors[i] += left(i, k) * right.row_vectors[k];
+    }
     return mat;
 }
+#ifdef SINI_SIMD
+inline Matrix<float,4,4> operator* (const Matrix<float,4,4>& left, const Matrix<float,4,4>& right) noexcept
+{
+    Matrix<float, 4, 4> mat;
+#if defined(SINI_SIMD_SSE) && defined(__AVX__)
+    // Two rows of the result at a time
+    const __m256 right0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right.row_vectors[0].data())),
+                 right1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right.row_vectors[1].data())),
+                 right2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right.row_vectors[2].data())),
+                 right3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right.row_vectors[3].data()));
+    for (uint32_t i = 0; i < 4; i += 2) {
+        const __m256 rows = _mm256_loadu_ps(left.row_vectors[i].data());
+        __m256 result = _mm256_mul_ps(_mm256_permute_ps(rows, 0x00), right0);
+        result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_permute_ps(rows, 0x55), right1));
+        result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_permute_ps(rows, 0xAA), right2));
+        result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_permute_ps(rows, 0xFF), right3));
+        _mm256_storeu_ps(mat.row_vectors[i].data(), result);
+    }
+#else
+    const simd::f32x4 right0 = simd::load(right.row_vectors[0].data()),
+                      right1 = simd::load(right.row_vectors[1].data()),
+                      right2 = simd::load(right.row_vectors[2].data()),
+                      right3 = simd::load(right.row_vectors[3].data());
+    for (uint32_t i = 0; i < 4; i++) {
+        const simd::f32x4 row = simd::load(left.row_vectors[i].data());
+        simd::f32x4 result = simd::mul(simd::splatLane<0>(row), right0);
+        result = simd::mulAdd(simd::splatLane<1>(row), right1, result);
+        result = simd::mulAdd(simd::splatLane<2>(row), right2, result);
+        result = simd::mulAdd(simd::splatLane<3>(row), right3, result);
+        simd::store(mat.row_vectors[i].data(), result);
+    }
+#endif
+    return mat;
+}
+#endif
 // Multiplication for square matrices
 template<typename T, uint32_t N>
 SINI_CUDA_COMPAT Matrix<T,N,N> operator*= (Matrix<T,N,N>& left, const Matrix<T,N,N>& right) noexcept
@@ -997,10 +1123,42 @@ template<typename T, uint32_t M, uint32_t N>
 SINI_CUDA_COMPAT Vector<T,M> operator* (const Matrix<T,M,N>& mat, const Vector<T,N>& vec) noexcept
 {
     Vector<T, M> result;
-    for (uint32_t i = 0; i < M; i++)
-        result[i] = dot(mat.row_vectors[i], vec);
+    for (uint32_t i = 0; i < M; i++) {
+        result[i] = mat(i, 0) * vec[0];
+        for (uint32_t j = 1; j < N; j++)
+            result[i] += mat(i, j) * vec[j];
+    }
+    return result;
+}
+#ifdef SINI_SIMD
+inline Vector<float,3> operator* (const Matrix<float,3,3>& mat, const Vector<float,3>& vec) noexcept
+{
+    // The rows are loaded as 4 floats each without reading past the matrix,
+    // the extra lane is cancelled out by the zero in the vector
+    const float* data = mat.data();
+    const simd::f32x4 vec_ = simd::set(vec.x, vec.y, vec.z, 0.0f);
+    simd::f32x4 row0 = simd::mul(simd::load(data), vec_),
+                row1 = simd::mul(simd::load(data + 3), vec_),
+                row2 = simd::mul(simd::rotateLanes(simd::load(data + 5)), vec_),
+                row3 = simd::splat(0.0f);
+    simd::transpose(row0, row1, row2, row3);
+    float result[4];
+    simd::store(result, simd::add(simd::add(row0, row1), simd::add(row2, row3)));
+    return Vector<float, 3>(result[0], result[1], result[2]);
+}
+inline Vector<float,4> operator* (const Matrix<float,4,4>& mat, const Vector<float,4>& vec) noexcept
+{
+    const simd::f32x4 vec_ = simd::load(vec.data());
+    simd::f32x4 row0 = simd::mul(simd::load(mat.row_vectors[0].data()), vec_),
+                row1 = simd::mul(simd::load(mat.row_vectors[1].data()), vec_),
+                row2 = simd::mul(simd::load(mat.row_vectors[2].data()), vec_),
+                row3 = simd::mul(simd::load(mat.row_vectors[3].data()), vec_);
+    simd::transpose(row0, row1, row2, row3);
+    Vector<float, 4> result;
+    simd::store(result.data(), simd::add(simd::add(row0, row1), simd::add(row2, row3)));
     return result;
 }
+#endif
 // vector*matrix multiplication must be done by converting the vector
 // to a row vector, i.e. a 1xN matrix. The reason for this design is
 // to only allow vector*matrix multiplication when you really want it
@@ -0,0 +1,105 @@
+// Thin wrappers around 4-wide float SIMD registers, used by the opt-in SIMD
+// versions of some float vector and matrix operations.
+//
+// SIMD is enabled by defining SINI_USE_SIMD (e.g. through the CMake variable
+// SINI_2D_ENABLE_SIMD). SSE is used on x86-64, with FMA if available, and NEON
+// on ARM. Nothing here is used when compiling with nvcc, so that the
+// SINI_CUDA_COMPAT functions stay callable from both host and device.
+#pragma once
+
+#if defined(SINI_USE_SIMD) && !defined(__CUDACC__)
+#if defined(__SSE2__) || defined(_M_X64)
+#define SINI_SIMD_SSE
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define SINI_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(SINI_SIMD_SSE) || defined(SINI_SIMD_NEON)
+#define SINI_SIMD
+
+
+namespace sini {
+namespace simd {
+
+#if defined(SINI_SIMD_SSE)
+using f32x4 = __m128;
+
+inline f32x4 load(const float* ptr) noexcept { return _mm_loadu_ps(ptr); }
+inline void store(float* ptr, f32x4 v) noexcept { _mm_storeu_ps(ptr, v); }
+inline f32x4 set(float x, float y, float z, float w) noexcept { return _mm_setr_ps(x, y, z, w); }
+inline f32x4 splat(float s) noexcept { return _mm_set1_ps(s); }
+template<int lane>
+inline f32x4 splatLane(f32x4 v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(lane, lane, lane, lane)); }
+
+inline f32x4 add(f32x4 a, f32x4 b) noexcept { return _mm_add_ps(a, b); }
+inline f32x4 sub(f32x4 a, f32x4 b) noexcept { return _mm_sub_ps(a, b); }
+inline f32x4 mul(f32x4 a, f32x4 b) noexcept { return _mm_mul_ps(a, b); }
+// a*b + c
+inline f32x4 mulAdd(f32x4 a, f32x4 b, f32x4 c) noexcept
+{
+#if defined(__FMA__) || defined(__AVX2__)
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+inline float sumLanes(f32x4 v) noexcept
+{
+    f32x4 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    f32x4 sums = _mm_add_ps(v, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+}
+// (x, y, z, w) -> (y, z, w, x)
+inline f32x4 rotateLanes(f32x4 v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 3, 2, 1)); }
+inline void transpose(f32x4& r0, f32x4& r1, f32x4& r2, f32x4& r3) noexcept
+{
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+}
+
+#elif defined(SINI_SIMD_NEON)
+using f32x4 = float32x4_t;
+
+inline f32x4 load(const float* ptr) noexcept { return vld1q_f32(ptr); }
+inline void store(float* ptr, f32x4 v) noexcept { vst1q_f32(ptr, v); }
+inline f32x4 set(float x, float y, float z, float w) noexcept
+{
+    const float values[4] = { x, y, z, w };
+    return vld1q_f32(values);
+}
+inline f32x4 splat(float s) noexcept { return vdupq_n_f32(s); }
+template<int lane>
+inline f32x4 splatLane(f32x4 v) noexcept { return vdupq_n_f32(vgetq_lane_f32(v, lane)); }
+
+inline f32x4 add(f32x4 a, f32x4 b) noexcept { return vaddq_f32(a, b); }
+inline f32x4 sub(f32x4 a, f32x4 b) noexcept { return vsubq_f32(a, b); }
+inline f32x4 mul(f32x4 a, f32x4 b) noexcept { return vmulq_f32(a, b); }
+// a*b + c
+inline f32x4 mulAdd(f32x4 a, f32x4 b, f32x4 c) noexcept { return vmlaq_f32(c, a, b); }
+
+inline float sumLanes(f32x4 v) noexcept
+{
+    const float32x2_t sums = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(sums, sums), 0);
+}
+// (x, y, z, w) -> (y, z, w, x)
+inline f32x4 rotateLanes(f32x4 v) noexcept { return vextq_f32(v, v, 1); }
+inline void transpose(f32x4& r0, f32x4& r1, f32x4& r2, f32x4& r3) noexcept
+{
+    const float32x4x2_t t01 = vtrnq_f32(r0, r1),
+                        t23 = vtrnq_f32(r2, r3);
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+#endif
+
+} // namespace simd
+} // namespace sini
+
+#endif // SINI_SIMD
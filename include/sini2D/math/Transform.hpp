@@ -0,0 +1,26 @@
+// Bulk transformation of 2D points on the CPU, e.g. with the same transform as
+// used for rendering (see Camera::worldToCameraViewMatrix()) for culling or
+// picking
+#pragma once
+
+#include <sini2D/math/Matrix.hpp>
+
+
+namespace sini {
+
+class ThreadPool;
+
+// Affine transformation of 2D points with a 3x3 matrix, i.e. out[i] is the x
+// and y of transf * vec3(in[i], 1). 'in' and 'out' may be the same array, but
+// must not otherwise overlap.
+void transformPoints(const mat3& transf, const vec2* in, vec2* out, size_t n) noexcept;
+void transformPoints(const mat3& transf, vec2* points, size_t n) noexcept;
+
+// Same as above, but split into chunks that are transformed in parallel on
+// 'thread_pool'. Small arrays are transformed on the calling thread.
+void transformPoints(const mat3& transf, const vec2* in, vec2* out, size_t n,
+                     ThreadPool& thread_pool);
+void transformPoints(const mat3& transf, vec2* points, size_t n,
+                     ThreadPool& thread_pool);
+
+} // namespace sini
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <sini2D/CudaCompat.hpp>
+#include <sini2D/math/Simd.hpp>
 
 #include <assert.h>
 #include <cmath>        // For std::abs, std::sqrt, std::pow
@@ -200,6 +201,10 @@ std::ostream& operator<< (std::ostream& ostream, const Vector<T,n>& vec);
 // Dot/scalar product
 template<typename T, uint32_t n>
 SINI_CUDA_COMPAT T dot(const Vector<T,n>& v1, const Vector<T,n>& v2) noexcept;
+#ifdef SINI_SIMD
+// SIMD version, see sini2D/math/Simd.hpp
+inline float dot(const Vector<float,4>& v1, const Vector<float,4>& v2) noexcept;
+#endif
 
 // Cross product
 template<typename T>
@@ -250,6 +255,10 @@ template<uint32_t n>
 SINI_CUDA_COMPAT Vector<float,n> normalize(const Vector<int32_t,n>& v);
 template<typename T, uint32_t n>
 SINI_CUDA_COMPAT Vector<T,n> normalize(const Vector<T,n>& v);
+#ifdef SINI_SIMD
+// SIMD version, see sini2D/math/Simd.hpp
+inline Vector<float,4> normalize(const Vector<float,4>& v);
+#endif
 
 // Dimension
 template<typename T, uint32_t n>
@@ -239,6 +239,12 @@ SINI_CUDA_COMPAT T dot(const Vector<T,n>& v1, const Vector<T,n>& v2) noexcept
         sum += v1.components[i] * v2.components[i];
     return sum;
 }
+#ifdef SINI_SIMD
+inline float dot(const Vector<float,4>& v1, const Vector<float,4>& v2) noexcept
+{
+    return simd::sumLanes(simd::mul(simd::load(v1.data()), simd::load(v2.data())));
+}
+#endif
 
 // Cross product
 template<typename T>
@@ -399,6 +405,18 @@ SINI_CUDA_COMPAT Vector<T,n> normalize(const Vector<T,n>& v)
     Vector<T, n> temp = v;
     return temp /= norm_2;
 }
+#ifdef SINI_SIMD
+inline Vector<float,4> normalize(const Vector<float,4>& v)
+{
+    const simd::f32x4 v_ = simd::load(v.data());
+    const float norm_2 = std::sqrt(simd::sumLanes(simd::mul(v_, v_)));
+    assert(norm_2 > 0);
+
+    Vector<float, 4> normalized;
+    simd::store(normalized.data(), simd::mul(v_, simd::splat(1.0f / norm_2)));
+    return normalized;
+}
+#endif
 
 // Max and min element
 template<typename T, uint32_t n>
@@ -0,0 +1,107 @@
+// SiNi structure-of-arrays containers for float vectors
+//
+// A VectorArray<n> stores n-dimensional float vectors as one contiguous,
+// 32 byte aligned array per component ("lane"), i.e. x0 x1 x2 ... and
+// y0 y1 y2 ... rather than x0 y0 x1 y1 ... as in std::vector<vec2>. The bulk
+// operations below are written as simple loops over the lanes, which the
+// compiler vectorizes so that several vectors are processed per instruction.
+#pragma once
+
+#include <sini2D/math/Matrix.hpp>
+#include <sini2D/util/AlignedAllocator.hpp>
+
+#include <algorithm>    // For std::min
+#include <vector>
+
+
+namespace sini {
+
+template<uint32_t n>
+class VectorArray {
+public:
+    using Lane = std::vector<float, AlignedAllocator<float, 32>>;
+
+    VectorArray() noexcept = default;
+    VectorArray(const VectorArray<n>&) = default;
+    VectorArray(VectorArray<n>&&) noexcept = default;
+    VectorArray<n>& operator= (const VectorArray<n>&) = default;
+    VectorArray<n>& operator= (VectorArray<n>&&) noexcept = default;
+    ~VectorArray() noexcept = default;
+
+    // 'size' zero vectors
+    explicit VectorArray(size_t size);
+    // Copies (and de-interleaves) array-of-structures data
+    explicit VectorArray(const std::vector<Vector<float,n>>& vectors);
+    VectorArray(const Vector<float,n>* vectors, size_t count);
+
+    size_t size() const noexcept { return lanes[0].size(); }
+    bool empty() const noexcept { return lanes[0].empty(); }
+    void resize(size_t size);
+    void reserve(size_t capacity);
+    void clear() noexcept;
+    void push_back(const Vector<float,n>& vec);
+
+    // Component lanes, e.g. lane(0) (or x()) for all x components
+    float* lane(uint32_t component) noexcept { return lanes[component].data(); }
+    const float* lane(uint32_t component) const noexcept { return lanes[component].data(); }
+    float* x() noexcept { return lane(0); }
+    const float* x() const noexcept { return lane(0); }
+    float* y() noexcept { return lane(1); }
+    const float* y() const noexcept { return lane(1); }
+    float* z() noexcept;
+    const float* z() const noexcept;
+
+    // Gathers/scatters a single vector
+    Vector<float,n> operator[] (size_t i) const noexcept;
+    void set(size_t i, const Vector<float,n>& vec) noexcept;
+
+    // Conversion back to array-of-structures form
+    std::vector<Vector<float,n>> toVector() const;
+    void copyTo(Vector<float,n>* out) const noexcept;
+    void assign(const Vector<float,n>* vectors, size_t count);
+
+private:
+    Lane lanes[n];
+};
+// Pre-defined vector arrays
+using Vec2Array = VectorArray<2>;
+using Vec3Array = VectorArray<3>;
+
+
+// Bulk operations
+// -----------------------------------------------------------------------------
+// Operations on two arrays require them to have the same size. Functions
+// writing to an output pointer require room for size() floats.
+
+// Element-wise addition and subtraction
+template<uint32_t n>
+VectorArray<n>& operator+= (VectorArray<n>& left, const VectorArray<n>& right) noexcept;
+template<uint32_t n>
+VectorArray<n>& operator-= (VectorArray<n>& left, const VectorArray<n>& right) noexcept;
+// Addition of the same vector to all vectors
+template<uint32_t n>
+VectorArray<n>& operator+= (VectorArray<n>& arr, const Vector<float,n>& offset) noexcept;
+// Scaling
+template<uint32_t n>
+VectorArray<n>& operator*= (VectorArray<n>& arr, float scale) noexcept;
+
+// In-place matrix multiplication of all vectors, e.g. rotation
+inline void eqTransform(Vec2Array& arr, const mat2& mat) noexcept;
+inline void eqTransform(Vec3Array& arr, const mat3& mat) noexcept;
+// In-place affine transformation of 2D points, i.e. with an implicit third
+// coordinate equal to 1 (translation in the third column of 'affine')
+inline void eqTransform(Vec2Array& arr, const mat3& affine) noexcept;
+
+// In-place normalization, all vectors must be non-zero
+template<uint32_t n>
+void eqNormalize(VectorArray<n>& arr) noexcept;
+// Lengths of all vectors
+template<uint32_t n>
+void length(const VectorArray<n>& arr, float* out) noexcept;
+// Dot products of corresponding vectors
+template<uint32_t n>
+void dot(const VectorArray<n>& a, const VectorArray<n>& b, float* out) noexcept;
+
+} // namespace sini
+
+#include "VectorArray.inl"
@@ -0,0 +1,288 @@
+// SiNi structure-of-arrays container definitions
+namespace sini {
+
+// CONSTRUCTORS
+// =============================================================================
+template<uint32_t n>
+VectorArray<n>::VectorArray(size_t size)
+{
+    resize(size);
+}
+
+template<uint32_t n>
+VectorArray<n>::VectorArray(const std::vector<Vector<float,n>>& vectors)
+{
+    assign(vectors.data(), vectors.size());
+}
+
+template<uint32_t n>
+VectorArray<n>::VectorArray(const Vector<float,n>* vectors, size_t count)
+{
+    assign(vectors, count);
+}
+
+
+// MEMBER FUNCTIONS
+// =============================================================================
+template<uint32_t n>
+void VectorArray<n>::resize(size_t size)
+{
+    for (Lane& lane_ : lanes)
+        lane_.resize(size, 0.0f);
+}
+
+template<uint32_t n>
+void VectorArray<n>::reserve(size_t capacity)
+{
+    for (Lane& lane_ : lanes)
+        lane_.reserve(capacity);
+}
+
+template<uint32_t n>
+void VectorArray<n>::clear() noexcept
+{
+    for (Lane& lane_ : lanes)
+        lane_.clear();
+}
+
+template<uint32_t n>
+void VectorArray<n>::push_back(const Vector<float,n>& vec)
+{
+    for (uint32_t c = 0; c < n; c++)
+        lanes[c].push_back(vec[c]);
+}
+
+template<uint32_t n>
+float* VectorArray<n>::z() noexcept
+{
+    static_assert(n >= 3, "No z component in fewer than three dimensions");
+    return lane(2);
+}
+template<uint32_t n>
+const float* VectorArray<n>::z() const noexcept
+{
+    static_assert(n >= 3, "No z component in fewer than three dimensions");
+    return lane(2);
+}
+
+template<uint32_t n>
+Vector<float,n> VectorArray<n>::operator[] (size_t i) const noexcept
+{
+    assert(i < size());
+    Vector<float, n> vec;
+    for (uint32_t c = 0; c < n; c++)
+        vec[c] = lanes[c][i];
+    return vec;
+}
+
+template<uint32_t n>
+void VectorArray<n>::set(size_t i, const Vector<float,n>& vec) noexcept
+{
+    assert(i < size());
+    for (uint32_t c = 0; c < n; c++)
+        lanes[c][i] = vec[c];
+}
+
+template<uint32_t n>
+std::vector<Vector<float,n>> VectorArray<n>::toVector() const
+{
+    std::vector<Vector<float, n>> vectors(size());
+    copyTo(vectors.data());
+    return vectors;
+}
+
+template<uint32_t n>
+void VectorArray<n>::copyTo(Vector<float,n>* out) const noexcept
+{
+    for (uint32_t c = 0; c < n; c++) {
+        const float* lane_ = lanes[c].data();
+        for (size_t i = 0; i < size(); i++)
+            out[i][c] = lane_[i];
+    }
+}
+
+template<uint32_t n>
+void VectorArray<n>::assign(const Vector<float,n>* vectors, size_t count)
+{
+    for (uint32_t c = 0; c < n; c++) {
+        lanes[c].resize(count);
+        float* lane_ = lanes[c].data();
+        for (size_t i = 0; i < count; i++)
+            lane_[i] = vectors[i][c];
+    }
+}
+
+
+// BULK OPERATIONS
+// =============================================================================
+// The lanes are accessed through __restrict pointers, so that the compiler
+// doesn't have to assume that writing to one lane changes another. Lanes of
+// different arrays never overlap, so only an array combined with itself has to
+// be handled separately.
+template<uint32_t n>
+VectorArray<n>& operator+= (VectorArray<n>& left, const VectorArray<n>& right) noexcept
+{
+    assert(left.size() == right.size());
+    if (&left == &right)
+        return left *= 2.0f;
+    for (uint32_t c = 0; c < n; c++) {
+        float* __restrict l = left.lane(c);
+        const float* __restrict r = right.lane(c);
+        for (size_t i = 0; i < left.size(); i++)
+            l[i] += r[i];
+    }
+    return left;
+}
+template<uint32_t n>
+VectorArray<n>& operator-= (VectorArray<n>& left, const VectorArray<n>& right) noexcept
+{
+    assert(left.size() == right.size());
+    if (&left == &right)
+        return left *= 0.0f;
+    for (uint32_t c = 0; c < n; c++) {
+        float* __restrict l = left.lane(c);
+        const float* __restrict r = right.lane(c);
+        for (size_t i = 0; i < left.size(); i++)
+            l[i] -= r[i];
+    }
+    return left;
+}
+template<uint32_t n>
+VectorArray<n>& operator+= (VectorArray<n>& arr, const Vector<float,n>& offset) noexcept
+{
+    for (uint32_t c = 0; c < n; c++) {
+        float* __restrict lane = arr.lane(c);
+        const float offset_c = offset[c];
+        for (size_t i = 0; i < arr.size(); i++)
+            lane[i] += offset_c;
+    }
+    return arr;
+}
+template<uint32_t n>
+VectorArray<n>& operator*= (VectorArray<n>& arr, float scale) noexcept
+{
+    for (uint32_t c = 0; c < n; c++) {
+        float* __restrict lane = arr.lane(c);
+        for (size_t i = 0; i < arr.size(); i++)
+            lane[i] *= scale;
+    }
+    return arr;
+}
+
+inline void eqTransform(Vec2Array& arr, const mat2& mat) noexcept
+{
+    float* __restrict x = arr.x();
+    float* __restrict y = arr.y();
+    const float a = mat.a, b = mat.b,
+                c = mat.c, d = mat.d;
+    for (size_t i = 0; i < arr.size(); i++) {
+        const float x_i = x[i], y_i = y[i];
+        x[i] = a*x_i + b*y_i;
+        y[i] = c*x_i + d*y_i;
+    }
+}
+inline void eqTransform(Vec3Array& arr, const mat3& mat) noexcept
+{
+    float* __restrict x = arr.x();
+    float* __restrict y = arr.y();
+    float* __restrict z = arr.z();
+    const mat3 m = mat;
+    for (size_t i = 0; i < arr.size(); i++) {
+        const float x_i = x[i], y_i = y[i], z_i = z[i];
+        x[i] = m.a*x_i + m.b*y_i + m.c*z_i;
+        y[i] = m.d*x_i + m.e*y_i + m.f*z_i;
+        z[i] = m.g*x_i + m.h*y_i + m.i*z_i;
+    }
+}
+inline void eqTransform(Vec2Array& arr, const mat3& affine) noexcept
+{
+    float* __restrict x = arr.x();
+    float* __restrict y = arr.y();
+    const float a = affine.a, b = affine.b, tx = affine.c,
+                d = affine.d, e = affine.e, ty = affine.f;
+    for (size_t i = 0; i < arr.size(); i++) {
+        const float x_i = x[i], y_i = y[i];
+        x[i] = a*x_i + b*y_i + tx;
+        y[i] = d*x_i + e*y_i + ty;
+    }
+}
+
+namespace detail {
+
+// out[i] = sum of squared components of vector i
+template<uint32_t n>
+void squaredLengths(const VectorArray<n>& arr, size_t begin, size_t count,
+                    float* __restrict out) noexcept
+{
+    const float* __restrict lane = arr.lane(0) + begin;
+    for (size_t i = 0; i < count; i++)
+        out[i] = lane[i] * lane[i];
+    for (uint32_t c = 1; c < n; c++) {
+        lane = arr.lane(c) + begin;
+        for (size_t i = 0; i < count; i++)
+            out[i] += lane[i] * lane[i];
+    }
+}
+
+// std::sqrt is not vectorized by compilers that keep errno semantics, hence
+// the explicit version
+inline void sqrtInPlace(float* values, size_t count) noexcept
+{
+    size_t i = 0;
+#ifdef SINI_SIMD_SSE
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(values + i, _mm_sqrt_ps(_mm_loadu_ps(values + i)));
+#endif
+    for (; i < count; i++)
+        values[i] = std::sqrt(values[i]);
+}
+
+} // namespace detail
+
+template<uint32_t n>
+void eqNormalize(VectorArray<n>& arr) noexcept
+{
+    // Processed in chunks to keep the lengths in a small stack buffer
+    constexpr size_t chunk_size = 256;
+    alignas(32) float inv_lengths[chunk_size];
+    for (size_t begin = 0; begin < arr.size(); begin += chunk_size) {
+        const size_t count = std::min(chunk_size, arr.size() - begin);
+        detail::squaredLengths(arr, begin, count, inv_lengths);
+        detail::sqrtInPlace(inv_lengths, count);
+        for (size_t i = 0; i < count; i++) {
+            assert(inv_lengths[i] > 0.0f);
+            inv_lengths[i] = 1.0f / inv_lengths[i];
+        }
+        for (uint32_t c = 0; c < n; c++) {
+            float* __restrict lane = arr.lane(c) + begin;
+            for (size_t i = 0; i < count; i++)
+                lane[i] *= inv_lengths[i];
+        }
+    }
+}
+
+template<uint32_t n>
+void length(const VectorArray<n>& arr, float* out) noexcept
+{
+    detail::squaredLengths(arr, 0, arr.size(), out);
+    detail::sqrtInPlace(out, arr.size());
+}
+
+template<uint32_t n>
+void dot(const VectorArray<n>& a, const VectorArray<n>& b, float* out) noexcept
+{
+    assert(a.size() == b.size());
+    float* __restrict out_ = out;
+    const float* __restrict a_x = a.lane(0);
+    const float* __restrict b_x = b.lane(0);
+    for (size_t i = 0; i < a.size(); i++)
+        out_[i] = a_x[i] * b_x[i];
+    for (uint32_t c = 1; c < n; c++) {
+        const float* __restrict a_lane = a.lane(c);
+        const float* __restrict b_lane = b.lane(c);
+        for (size_t i = 0; i < a.size(); i++)
+            out_[i] += a_lane[i] * b_lane[i];
+    }
+}
+
+} // namespace sini
@@ -0,0 +1,42 @@
+// Allocator for standard containers with over-aligned storage, e.g. for
+// buffers that are processed with SIMD instructions
+#pragma once
+
+#include <cstddef>      // For std::size_t
+#include <new>          // For std::align_val_t, std::bad_array_new_length
+#include <limits>
+
+
+namespace sini {
+
+template<typename T, std::size_t Alignment>
+struct AlignedAllocator {
+    static_assert(Alignment >= alignof(T), "Alignment can't be weaker than that of T");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+    using value_type = T;
+    template<typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_array_new_length();
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* ptr, std::size_t) noexcept
+    {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+    }
+};
+
+template<typename T, typename U, std::size_t Alignment>
+bool operator== (const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) noexcept { return true; }
+template<typename T, typename U, std::size_t Alignment>
+bool operator!= (const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) noexcept { return false; }
+
+} // namespace sini
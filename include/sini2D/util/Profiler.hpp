@@ -0,0 +1,77 @@
+// Scope profiler for inspecting frame timelines. SINI_PROFILE_SCOPE("name")
+// records the time from the macro to the end of the enclosing scope in a ring
+// buffer owned by the calling thread, so recording takes no locks. The
+// recorded scopes of all threads can be written as Chrome trace events with
+// Profiler::writeChromeTrace(), and opened in chrome://tracing or Perfetto,
+// where nested scopes show up as a hierarchy.
+//
+// Only enabled if SINI_PROFILE is defined (SINI_2D_ENABLE_PROFILING in CMake).
+// Otherwise the macros expand to nothing and Profiler is not declared.
+#pragma once
+
+#ifdef SINI_PROFILE
+
+#include <chrono>
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::uint64_t
+#include <ostream>
+
+
+namespace sini {
+
+class Profiler {
+public:
+    // Most recent scopes kept per thread
+    static constexpr size_t events_per_thread = size_t(1) << 16;
+
+    Profiler() = delete;
+
+    static uint64_t now() noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Record a scope on the calling thread. 'name' is not copied and must stay
+    // valid, e.g. a string literal.
+    static void record(const char* name, uint64_t begin_ns, uint64_t end_ns) noexcept;
+    // Name the calling thread in the trace, instead of its number. Not copied.
+    static void setThreadName(const char* name) noexcept;
+
+    // Write the scopes recorded by all threads, including finished ones, as a
+    // JSON trace. Scopes recorded while writing may be torn, so call this (and
+    // clear()) while the profiled threads are idle, e.g. between frames.
+    static void writeChromeTrace(std::ostream& out);
+    // Forget all scopes recorded so far, e.g. after warming up
+    static void clear() noexcept;
+};
+
+// Records its own lifetime
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) noexcept
+        : name(name), begin_ns(Profiler::now())
+    {}
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator= (const ProfileScope&) = delete;
+    ~ProfileScope() { Profiler::record(name, begin_ns, Profiler::now()); }
+
+private:
+    const char* const name;
+    const uint64_t begin_ns;
+};
+
+} // namespace sini
+
+#define SINI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SINI_PROFILE_CONCAT(a, b) SINI_PROFILE_CONCAT_IMPL(a, b)
+#define SINI_PROFILE_SCOPE(name) \
+    const ::sini::ProfileScope SINI_PROFILE_CONCAT(sini_profile_scope_, __LINE__){ name }
+#define SINI_PROFILE_FUNCTION() SINI_PROFILE_SCOPE(__func__)
+
+#else
+
+#define SINI_PROFILE_SCOPE(name)
+#define SINI_PROFILE_FUNCTION()
+
+#endif
@@ -0,0 +1,60 @@
+// Fixed-size pool of worker threads for data-parallel loops
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::uint32_t, std::uint64_t
+#include <exception>    // For std::exception_ptr
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace sini {
+
+class ThreadPool {
+public:
+    // With zero threads, all work is done by the thread calling parallelFor()
+    explicit ThreadPool(uint32_t n_threads);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator= (const ThreadPool&) = delete;
+    ~ThreadPool() noexcept;
+
+    uint32_t numThreads() const noexcept { return static_cast<uint32_t>(threads.size()); }
+
+    // Calls task(i) for all i in [0, n_tasks), spread over the worker threads
+    // and the calling thread, and returns when all calls have finished. If any
+    // call throws, the first exception is rethrown here once all other calls
+    // have finished.
+    // Calls from several threads are run one after another. parallelFor() must
+    // not be called from within a task.
+    void parallelFor(size_t n_tasks, const std::function<void(size_t)>& task);
+
+    // Pool shared within the library, with one worker thread less than the
+    // hardware concurrency since the calling thread also does work
+    static ThreadPool& shared();
+
+private:
+    struct Job {
+        const std::function<void(size_t)>* task;
+        size_t n_tasks;
+        std::atomic<size_t> next_task{ 0 },
+                            remaining_tasks;
+        uint32_t n_participating_threads = 0;
+        std::exception_ptr exception;
+    };
+
+    std::vector<std::thread> threads;
+    std::mutex mutex, parallel_for_mutex;
+    std::condition_variable job_available, job_done;
+    Job* current_job = nullptr;
+    uint64_t job_generation = 0;
+    bool stopping = false;
+
+    void workerLoop();
+    void runTasks(Job& job);
+};
+
+} // namespace sini
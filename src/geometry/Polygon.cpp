@@ -2,38 +2,62 @@
 
 #include <sini2D/CudaCompat.hpp>
 #include <sini2D/geometry/Line.hpp>
+#include <sini2D/geometry/TriangulationCache.hpp>
+#include <sini2D/util/Profiler.hpp>
 
-#include <algorithm>    // For std::find, std::sort
+#include <algorithm>    // For std::min, std::max
+#include <utility>      // For std::swap
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
 
 namespace sini {
 
 // Helper functions
 // =============================================================================
 namespace {
-bool isOdd(int32_t integer)
-{
-    return integer % 2 == 1;
-}
-
-// TODO put in general util file (templated)
-bool inList(vec2i element, std::vector<vec2i> list)
-{
-    return std::find(list.begin(), list.end(), element) != list.end();
-}
-bool inList(vec3i element, std::vector<vec3i> list)
+// True if the edge (a, b) crosses the ray from 'point' in the positive x
+// direction. Edges are treated as half-open in y, so a ray passing through a
+// vertex is counted exactly once.
+bool crossesRightwardRay(vec2 a, vec2 b, vec2 point) noexcept
 {
-    return std::find(list.begin(), list.end(), element) != list.end();
+    if ((a.y > point.y) == (b.y > point.y)) return false;
+    const float x_crossing = a.x + (point.y - a.y) * (b.x - a.x) / (b.y - a.y);
+    return point.x < x_crossing;
 }
 
-vec3i sorted(vec3i v)
-{
-    std::sort(&v.x, &v.z+1);
-    return v;
-}
-vec2i sorted(vec2i v) noexcept
-{
-    return { minElement(v), maxElement(v) };
-}
+// Non-horizontal polygon edges in structure-of-arrays form, oriented upwards
+// (dy > 0) so that the crossing test can be done without division
+struct UpwardEdges {
+    std::vector<float> ax, ay, by, dx, dy;
+
+    UpwardEdges(const std::vector<vec2>& vertices)
+    {
+        for (size_t i = 0, j = vertices.size()-1; i < vertices.size(); j = i++) {
+            vec2 a = vertices[j],
+                 b = vertices[i];
+            if (a.y == b.y) continue;
+            if (a.y > b.y) std::swap(a, b);
+            ax.push_back(a.x);
+            ay.push_back(a.y);
+            by.push_back(b.y);
+            dx.push_back(b.x - a.x);
+            dy.push_back(b.y - a.y);
+        }
+    }
+    size_t size() const noexcept { return ax.size(); }
+
+    // Same rule as crossesRightwardRay(), with 'point' to the left of the edge
+    // tested as (px - ax)*dy < (py - ay)*dx
+    bool crossesRightwardRay(size_t e, float px, float py) const noexcept
+    {
+        return ay[e] <= py && py < by[e]
+            && (px - ax[e])*dy[e] < (py - ay[e])*dx[e];
+    }
+};
 }
 
 
@@ -82,211 +106,192 @@ std::vector<LineSegment> Polygon::lines()
     return lines;
 }
 
-bool Polygon::envelops(vec2 point)
+bool Polygon::envelops(vec2 point) const noexcept
 {
-    std::vector<LineSegment> lines_ = lines();
-    constexpr float pi = 3.1415926535f;
-    int n_intersections;
-    for (float dir_angle = 0.0f; dir_angle < 2.0f*pi; dir_angle += pi/5.0f) {
-        Line point_to_inf{ point, { std::cos(dir_angle), std::sin(dir_angle) }};
-        int n_vertex_intersections = 0;
-        n_intersections = 0;
-
-        for (size_t i = 0; i < lines_.size(); i++) {
-            if (point_to_inf.intersectsAlongDirection(lines_[i])) n_intersections++;
-            if (point_to_inf.intersectsAlongDirection(vertices[i])) n_vertex_intersections++;
-        }
+    bool inside = false;
+    for (size_t i = 0, j = vertices.size()-1; i < vertices.size(); j = i++)
+        if (crossesRightwardRay(vertices[j], vertices[i], point)) inside = !inside;
+
+    return inside;
+}
 
-        if (n_vertex_intersections != 0) continue;
-        else break;
+void Polygon::envelopsBatch(const float* xs, const float* ys, size_t count,
+                            uint8_t* out) const
+{
+    const UpwardEdges edges{ vertices };
+    const size_t n_edges = vertices.size() < 3 ? 0 : edges.size();
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 8 <= count; i += 8) {
+        const __m256 px = _mm256_loadu_ps(xs + i),
+                     py = _mm256_loadu_ps(ys + i);
+        __m256 inside = _mm256_setzero_ps();
+        for (size_t e = 0; e < n_edges; e++) {
+            const __m256 ay = _mm256_set1_ps(edges.ay[e]);
+            const __m256 spans_y = _mm256_and_ps(
+                _mm256_cmp_ps(ay, py, _CMP_LE_OQ),
+                _mm256_cmp_ps(py, _mm256_set1_ps(edges.by[e]), _CMP_LT_OQ));
+            const __m256 left_of_edge = _mm256_cmp_ps(
+                _mm256_mul_ps(_mm256_sub_ps(px, _mm256_set1_ps(edges.ax[e])),
+                              _mm256_set1_ps(edges.dy[e])),
+                _mm256_mul_ps(_mm256_sub_ps(py, ay), _mm256_set1_ps(edges.dx[e])),
+                _CMP_LT_OQ);
+            inside = _mm256_xor_ps(inside, _mm256_and_ps(spans_y, left_of_edge));
+        }
+        const int mask = _mm256_movemask_ps(inside);
+        for (int k = 0; k < 8; k++)
+            out[i + k] = static_cast<uint8_t>((mask >> k) & 1);
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    // Two 4-wide halves, to also process 8 points per edge
+    for (; i + 8 <= count; i += 8) {
+        const __m128 px_lo = _mm_loadu_ps(xs + i), px_hi = _mm_loadu_ps(xs + i + 4),
+                     py_lo = _mm_loadu_ps(ys + i), py_hi = _mm_loadu_ps(ys + i + 4);
+        __m128 inside_lo = _mm_setzero_ps(),
+               inside_hi = _mm_setzero_ps();
+        for (size_t e = 0; e < n_edges; e++) {
+            const __m128 ax = _mm_set1_ps(edges.ax[e]), ay = _mm_set1_ps(edges.ay[e]),
+                         by = _mm_set1_ps(edges.by[e]), dx = _mm_set1_ps(edges.dx[e]),
+                         dy = _mm_set1_ps(edges.dy[e]);
+            const __m128 crosses_lo = _mm_and_ps(
+                _mm_and_ps(_mm_cmple_ps(ay, py_lo), _mm_cmplt_ps(py_lo, by)),
+                _mm_cmplt_ps(_mm_mul_ps(_mm_sub_ps(px_lo, ax), dy),
+                             _mm_mul_ps(_mm_sub_ps(py_lo, ay), dx)));
+            const __m128 crosses_hi = _mm_and_ps(
+                _mm_and_ps(_mm_cmple_ps(ay, py_hi), _mm_cmplt_ps(py_hi, by)),
+                _mm_cmplt_ps(_mm_mul_ps(_mm_sub_ps(px_hi, ax), dy),
+                             _mm_mul_ps(_mm_sub_ps(py_hi, ay), dx)));
+            inside_lo = _mm_xor_ps(inside_lo, crosses_lo);
+            inside_hi = _mm_xor_ps(inside_hi, crosses_hi);
+        }
+        const int mask = _mm_movemask_ps(inside_lo) | (_mm_movemask_ps(inside_hi) << 4);
+        for (int k = 0; k < 8; k++)
+            out[i + k] = static_cast<uint8_t>((mask >> k) & 1);
+    }
+#endif
+
+    // Scalar fallback, and the remaining points
+    for (; i < count; i++) {
+        bool inside = false;
+        for (size_t e = 0; e < n_edges; e++)
+            if (edges.crossesRightwardRay(e, xs[i], ys[i])) inside = !inside;
+        out[i] = inside ? 1 : 0;
     }
-    return isOdd(n_intersections);
 }
 
 void Polygon::buildTriangleMesh()
 {
+    SINI_PROFILE_SCOPE("Polygon::buildTriangleMesh");
     if (vertices.size() < 3) return;
     if (!triangle_mesh)
         triangle_mesh = new std::vector<vec3i>();
-    else
-        triangle_mesh->clear();
 
-    if (vertices.size() == 3) {
-        *triangle_mesh = { vec3i(0, 1, 2) };
-        return;
-    }
-
-    std::vector<vec2i> open_edges,
-                       outer_edges  = outerEdgeList(),
-                       closed_edges = outer_edges;
-    for (vec2i current_edge : outer_edges) {
-        if (edgeUsedInExistingTriangles(current_edge)) continue;
-
-        for (int32_t k = (current_edge.x+1) % vertices.size(); k != current_edge.x;
-             k = (k+1) % vertices.size()) {
-            if (k == current_edge.y) continue;
-
-            vec3i current_triangle = sorted({ current_edge, k });
-            if (inList(current_triangle, *triangle_mesh)
-                || intersectsOuterEdge(current_triangle)
-                || intersectsExistingTriangle(current_triangle)
-                || envelopsAnyVertex(current_triangle)
-                || hasEdgesOutsidePolygon(current_triangle, outer_edges)) continue;
-
-            triangle_mesh->push_back(current_triangle);
-            updateOpenAndClosedEdges(open_edges, closed_edges, current_triangle);
-            if (tryCloseOpenEdges(open_edges, closed_edges)) break;
-            else triangle_mesh->pop_back();
-        }
-    }
+    *triangle_mesh = TriangulationCache::shared().triangulate(vertices);
 }
 
-// Private member functions
-// =============================================================================
-std::vector<vec2i> Polygon::outerEdgeList()
-{
-    std::vector<vec2i> edges;
-    edges.reserve(vertices.size());
-    for (int i = 0; i < static_cast<int>(vertices.size())-1; i++)
-        edges.push_back(vec2i( i, i+1 ));
-    edges.push_back(vec2i( 0, vertices.size()-1 ));
-    return edges;
-}
 
-bool Polygon::edgeUsedInExistingTriangles(vec2i edge_indices) noexcept
-{
-    for (vec3i triangle : *triangle_mesh) {
-        if (edge_indices == triangle.xy
-            || edge_indices == triangle.yz
-            || edge_indices == vec2i(triangle.x, triangle.z))
-            return true;
-    }
-    return false;
-}
+// PreparedPolygon
+// =============================================================================
+PreparedPolygon::PreparedPolygon(const Polygon& polygon)
+    : PreparedPolygon(polygon.vertices)
+{}
 
-bool Polygon::intersectsOuterEdge(vec3i triangle_indices)
+PreparedPolygon::PreparedPolygon(const std::vector<vec2>& vertices)
 {
-    std::vector<LineSegment> outer_edges = lines();
-    for (int i = 0; i < 3; i++) {
-        vec2i edge_indices = { triangle_indices[i], triangle_indices[(i+1)%3] };
-        LineSegment triangle_edge = { vertices[edge_indices.x], vertices[edge_indices.y] };
-
-        for (int j = 0; j < static_cast<int>(outer_edges.size()); j++) {
-            vec2i vertex_indices = vec2i( j, (j+1) % vertices.size() );
-            if (edge_indices.x == vertex_indices.x
-                || edge_indices.y == vertex_indices.y
-                || edge_indices.x == vertex_indices.y
-                || edge_indices.y == vertex_indices.x) continue;
-
-            if (intersect(triangle_edge, outer_edges[j])) return true;
-        }
+    if (vertices.size() < 3) return;
+    box_min = box_max = vertices[0];
+    for (vec2 v : vertices) {
+        box_min = { std::min(box_min.x, v.x), std::min(box_min.y, v.y) };
+        box_max = { std::max(box_max.x, v.x), std::max(box_max.y, v.y) };
     }
-    return false;
-}
 
-bool Polygon::intersectsExistingTriangle(vec3i triangle_indices) noexcept
-{
-    for (vec3i existing_triangle : *triangle_mesh)
-        if (trianglesIntersect(triangle_indices, existing_triangle))
-            return true;
-    return false;
+    // Horizontal edges never cross a ray and are left out
+    const size_t n = vertices.size();
+    std::vector<Edge> edges;
+    edges.reserve(n);
+    for (size_t i = 0, j = n-1; i < n; j = i++)
+        if (vertices[i].y != vertices[j].y)
+            edges.push_back({ vertices[j], vertices[i] });
+    edges_by_bottom.reserve(edges.size());
+    edges_by_top.reserve(edges.size());
+    addNode(std::move(edges));
 }
 
-bool Polygon::trianglesIntersect(vec3i vertex_indices1, vec3i vertex_indices2) noexcept
+bool PreparedPolygon::envelops(vec2 point) const noexcept
 {
-    for (int j = 0; j < 3; j++) {
-        vec2i indices1 = { vertex_indices1[j], vertex_indices1[(j+1)%3] };
-        LineSegment edge1 = { vertices[indices1.x],
-                              vertices[indices1.y] };
-        for (int k = 0; k < 3; k++) {
-            vec2i indices2 = { vertex_indices2[k], vertex_indices2[(k+1)%3] };
-            if (indices2.x == indices1.x
-                || indices2.x == indices1.y
-                || indices2.y == indices1.x
-                || indices2.y == indices1.y)
-                continue;
-
-            LineSegment edge2 = { vertices[indices2.x], vertices[indices2.y] };
-            if (intersect(edge1, edge2)) return true;
+    if (nodes.empty()
+        || point.x < box_min.x || point.x > box_max.x
+        || point.y < box_min.y || point.y > box_max.y)
+        return false;
+
+    // Only edges spanning point.y can cross the ray. At each node, those are
+    // a prefix of one of the two orders, depending on the side of the split.
+    bool inside = false;
+    for (int32_t i = 0; i >= 0; ) {
+        const Node& node = nodes[i];
+        if (point.y < node.split) {
+            for (size_t k = node.first;
+                 k < node.last && edges_by_bottom[k].bottom() <= point.y; k++)
+                if (crossesRightwardRay(edges_by_bottom[k].a, edges_by_bottom[k].b, point))
+                    inside = !inside;
+            i = node.below;
+        }
+        else {
+            for (size_t k = node.first;
+                 k < node.last && edges_by_top[k].top() >= point.y; k++)
+                if (crossesRightwardRay(edges_by_top[k].a, edges_by_top[k].b, point))
+                    inside = !inside;
+            i = node.above;
         }
     }
-    return false;
-}
 
-bool Polygon::envelopsAnyVertex(vec3i vertex_indices)
-{
-    Polygon triangle = { vertices[vertex_indices[0]],
-                         vertices[vertex_indices[1]],
-                         vertices[vertex_indices[2]] };
-    for (int i = 0; i < static_cast<int>(vertices.size()); i++) {
-        if ( i == vertex_indices.x || i == vertex_indices.y || i == vertex_indices.z )
-            continue;
-
-        if (triangle.envelops(vertices[i]))
-            return true;
-    }
-    return false;
+    return inside;
 }
 
-bool Polygon::hasEdgesOutsidePolygon(vec3i vertex_indices, const std::vector<vec2i>& outer_edges)
+int32_t PreparedPolygon::addNode(std::vector<Edge> edges)
 {
-    for (int32_t i = 0; i < 3; i++) {
-        vec2i edge = sorted(vec2i{ vertex_indices[i], vertex_indices[(i+1)%3] });
-        if (inList(edge, outer_edges)) continue;
-
-        vec2 edge_mid_point = (vertices[edge.x] + vertices[edge.y]) / 2.0f;
-        if (!(this->envelops(edge_mid_point))) return true;
+    if (edges.empty()) return -1;
+
+    // Split at the median end point, so that each child gets at most half of
+    // the edges. The edge with that end point stays in the node.
+    std::vector<float> ys;
+    ys.reserve(2 * edges.size());
+    for (const Edge& edge : edges) {
+        ys.push_back(edge.a.y);
+        ys.push_back(edge.b.y);
     }
-    return false;
-}
-
-bool Polygon::tryCloseOpenEdges(std::vector<vec2i>& open_edges, std::vector<vec2i>& closed_edges)
-{
-    std::vector<vec2i> initial_open_edges   = open_edges,
-                       initial_closed_edges = closed_edges;
-    int32_t n_triangles_added = 0;
-    while (!open_edges.empty()) {
-        vec2i current_open_edge = open_edges.back();
-        closed_edges.push_back(current_open_edge);
-        open_edges.pop_back();
-
-        for (int32_t k = (current_open_edge.x+1) % vertices.size(); ; k = (k+1) % vertices.size()) {
-            if (k == current_open_edge.y) continue;
-            if (k == current_open_edge.x) {
-                // All possibilities tried, revert changes and report failure
-                for (int32_t i = 0; i < n_triangles_added; i++)
-                    triangle_mesh->pop_back();
-                open_edges   = initial_open_edges;
-                closed_edges = initial_closed_edges;
-                return false;
-            }
-
-            vec3i current_triangle = sorted({ current_open_edge, k });
-            if (inList(current_triangle, *triangle_mesh)
-                || intersectsOuterEdge(current_triangle)
-                || intersectsExistingTriangle(current_triangle)
-                || envelopsAnyVertex(current_triangle)) continue;
-
-            triangle_mesh->push_back(current_triangle);
-            n_triangles_added++;
-            updateOpenAndClosedEdges(open_edges, closed_edges, current_triangle);
-            break;
+    std::nth_element(ys.begin(), ys.begin() + ys.size()/2, ys.end());
+    const float split = ys[ys.size()/2];
+
+    std::vector<Edge> below, above;
+    const size_t first = edges_by_bottom.size();
+    for (const Edge& edge : edges) {
+        if (edge.top() < split)
+            below.push_back(edge);
+        else if (edge.bottom() > split)
+            above.push_back(edge);
+        else {
+            edges_by_bottom.push_back(edge);
+            edges_by_top.push_back(edge);
         }
     }
-    return true;
-}
-
-void Polygon::updateOpenAndClosedEdges(std::vector<vec2i>& open_edges,
-    const std::vector<vec2i>& closed_edges, vec3i triangle_indices)
-{
-    vec2i edges[] = { sorted(triangle_indices.xy),
-                      sorted(triangle_indices.yz),
-                      sorted(vec2i{ triangle_indices.z, triangle_indices.x }) };
-
-    for (vec2i edge : edges)
-        if (!inList(edge, closed_edges)
-            && !inList(edge, open_edges))
-            open_edges.push_back(edge);
+    const size_t last = edges_by_bottom.size();
+    std::sort(edges_by_bottom.begin() + first, edges_by_bottom.end(),
+        [](const Edge& e1, const Edge& e2) { return e1.bottom() < e2.bottom(); });
+    std::sort(edges_by_top.begin() + first, edges_by_top.end(),
+        [](const Edge& e1, const Edge& e2) { return e1.top() > e2.top(); });
+
+    const int32_t index = static_cast<int32_t>(nodes.size());
+    nodes.push_back({ split, first, last, -1, -1 });
+    edges.clear();
+    edges.shrink_to_fit();
+    // The children are added after the node, which may move it
+    const int32_t below_index = addNode(std::move(below));
+    nodes[index].below = below_index;
+    const int32_t above_index = addNode(std::move(above));
+    nodes[index].above = above_index;
+    return index;
 }
 
 
@@ -0,0 +1,272 @@
+#include <sini2D/geometry/Triangulation.hpp>
+
+#include <algorithm>    // For std::sort, std::min, std::max
+#include <cmath>        // For std::sqrt, std::ceil
+#include <limits>
+#include <utility>      // For std::swap
+
+
+namespace sini {
+
+// Helper functions
+// =============================================================================
+namespace {
+
+// Twice the signed area of the triangle (a, b, c), positive if the vertices
+// are in counter-clockwise order
+float signedArea(vec2 a, vec2 b, vec2 c) noexcept
+{
+    return (b.x - a.x)*(c.y - a.y) - (c.x - a.x)*(b.y - a.y);
+}
+
+vec3i sorted(vec3i v) noexcept
+{
+    std::sort(&v.x, &v.z+1);
+    return v;
+}
+
+// Uniform grid over the bounding box of a set of points. The indices of the
+// points in each cell are stored contiguously, cell after cell.
+class PointGrid {
+public:
+    PointGrid() noexcept = default;
+    PointGrid(const std::vector<vec2>& points, const std::vector<int32_t>& indices)
+    {
+        if (indices.empty()) return;
+        vec2 box_min = points[indices[0]],
+             box_max = box_min;
+        for (int32_t idx : indices) {
+            box_min = { std::min(box_min.x, points[idx].x), std::min(box_min.y, points[idx].y) };
+            box_max = { std::max(box_max.x, points[idx].x), std::max(box_max.y, points[idx].y) };
+        }
+        // Roughly one point per cell
+        n_cells_per_axis = std::min(static_cast<int32_t>(
+            std::ceil(std::sqrt(static_cast<float>(indices.size())))), 1024);
+        origin = box_min;
+        const vec2 extent = box_max - box_min;
+        inv_cell_size = { extent.x > 0.0f ? n_cells_per_axis / extent.x : 0.0f,
+                          extent.y > 0.0f ? n_cells_per_axis / extent.y : 0.0f };
+        // Queries are padded by a fraction of a cell, to not miss points on
+        // cell borders due to rounding
+        query_padding = 0.01f * extent / static_cast<float>(n_cells_per_axis);
+
+        // Counting sort of the points into their cells
+        cell_start.assign(n_cells_per_axis*n_cells_per_axis + 1, 0);
+        for (int32_t idx : indices)
+            cell_start[cellIndex(cellOf(points[idx])) + 1]++;
+        for (size_t i = 1; i < cell_start.size(); i++)
+            cell_start[i] += cell_start[i-1];
+        cell_points.resize(indices.size());
+        std::vector<int32_t> fill_pos(cell_start.begin(), cell_start.end()-1);
+        for (int32_t idx : indices)
+            cell_points[fill_pos[cellIndex(cellOf(points[idx]))]++] = idx;
+    }
+
+    // Returns true if 'predicate' is true for any point in a cell overlapping
+    // the triangle (a, b, c). Within each row of cells, only the cells covered
+    // by the triangle's extent in that row are visited, which matters for long
+    // and thin triangles.
+    template<typename Predicate>
+    bool anyInTriangle(vec2 a, vec2 b, vec2 c, Predicate predicate) const
+    {
+        if (cell_points.empty()) return false;
+        const float y_min = std::min(a.y, std::min(b.y, c.y)),
+                    y_max = std::max(a.y, std::max(b.y, c.y));
+        const int32_t row_min = cellOf({ origin.x, y_min - query_padding.y }).y,
+                      row_max = cellOf({ origin.x, y_max + query_padding.y }).y;
+        for (int32_t row = row_min; row <= row_max; row++) {
+            // Part of the triangle within the row, clamped to the triangle's
+            // own vertical extent so that border rows are handled as well
+            const float band_y0 = std::max(y_min, rowBottom(row) - query_padding.y),
+                        band_y1 = std::min(y_max, rowBottom(row+1) + query_padding.y);
+            float x_min = std::numeric_limits<float>::max(),
+                  x_max = std::numeric_limits<float>::lowest();
+            extendByClippedEdge(a, b, band_y0, band_y1, x_min, x_max);
+            extendByClippedEdge(b, c, band_y0, band_y1, x_min, x_max);
+            extendByClippedEdge(c, a, band_y0, band_y1, x_min, x_max);
+            if (x_min > x_max) continue;
+
+            const int32_t col_min = cellOf({ x_min - query_padding.x, origin.y }).x,
+                          col_max = cellOf({ x_max + query_padding.x, origin.y }).x;
+            for (int32_t col = col_min; col <= col_max; col++) {
+                const int32_t cell = cellIndex({ col, row });
+                for (int32_t i = cell_start[cell]; i < cell_start[cell+1]; i++)
+                    if (predicate(cell_points[i])) return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    vec2 origin = 0.0f,
+         inv_cell_size = 0.0f,
+         query_padding = 0.0f;
+    int32_t n_cells_per_axis = 0;
+    std::vector<int32_t> cell_start, cell_points;
+
+    vec2i cellOf(vec2 point) const noexcept
+    {
+        const vec2 cell = (point - origin) * inv_cell_size;
+        const float max_cell = static_cast<float>(n_cells_per_axis - 1);
+        return { static_cast<int32_t>(std::min(std::max(cell.x, 0.0f), max_cell)),
+                 static_cast<int32_t>(std::min(std::max(cell.y, 0.0f), max_cell)) };
+    }
+    int32_t cellIndex(vec2i cell) const noexcept
+    {
+        return cell.y*n_cells_per_axis + cell.x;
+    }
+    // Lower y coordinate of a row of cells, unbounded for the outermost rows
+    // since points outside the grid are clamped into them
+    float rowBottom(int32_t row) const noexcept
+    {
+        if (row <= 0) return std::numeric_limits<float>::lowest();
+        if (row >= n_cells_per_axis) return std::numeric_limits<float>::max();
+        return origin.y + row / inv_cell_size.y;
+    }
+
+    // Extend [x_min, x_max] by the x-extent of the edge p -> q clipped to the
+    // horizontal band y0 <= y <= y1
+    static void extendByClippedEdge(vec2 p, vec2 q, float y0, float y1,
+                                    float& x_min, float& x_max) noexcept
+    {
+        if (p.y > q.y) std::swap(p, q);
+        if (q.y < y0 || p.y > y1) return;
+        float x_start = p.x,
+              x_end   = q.x;
+        if (q.y > p.y) {
+            const float dx_dy = (q.x - p.x) / (q.y - p.y);
+            if (p.y < y0) x_start = p.x + (y0 - p.y) * dx_dy;
+            if (q.y > y1) x_end   = p.x + (y1 - p.y) * dx_dy;
+        }
+        x_min = std::min(x_min, std::min(x_start, x_end));
+        x_max = std::max(x_max, std::max(x_start, x_end));
+    }
+};
+
+// Ear clipping on a doubly linked list of the polygon vertices. A vertex is an
+// ear if its corner is convex and no other vertex lies inside (or on the
+// boundary of) the triangle it forms with its neighbours. Only reflex vertices
+// have to be tested, since a convex vertex can't be inside an ear without a
+// reflex vertex also being inside it. Clipping ears never turns a convex
+// vertex reflex, so the initial set of reflex vertices is indexed once and
+// vertices that are clipped or have become convex are skipped when queried.
+class EarClipper {
+public:
+    EarClipper(const std::vector<vec2>& vertices)
+        : vertices(vertices),
+          prev(vertices.size()),
+          next(vertices.size())
+    {
+        const int32_t n = static_cast<int32_t>(vertices.size());
+        for (int32_t i = 0; i < n; i++) {
+            prev[i] = (i + n - 1) % n;
+            next[i] = (i + 1) % n;
+        }
+
+        // Make the ear test independent of the winding order
+        double area = 0.0;
+        for (int32_t i = 0; i < n; i++)
+            area += static_cast<double>(vertices[i].x) * vertices[next[i]].y
+                  - static_cast<double>(vertices[next[i]].x) * vertices[i].y;
+        orientation = (area < 0.0) ? -1.0f : 1.0f;
+
+        std::vector<int32_t> reflex_vertices;
+        for (int32_t i = 0; i < n; i++)
+            if (isReflex(i)) reflex_vertices.push_back(i);
+        reflex_grid = PointGrid(vertices, reflex_vertices);
+    }
+
+    std::vector<vec3i> clip()
+    {
+        const int32_t n = static_cast<int32_t>(vertices.size());
+        std::vector<vec3i> triangles;
+        triangles.reserve(n - 2);
+
+        // Starting at vertex 1 makes (0, 1, 2) the first candidate
+        int32_t ear = 1,
+                stop = ear;
+        for (int32_t remaining = n; remaining > 3; ) {
+            const int32_t following = next[ear];
+            if (isEar(ear)) {
+                triangles.push_back(clipEar(ear));
+                remaining--;
+                // Continuing two steps ahead avoids growing a fan of thin
+                // triangles around the previous ear's neighbour
+                ear = stop = next[following];
+                continue;
+            }
+            ear = following;
+            if (ear == stop) {
+                // A full lap without finding an ear only happens if the
+                // polygon isn't simple. Clip anyway to always terminate with
+                // n-2 triangles.
+                const int32_t after_stop = next[ear];
+                triangles.push_back(clipEar(ear));
+                remaining--;
+                ear = stop = after_stop;
+            }
+        }
+        triangles.push_back(sorted({ prev[ear], ear, next[ear] }));
+        return triangles;
+    }
+
+private:
+    const std::vector<vec2>& vertices;
+    std::vector<int32_t> prev, next;
+    float orientation;
+    PointGrid reflex_grid;
+
+    bool isConvex(int32_t a, int32_t b, int32_t c) const noexcept
+    {
+        return orientation * signedArea(vertices[a], vertices[b], vertices[c]) > 0.0f;
+    }
+    bool isReflex(int32_t i) const noexcept
+    {
+        return !isConvex(prev[i], i, next[i]);
+    }
+    bool inTriangle(int32_t a, int32_t b, int32_t c, vec2 p) const noexcept
+    {
+        return orientation * signedArea(vertices[a], vertices[b], p) >= 0.0f
+            && orientation * signedArea(vertices[b], vertices[c], p) >= 0.0f
+            && orientation * signedArea(vertices[c], vertices[a], p) >= 0.0f;
+    }
+
+    bool isEar(int32_t b) const
+    {
+        const int32_t a = prev[b],
+                      c = next[b];
+        if (!isConvex(a, b, c)) return false;
+
+        return !reflex_grid.anyInTriangle(vertices[a], vertices[b], vertices[c],
+                                          [&](int32_t p) {
+            return p != a && p != b && p != c
+                && next[p] != -1
+                && isReflex(p)
+                && inTriangle(a, b, c, vertices[p]);
+        });
+    }
+
+    vec3i clipEar(int32_t ear) noexcept
+    {
+        const int32_t a = prev[ear],
+                      c = next[ear];
+        next[a] = c;
+        prev[c] = a;
+        prev[ear] = next[ear] = -1;
+        return sorted({ a, ear, c });
+    }
+};
+
+} // anonymous namespace
+
+
+std::vector<vec3i> triangulate(const std::vector<vec2>& vertices)
+{
+    if (vertices.size() < 3) return {};
+    if (vertices.size() == 3) return { vec3i(0, 1, 2) };
+
+    EarClipper ear_clipper{ vertices };
+    return ear_clipper.clip();
+}
+
+} // namespace sini
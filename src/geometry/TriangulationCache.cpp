@@ -0,0 +1,112 @@
+#include <sini2D/geometry/TriangulationCache.hpp>
+
+#include <sini2D/geometry/Triangulation.hpp>
+
+
+namespace sini {
+
+TriangulationCache::TriangulationCache(size_t capacity)
+    : capacity(capacity)
+{}
+
+
+// Member functions
+// -----------------------------------------------------------------------------
+std::vector<vec3i> TriangulationCache::triangulate(const std::vector<vec2>& vertices)
+{
+    const size_t key = hash(vertices);
+    bool fits;
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        const auto found = index.find(key);
+        if (found != index.end() && found->second->vertices == vertices) {
+            counts.hits++;
+            entries.splice(entries.begin(), entries, found->second);
+            return found->second->triangles;
+        }
+        counts.misses++;
+        fits = vertices.size() <= capacity;
+    }
+
+    std::vector<vec3i> triangles = sini::triangulate(vertices);
+    if (!fits)
+        return triangles;
+
+    std::lock_guard<std::mutex> lock{ mutex };
+    const auto found = index.find(key);
+    if (found != index.end()) {
+        // Added by another thread meanwhile, or a hash collision, in which
+        // case the newer triangulation replaces it
+        n_vertices -= found->second->vertices.size();
+        entries.erase(found->second);
+        index.erase(found);
+    }
+    if (vertices.size() > capacity)
+        return triangles;
+    evictDownTo(capacity - vertices.size());
+    entries.push_front({ key, vertices, triangles });
+    index.emplace(key, entries.begin());
+    n_vertices += vertices.size();
+    return triangles;
+}
+
+TriangulationCache::Stats TriangulationCache::stats() const
+{
+    std::lock_guard<std::mutex> lock{ mutex };
+    Stats stats = counts;
+    stats.size = entries.size();
+    stats.vertices = n_vertices;
+    stats.capacity = capacity;
+    return stats;
+}
+
+void TriangulationCache::resetStats() noexcept
+{
+    std::lock_guard<std::mutex> lock{ mutex };
+    counts = Stats();
+}
+
+void TriangulationCache::setCapacity(size_t new_capacity)
+{
+    std::lock_guard<std::mutex> lock{ mutex };
+    capacity = new_capacity;
+    evictDownTo(capacity);
+}
+
+void TriangulationCache::clear() noexcept
+{
+    std::lock_guard<std::mutex> lock{ mutex };
+    entries.clear();
+    index.clear();
+    n_vertices = 0;
+}
+
+TriangulationCache& TriangulationCache::shared()
+{
+    static TriangulationCache shared_cache{ size_t(1) << 20 };
+    return shared_cache;
+}
+
+size_t TriangulationCache::hash(const std::vector<vec2>& vertices) noexcept
+{
+    // Same combination as sini::hash(Vector), over the vertices
+    size_t hash = vertices.size();
+    for (vec2 vertex : vertices)
+        hash ^= sini::hash(vertex) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+
+// Private member functions
+// -----------------------------------------------------------------------------
+void TriangulationCache::evictDownTo(size_t max_vertices) noexcept
+{
+    while (n_vertices > max_vertices) {
+        n_vertices -= entries.back().vertices.size();
+        index.erase(entries.back().hash);
+        entries.pop_back();
+        counts.evictions++;
+    }
+}
+
+} // namespace sini
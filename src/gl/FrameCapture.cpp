@@ -0,0 +1,112 @@
+#include <sini2D/gl/FrameCapture.hpp>
+
+#include <sini2D/gl/OpenGlException.hpp>
+
+#include <algorithm>    // For std::copy_n
+#include <utility>      // For std::move
+
+
+namespace sini {
+
+FrameCapture::FrameCapture(Callback callback)
+    : callback(std::move(callback))
+{}
+
+FrameCapture::~FrameCapture()
+{
+    for (Readback& readback : readbacks) {
+        if (readback.fence) glDeleteSync(readback.fence);
+        glDeleteBuffers(1, &readback.buffer);
+    }
+}
+
+
+// Member functions
+// -----------------------------------------------------------------------------
+void FrameCapture::finish()
+{
+    while (n_in_flight > 0)
+        deliverOldest(true);
+}
+
+
+// Private member functions
+// -----------------------------------------------------------------------------
+size_t FrameCapture::capture(GLStateCache& gl_state, GLuint framebuffer, vec2i dimensions)
+{
+    // Frames are handed over in order, so stop at the first one still in use
+    while (n_in_flight > 0 && deliverOldest(false));
+    // Reuse the oldest buffer if the ring is full, which is the only wait
+    if (n_in_flight == n_buffers)
+        deliverOldest(true);
+
+    Readback& readback = readbacks[(oldest + n_in_flight) % n_buffers];
+    const size_t size = 4 * size_t(dimensions.x) * size_t(dimensions.y);
+    if (readback.buffer == 0)
+        glGenBuffers(1, &readback.buffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    if (readback.buffer_size != size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        readback.buffer_size = size;
+        gl_state.countCalls(1);
+    }
+
+    // RGBA is the format drivers copy to without converting
+    gl_state.bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, dimensions.x, dimensions.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    gl_state.countCalls(5);
+
+    readback.index = n_captured_frames++;
+    readback.dimensions = dimensions;
+    n_in_flight++;
+    return size;
+}
+
+bool FrameCapture::deliverOldest(bool wait)
+{
+    Readback& readback = readbacks[oldest];
+
+    // Flush on the first try, so that the fence is guaranteed to be signaled
+    // eventually
+    constexpr GLuint64 timeout_ns = 1000000000;
+    GLenum result = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                     wait ? timeout_ns : 0);
+    while (wait && result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(readback.fence, 0, timeout_ns);
+    if (result == GL_TIMEOUT_EXPIRED)
+        return false;
+
+    glDeleteSync(readback.fence);
+    readback.fence = nullptr;
+    oldest = (oldest + 1) % n_buffers;
+    n_in_flight--;
+    // The frame is dropped, since its pixels may not have been written
+    if (result == GL_WAIT_FAILED)
+        throw OpenGlException("Waiting for a frame capture failed");
+
+    CapturedFrame frame{ readback.index, readback.dimensions, {} };
+    frame.pixels.resize(readback.buffer_size);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    const auto* mapped = static_cast<const uint8_t*>(glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, readback.buffer_size, GL_MAP_READ_BIT));
+    if (!mapped) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        throw OpenGlException("Frame capture buffer could not be mapped");
+    }
+    // GL's rows are from bottom to top
+    const size_t row_size = 4 * size_t(readback.dimensions.x);
+    const int height = readback.dimensions.y;
+    for (int y = 0; y < height; ++y)
+        std::copy_n(mapped + (height - 1 - y) * row_size, row_size,
+                    frame.pixels.data() + y * row_size);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    callback(std::move(frame));
+    return true;
+}
+
+} // namespace sini
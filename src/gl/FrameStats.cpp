@@ -0,0 +1,96 @@
+#include <sini2D/gl/FrameStats.hpp>
+
+#include <ios>          // For std::ios_base
+#include <locale>
+
+
+namespace sini {
+
+namespace {
+
+constexpr const char* column_names[] = {
+    "frame_index", "draw_calls", "vertices", "elements", "bytes_uploaded",
+    "framebuffer_bytes_copied", "gl_calls", "buffer_growths", "cpu_submit_ms",
+    "cpu_frame_ms", "gpu_draw_ms", "gpu_present_ms", "gpu_ms"
+};
+constexpr size_t n_columns = sizeof(column_names) / sizeof(column_names[0]);
+
+// Calls write(name, value) for each column of a frame
+template<typename Write>
+void forEachColumn(const FrameStats& stats, Write write)
+{
+    write(column_names[0], stats.frame_index);
+    write(column_names[1], stats.draw_calls);
+    write(column_names[2], stats.vertices);
+    write(column_names[3], stats.elements);
+    write(column_names[4], stats.bytes_uploaded);
+    write(column_names[5], stats.framebuffer_bytes_copied);
+    write(column_names[6], stats.gl_calls);
+    write(column_names[7], stats.buffer_growths);
+    write(column_names[8], stats.cpu_submit_ms);
+    write(column_names[9], stats.cpu_frame_ms);
+    write(column_names[10], stats.gpu_draw_ms);
+    write(column_names[11], stats.gpu_present_ms);
+    write(column_names[12], stats.gpuMs());
+}
+
+// Numbers are written the same way regardless of the global locale, e.g.
+// with '.' as decimal point, and restored afterwards
+class ClassicFormat {
+public:
+    explicit ClassicFormat(std::ostream& out)
+        : out(out), old_locale(out.imbue(std::locale::classic())),
+          old_flags(out.flags()), old_precision(out.precision(6))
+    {
+        out.setf(std::ios_base::fmtflags(0), std::ios_base::floatfield);
+    }
+    ~ClassicFormat()
+    {
+        out.imbue(old_locale);
+        out.flags(old_flags);
+        out.precision(old_precision);
+    }
+
+private:
+    std::ostream& out;
+    std::locale old_locale;
+    std::ios_base::fmtflags old_flags;
+    std::streamsize old_precision;
+};
+
+} // anonymous namespace
+
+
+void FrameLog::writeJson(std::ostream& out) const
+{
+    ClassicFormat format{ out };
+    out << "[";
+    for (size_t i = 0; i < log.size(); ++i) {
+        out << (i == 0 ? "\n  {" : ",\n  {");
+        bool first = true;
+        forEachColumn(log[i], [&](const char* name, auto value) {
+            out << (first ? "\"" : ", \"") << name << "\": " << value;
+            first = false;
+        });
+        out << "}";
+    }
+    out << "\n]\n";
+}
+
+void FrameLog::writeCsv(std::ostream& out) const
+{
+    ClassicFormat format{ out };
+    for (size_t i = 0; i < n_columns; ++i)
+        out << (i == 0 ? "" : ",") << column_names[i];
+    out << "\n";
+    for (const FrameStats& stats : log) {
+        bool first = true;
+        forEachColumn(stats, [&](const char*, auto value) {
+            out << (first ? "" : ",") << value;
+            first = false;
+        });
+        out << "\n";
+    }
+}
+
+} // namespace sini
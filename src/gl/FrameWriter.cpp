@@ -0,0 +1,120 @@
+#include <sini2D/gl/FrameWriter.hpp>
+
+#include <stdexcept>
+#include <utility>      // For std::move
+#include <vector>
+
+
+namespace sini {
+
+FrameWriter::FrameWriter(const std::string& path, Format format, size_t max_queued_frames)
+    : file(path, std::ios::binary | std::ios::trunc),
+      format(format),
+      max_queued_frames(max_queued_frames > 0 ? max_queued_frames : 1)
+{
+    if (!file)
+        throw std::runtime_error("Failed to open " + path + " for writing frames");
+    thread = std::thread([this]() { writerLoop(); });
+}
+
+FrameWriter::~FrameWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        stopping = true;
+    }
+    frame_queued.notify_one();
+    thread.join();
+}
+
+
+// Member functions
+// -----------------------------------------------------------------------------
+void FrameWriter::write(CapturedFrame frame)
+{
+    {
+        std::unique_lock<std::mutex> lock{ mutex };
+        frame_written.wait(lock, [this]() {
+            return queue.size() < max_queued_frames || error;
+        });
+        rethrowError();
+        queue.push_back(std::move(frame));
+    }
+    frame_queued.notify_one();
+}
+
+void FrameWriter::flush()
+{
+    std::unique_lock<std::mutex> lock{ mutex };
+    frame_written.wait(lock, [this]() { return (queue.empty() && !writing) || error; });
+    rethrowError();
+    // The writer thread is idle, and only touches the file with a frame
+    file.flush();
+    if (!file)
+        throw std::runtime_error("Failed to write frames");
+}
+
+uint64_t FrameWriter::numWrittenFrames() const noexcept
+{
+    std::lock_guard<std::mutex> lock{ mutex };
+    return n_written_frames;
+}
+
+
+// Private member functions
+// -----------------------------------------------------------------------------
+void FrameWriter::writerLoop()
+{
+    std::unique_lock<std::mutex> lock{ mutex };
+    while (true) {
+        frame_queued.wait(lock, [this]() { return !queue.empty() || stopping; });
+        // Queued frames are still written when stopping, unless writing failed
+        if (queue.empty() || error)
+            return;
+
+        CapturedFrame frame = std::move(queue.front());
+        queue.pop_front();
+        writing = true;
+        lock.unlock();
+        std::exception_ptr write_error;
+        try {
+            writeFrame(frame);
+        }
+        catch (...) {
+            write_error = std::current_exception();
+        }
+        lock.lock();
+        writing = false;
+        if (write_error) error = write_error;
+        else n_written_frames++;
+        frame_written.notify_all();
+    }
+}
+
+void FrameWriter::writeFrame(const CapturedFrame& frame)
+{
+    const size_t n_pixels = size_t(frame.dimensions.x) * size_t(frame.dimensions.y);
+    if (format == Format::RAW_RGBA) {
+        file.write(reinterpret_cast<const char*>(frame.pixels.data()), 4 * n_pixels);
+    }
+    else {
+        file << "P6\n" << frame.dimensions.x << " " << frame.dimensions.y << "\n255\n";
+        std::vector<char> rgb(3 * n_pixels);
+        for (size_t i = 0; i < n_pixels; ++i) {
+            rgb[3*i]   = static_cast<char>(frame.pixels[4*i]);
+            rgb[3*i+1] = static_cast<char>(frame.pixels[4*i+1]);
+            rgb[3*i+2] = static_cast<char>(frame.pixels[4*i+2]);
+        }
+        file.write(rgb.data(), rgb.size());
+    }
+    if (!file)
+        throw std::runtime_error("Failed to write frame " + std::to_string(frame.index));
+}
+
+void FrameWriter::rethrowError()
+{
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace sini
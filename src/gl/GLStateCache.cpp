@@ -0,0 +1,101 @@
+#include <sini2D/gl/GLStateCache.hpp>
+
+#include <sini2D/gl/ShaderProgram.hpp>
+
+
+namespace sini {
+
+void GLStateCache::useProgram(GLuint new_program) noexcept
+{
+    if (new_program == program) return;
+    glUseProgram(new_program);
+    program = new_program;
+    call_count++;
+}
+
+void GLStateCache::bindVertexArray(GLuint new_vertex_array) noexcept
+{
+    if (new_vertex_array == vertex_array) return;
+    glBindVertexArray(new_vertex_array);
+    vertex_array = new_vertex_array;
+    call_count++;
+}
+
+void GLStateCache::bindArrayBuffer(GLuint buffer) noexcept
+{
+    if (buffer == array_buffer) return;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    array_buffer = buffer;
+    call_count++;
+}
+
+void GLStateCache::bindFramebuffer(GLenum target, GLuint framebuffer) noexcept
+{
+    const bool draw = (target != GL_READ_FRAMEBUFFER),
+               read = (target != GL_DRAW_FRAMEBUFFER);
+    if ((!draw || framebuffer == draw_framebuffer)
+        && (!read || framebuffer == read_framebuffer))
+    {
+        return;
+    }
+    // Bind both at once if both change
+    if (draw && read && framebuffer != draw_framebuffer
+        && framebuffer != read_framebuffer)
+    {
+        target = GL_FRAMEBUFFER;
+    }
+    else if (draw && framebuffer != draw_framebuffer) {
+        target = GL_DRAW_FRAMEBUFFER;
+    }
+    else {
+        target = GL_READ_FRAMEBUFFER;
+    }
+    glBindFramebuffer(target, framebuffer);
+    if (target != GL_READ_FRAMEBUFFER) draw_framebuffer = framebuffer;
+    if (target != GL_DRAW_FRAMEBUFFER) read_framebuffer = framebuffer;
+    call_count++;
+}
+
+void GLStateCache::setBlending(bool enabled) noexcept
+{
+    if (static_cast<int>(enabled) == blending) return;
+    if (enabled) glEnable(GL_BLEND);
+    else         glDisable(GL_BLEND);
+    blending = static_cast<int>(enabled);
+    call_count++;
+}
+
+void GLStateCache::setUniform(ShaderProgram& shader, GLint location, float value) noexcept
+{
+    if (shader.setUniform(location, value)) call_count++;
+}
+
+void GLStateCache::setUniform(ShaderProgram& shader, GLint location,
+                              const vec4& value) noexcept
+{
+    if (shader.setUniform(location, value)) call_count++;
+}
+
+void GLStateCache::setUniform(ShaderProgram& shader, GLint location,
+                              const mat2& value) noexcept
+{
+    if (shader.setUniform(location, value)) call_count++;
+}
+
+void GLStateCache::setUniform(ShaderProgram& shader, GLint location,
+                              const mat3& value) noexcept
+{
+    if (shader.setUniform(location, value)) call_count++;
+}
+
+void GLStateCache::invalidate() noexcept
+{
+    program = unknown;
+    vertex_array = unknown;
+    array_buffer = unknown;
+    draw_framebuffer = unknown;
+    read_framebuffer = unknown;
+    blending = -1;
+}
+
+} // namespace sini
@@ -0,0 +1,106 @@
+#include <sini2D/gl/GpuTimer.hpp>
+
+
+namespace sini {
+
+GpuTimer::Scope::Scope(GpuTimer* timer, Section section) noexcept
+    : timer(timer)
+{
+    if (timer) timer->begin(section);
+}
+
+GpuTimer::Scope::~Scope()
+{
+    if (timer) timer->end();
+}
+
+GpuTimer::~GpuTimer()
+{
+    for (Frame& frame : frames)
+        if (!frame.queries.empty())
+            glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+}
+
+
+// Member functions
+// -----------------------------------------------------------------------------
+void GpuTimer::begin(Section section) noexcept
+{
+    open_section = section;
+    glQueryCounter(nextQuery(), GL_TIMESTAMP);
+}
+
+void GpuTimer::end() noexcept
+{
+    currentFrame().sections.push_back(open_section);
+    glQueryCounter(nextQuery(), GL_TIMESTAMP);
+}
+
+void GpuTimer::endFrame(const FrameStats& stats, FrameLog& log)
+{
+    currentFrame().stats = stats;
+    n_in_flight++;
+
+    // Frames are logged in order, so stop at the first one still in use
+    while (n_in_flight > 0 && logOldest(log, false));
+    // The next frame reuses the oldest one's queries if the ring is full
+    if (n_in_flight == n_frames)
+        logOldest(log, true);
+}
+
+void GpuTimer::finish(FrameLog& log)
+{
+    while (n_in_flight > 0)
+        logOldest(log, true);
+}
+
+
+// Private member functions
+// -----------------------------------------------------------------------------
+GLuint GpuTimer::nextQuery() noexcept
+{
+    Frame& frame = currentFrame();
+    if (frame.n_used_queries == frame.queries.size()) {
+        // Grows to the number of sections per frame, and then stays
+        const size_t old_size = frame.queries.size();
+        frame.queries.resize(old_size == 0 ? 16 : 2 * old_size);
+        glGenQueries(static_cast<GLsizei>(frame.queries.size() - old_size),
+                     frame.queries.data() + old_size);
+    }
+    return frame.queries[frame.n_used_queries++];
+}
+
+bool GpuTimer::logOldest(FrameLog& log, bool wait)
+{
+    Frame& frame = frames[oldest];
+    FrameStats stats = frame.stats;
+    stats.gpu_draw_ms = 0.0;
+    stats.gpu_present_ms = 0.0;
+    if (frame.n_used_queries > 0) {
+        // Queries complete in order
+        if (!wait) {
+            GLuint available = GL_FALSE;
+            glGetQueryObjectuiv(frame.queries[frame.n_used_queries - 1],
+                                GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                return false;
+        }
+        for (size_t i = 0; i < frame.sections.size(); ++i) {
+            GLuint64 begin_ns = 0, end_ns = 0;
+            glGetQueryObjectui64v(frame.queries[2*i], GL_QUERY_RESULT, &begin_ns);
+            glGetQueryObjectui64v(frame.queries[2*i + 1], GL_QUERY_RESULT, &end_ns);
+            const double ms = 1e-6 * double(end_ns - begin_ns);
+            if (frame.sections[i] == DRAW) stats.gpu_draw_ms += ms;
+            else stats.gpu_present_ms += ms;
+        }
+    }
+
+    frame.n_used_queries = 0;
+    frame.sections.clear();
+    oldest = (oldest + 1) % n_frames;
+    n_in_flight--;
+    log.add(stats);
+    return true;
+}
+
+} // namespace sini
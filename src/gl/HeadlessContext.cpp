@@ -0,0 +1,119 @@
+#include <sini2D/gl/HeadlessContext.hpp>
+
+#include <sini2D/gl/OpenGlException.hpp>
+
+#include <EGL/eglext.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+
+namespace sini {
+
+namespace {
+
+bool hasExtension(const char* extensions, const char* name) noexcept
+{
+    if (extensions == nullptr)
+        return false;
+
+    // Match whole, space separated names only
+    const size_t length = std::strlen(name);
+    for (const char* s = std::strstr(extensions, name); s != nullptr;
+         s = std::strstr(s + length, name)) {
+        const bool starts_name = s == extensions || s[-1] == ' ';
+        const bool ends_name = s[length] == ' ' || s[length] == '\0';
+        if (starts_name && ends_name)
+            return true;
+    }
+    return false;
+}
+
+OpenGlException eglException(const char* what)
+{
+    std::stringstream message;
+    message << what << " (EGL error 0x" << std::hex << eglGetError() << ")";
+    return OpenGlException(message.str());
+}
+
+} // anonymous namespace
+
+
+HeadlessContext::HeadlessContext(int gl_major_version, int gl_minor_version)
+{
+    // Querying client extensions with EGL_NO_DISPLAY requires
+    // EGL_EXT_client_extensions, and returns NULL otherwise
+    const char* client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (hasExtension(client_extensions, "EGL_MESA_platform_surfaceless")) {
+        auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (get_platform_display != nullptr)
+            display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA,
+                                           EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+        throw eglException("Failed to initialize EGL display");
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+        throw eglException("EGL display doesn't support OpenGL");
+
+    const bool surfaceless =
+        hasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+    const EGLint config_attributes[] = {
+        EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint n_configs = 0;
+    if (!eglChooseConfig(display, config_attributes, &config, 1, &n_configs)
+        || n_configs == 0)
+        throw eglException("No suitable EGL config");
+
+    const EGLint context_attributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, gl_major_version,
+        EGL_CONTEXT_MINOR_VERSION, gl_minor_version,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    handle = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+    if (handle == EGL_NO_CONTEXT)
+        throw eglException((std::string("Failed to create OpenGL ")
+                            + std::to_string(gl_major_version) + "."
+                            + std::to_string(gl_minor_version) + " context").c_str());
+
+    // Rendering only goes to framebuffer objects, but without surfaceless
+    // contexts a (minimal) surface must still be made current
+    if (!surfaceless) {
+        const EGLint pbuffer_attributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        surface = eglCreatePbufferSurface(display, config, pbuffer_attributes);
+        if (surface == EGL_NO_SURFACE) {
+            eglDestroyContext(display, handle);
+            throw eglException("Failed to create EGL pbuffer surface");
+        }
+    }
+    if (!eglMakeCurrent(display, surface, surface, handle)) {
+        if (surface != EGL_NO_SURFACE)
+            eglDestroySurface(display, surface);
+        eglDestroyContext(display, handle);
+        throw eglException("Failed to make EGL context current");
+    }
+}
+
+HeadlessContext::~HeadlessContext()
+{
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (surface != EGL_NO_SURFACE)
+        eglDestroySurface(display, surface);
+    eglDestroyContext(display, handle);
+    // The display is not terminated, since it's shared by all contexts
+    // created on it in the process
+}
+
+}
@@ -0,0 +1,378 @@
+#include <sini2D/gl/PrimitiveVertices.hpp>
+
+#include <sini2D/geometry/Polygon.hpp>
+
+#include <algorithm>    // For std::min, std::max
+#include <array>
+#include <cmath>
+#include <vector>
+
+
+namespace sini {
+
+// Helper functions
+// -----------------------------------------------------------------------------
+namespace {
+
+constexpr float two_pi = 2.0f * 3.1415926535f;
+
+// Levels of detail of curves, with 8 << i segments
+constexpr int n_curve_lods = 8,
+              min_curve_segments = 8,
+              max_curve_segments = min_curve_segments << (n_curve_lods - 1);
+
+std::array<vec2,4> setupRectangleVertices(vec2 bottom_left, vec2 upper_right) noexcept
+{
+    std::array<vec2, 4> vertices;
+    vertices[0] = bottom_left;
+    vertices[1] = { upper_right.x, bottom_left.y };
+    vertices[2] = upper_right;
+    vertices[3] = { bottom_left.x, upper_right.y };
+
+    return vertices;
+}
+
+Polygon createCirclePolygon(int n_segments)
+{
+    std::vector<vec2> vertices;
+    vertices.reserve(n_segments);
+    for (int i = 0; i < n_segments; ++i) {
+        const float angle = two_pi * i / n_segments;
+        vertices.push_back({ std::cos(angle), std::sin(angle) });
+    }
+    Polygon circle{ std::move(vertices) };
+    circle.buildTriangleMesh();
+    return circle;
+}
+
+ColorVertex colorVertex(vec2 position, vec3 color, float alpha) noexcept
+{
+    return ColorVertex({ position.x, position.y, color[0], color[1], color[2], alpha });
+}
+
+// The arc's points, starting from the unit circle's, rotated to 'start_angle'
+// and mirrored if the arc is clockwise. The end point is exact.
+void writeArcVertices(ColorVertex* out, vec2 center, float radius, float start_angle,
+                      float sweep, int n_segments, vec3 color, float alpha) noexcept
+{
+    const std::vector<vec2>& unit_vertices = unitCircle(n_segments).vertices;
+    const size_t n_arc_segments = numArcSegments(sweep, n_segments);
+    const float c = std::cos(start_angle),
+                s = std::sin(start_angle),
+                direction = sweep < 0.0f ? -1.0f : 1.0f;
+    for (size_t i = 0; i < n_arc_segments; ++i) {
+        const vec2 u{ unit_vertices[i].x, direction * unit_vertices[i].y };
+        out[i] = colorVertex(center + radius * vec2(c*u.x - s*u.y, s*u.x + c*u.y),
+                             color, alpha);
+    }
+    sweep = std::min(std::max(sweep, -two_pi), two_pi);
+    const float end_angle = start_angle + sweep;
+    out[n_arc_segments] = colorVertex(
+        center + radius * vec2(std::cos(end_angle), std::sin(end_angle)), color, alpha);
+}
+
+// Quarter circles around the corners, counterclockwise from the upper right
+void writeRoundedRectangleVertices(ColorVertex* out, vec2 bottom_left, vec2 upper_right,
+                                   float corner_radius, int n_segments, vec3 color,
+                                   float alpha) noexcept
+{
+    const std::vector<vec2>& unit_vertices = unitCircle(n_segments).vertices;
+    const float r = roundedCornerRadius(bottom_left, upper_right, corner_radius);
+    const vec2 corner_centers[4] = { { upper_right.x - r, upper_right.y - r },
+                                     { bottom_left.x + r, upper_right.y - r },
+                                     { bottom_left.x + r, bottom_left.y + r },
+                                     { upper_right.x - r, bottom_left.y + r } };
+    const int quarter = n_segments / 4;
+    for (int corner = 0; corner < 4; ++corner)
+        for (int i = 0; i <= quarter; ++i)
+            *out++ = colorVertex(corner_centers[corner]
+                + r * unit_vertices[(corner*quarter + i) % n_segments], color, alpha);
+}
+
+void writeVertices(ColorVertex* out, const std::vector<vec2>& vertices, vec3 color,
+                   float alpha) noexcept
+{
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const vec2 vertex = vertices[i];
+        out[i] = ColorVertex({ vertex.x, vertex.y, color[0], color[1], color[2], alpha });
+    }
+}
+
+void writeCircleVertices(ColorVertex* out, vec2 center, float radius, vec3 color,
+                         float alpha) noexcept
+{
+    const std::vector<vec2>& unit_vertices = unitCircle().vertices;
+    for (size_t i = 0; i < unit_vertices.size(); ++i) {
+        vec2 vertex = unit_vertices[i];
+        vertex *= radius;
+        vertex += center;
+        out[i] = ColorVertex({ vertex.x, vertex.y, color[0], color[1], color[2], alpha });
+    }
+}
+
+void writeShapeVertices(ColorVertex* out, Shape shape, const mat3& model_to_world,
+                        vec3 color, float alpha) noexcept
+{
+    static const std::vector<vec2> square_vertices{
+        { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+    const std::vector<vec2>& unit_vertices =
+        shape == Shape::SQUARE ? square_vertices : unitCircle().vertices;
+    const mat3& m = model_to_world;
+    for (size_t i = 0; i < unit_vertices.size(); ++i) {
+        const vec2 v = unit_vertices[i];
+        out[i] = ColorVertex({ m.e00*v.x + m.e01*v.y + m.e02, m.e10*v.x + m.e11*v.y + m.e12,
+                               color[0], color[1], color[2], alpha });
+    }
+}
+
+void writeOutlineElements(GLuint* elements, GLuint first_vertex, size_t n_vertices) noexcept
+{
+    for (size_t i = 0; i < n_vertices-1; ++i) {
+        elements[2*i]   = first_vertex + static_cast<GLuint>(i);
+        elements[2*i+1] = first_vertex + static_cast<GLuint>(i+1);
+    }
+    elements[2*n_vertices-2] = first_vertex + static_cast<GLuint>(n_vertices-1);
+    elements[2*n_vertices-1] = first_vertex;
+}
+
+void writeTriangleElements(GLuint* elements, GLuint first_vertex,
+                           const std::vector<vec3i>& triangles) noexcept
+{
+    for (vec3i index_triplet : triangles)
+        for (int idx : index_triplet)
+            *elements++ = first_vertex + static_cast<GLuint>(idx);
+}
+
+// Open line strip
+void writeStripElements(GLuint* elements, GLuint first_vertex, size_t n_vertices) noexcept
+{
+    for (size_t i = 0; i + 1 < n_vertices; ++i) {
+        *elements++ = first_vertex + static_cast<GLuint>(i);
+        *elements++ = first_vertex + static_cast<GLuint>(i+1);
+    }
+}
+
+// Triangles around the first vertex, for convex polygons
+void writeFanElements(GLuint* elements, GLuint first_vertex, size_t n_vertices) noexcept
+{
+    for (size_t i = 1; i + 1 < n_vertices; ++i) {
+        *elements++ = first_vertex;
+        *elements++ = first_vertex + static_cast<GLuint>(i);
+        *elements++ = first_vertex + static_cast<GLuint>(i+1);
+    }
+}
+
+} // anonymous namespace
+
+
+// Functions
+// -----------------------------------------------------------------------------
+const Polygon& unitCircle()
+{
+    return unitCircle(64);
+}
+
+int curveSegments(float radius, float pixels_per_unit) noexcept
+{
+    if (!(pixels_per_unit > 0.0f))
+        return 64;
+
+    // The distance between a chord and the circle is r(1 - cos(pi/n))
+    constexpr float max_error_px = 0.25f;
+    const float radius_px = std::abs(radius) * pixels_per_unit;
+    if (!(radius_px > max_error_px))
+        return min_curve_segments;
+    const float min_segments = 0.5f * two_pi / std::acos(1.0f - max_error_px / radius_px);
+    int n_segments = min_curve_segments;
+    while (n_segments < max_curve_segments && n_segments < min_segments)
+        n_segments *= 2;
+    return n_segments;
+}
+
+const Polygon& unitCircle(int n_segments)
+{
+    static const std::vector<Polygon> circles = []() {
+        std::vector<Polygon> circles;
+        circles.reserve(n_curve_lods);
+        for (int lod = 0; lod < n_curve_lods; ++lod)
+            circles.push_back(createCirclePolygon(min_curve_segments << lod));
+        return circles;
+    }();
+    int lod = 0;
+    while (lod < n_curve_lods - 1 && (min_curve_segments << lod) < n_segments)
+        lod++;
+    return circles[lod];
+}
+
+size_t numArcSegments(float sweep, int n_segments) noexcept
+{
+    // Slightly less than a segment left over rounds down, so that e.g. a
+    // quarter turn doesn't get a sliver of a segment
+    const float turns = std::min(std::abs(sweep) / two_pi, 1.0f);
+    const int n_arc_segments = static_cast<int>(std::ceil(turns * n_segments - 1e-3f));
+    return static_cast<size_t>(std::max(1, std::min(n_arc_segments, n_segments)));
+}
+
+float roundedCornerRadius(vec2 bottom_left, vec2 upper_right, float corner_radius) noexcept
+{
+    return std::max(0.0f, std::min(corner_radius,
+        0.5f * std::min(upper_right.x - bottom_left.x, upper_right.y - bottom_left.y)));
+}
+
+size_t numShapeVertices(Shape shape) noexcept
+{
+    return shape == Shape::SQUARE ? 4 : unitCircle().vertices.size();
+}
+
+size_t numFilledShapeElements(Shape shape) noexcept
+{
+    return shape == Shape::SQUARE ? 6 : 3*unitCircle().triangle_mesh->size();
+}
+
+void writePolygonOutline(VertexCursor cursor, const Polygon& polygon, vec3 color,
+                         float alpha) noexcept
+{
+    writeVertices(cursor.vertices, polygon.vertices, color, alpha);
+    writeOutlineElements(cursor.elements, cursor.first_vertex, polygon.vertices.size());
+}
+
+void writePolygonTriangleMesh(VertexCursor cursor, const Polygon& polygon, vec3 color,
+                              float alpha) noexcept
+{
+    writeVertices(cursor.vertices, polygon.vertices, color, alpha);
+    GLuint* elements = cursor.elements;
+    for (vec3i triangle : *polygon.triangle_mesh) {
+        const GLuint a = cursor.first_vertex + static_cast<GLuint>(triangle.x),
+                     b = cursor.first_vertex + static_cast<GLuint>(triangle.y),
+                     c = cursor.first_vertex + static_cast<GLuint>(triangle.z);
+        *elements++ = a; *elements++ = b;
+        *elements++ = b; *elements++ = c;
+        *elements++ = c; *elements++ = a;
+    }
+}
+
+void writeRectangleOutline(VertexCursor cursor, vec2 bottom_left, vec2 upper_right,
+                           vec3 color, float alpha) noexcept
+{
+    const std::array<vec2, 4> vertices = setupRectangleVertices(bottom_left, upper_right);
+    for (int i = 0; i < 4; ++i)
+        cursor.vertices[i] =
+            ColorVertex({ vertices[i].x, vertices[i].y, color[0], color[1], color[2], alpha });
+
+    const GLuint indices[] = { 0, 1, 1, 2, 2, 3, 3, 0 };
+    for (int i = 0; i < 8; ++i)
+        cursor.elements[i] = cursor.first_vertex + indices[i];
+}
+
+void writeCircleOutline(VertexCursor cursor, vec2 center, float radius, vec3 color,
+                        float alpha) noexcept
+{
+    writeCircleVertices(cursor.vertices, center, radius, color, alpha);
+    writeOutlineElements(cursor.elements, cursor.first_vertex, unitCircle().vertices.size());
+}
+
+void writeShapeOutline(VertexCursor cursor, Shape shape, const mat3& model_to_world,
+                       vec3 color, float alpha) noexcept
+{
+    writeShapeVertices(cursor.vertices, shape, model_to_world, color, alpha);
+    writeOutlineElements(cursor.elements, cursor.first_vertex, numShapeVertices(shape));
+}
+
+void writeEllipseOutline(VertexCursor cursor, vec2 center, vec2 radii, int n_segments,
+                         vec3 color, float alpha) noexcept
+{
+    const std::vector<vec2>& unit_vertices = unitCircle(n_segments).vertices;
+    for (size_t i = 0; i < unit_vertices.size(); ++i)
+        cursor.vertices[i] = colorVertex(center + radii * unit_vertices[i], color, alpha);
+    writeOutlineElements(cursor.elements, cursor.first_vertex, unit_vertices.size());
+}
+
+void writeArc(VertexCursor cursor, vec2 center, float radius, float start_angle,
+              float sweep, int n_segments, vec3 color, float alpha) noexcept
+{
+    writeArcVertices(cursor.vertices, center, radius, start_angle, sweep, n_segments,
+                     color, alpha);
+    writeStripElements(cursor.elements, cursor.first_vertex,
+                       numArcSegments(sweep, n_segments) + 1);
+}
+
+void writeRoundedRectangleOutline(VertexCursor cursor, vec2 bottom_left, vec2 upper_right,
+                                  float corner_radius, int n_segments, vec3 color,
+                                  float alpha) noexcept
+{
+    writeRoundedRectangleVertices(cursor.vertices, bottom_left, upper_right, corner_radius,
+                                  n_segments, color, alpha);
+    writeOutlineElements(cursor.elements, cursor.first_vertex, n_segments + 4);
+}
+
+void writeFilledPolygon(VertexCursor cursor, const Polygon& polygon, vec3 color,
+                        float alpha) noexcept
+{
+    writeVertices(cursor.vertices, polygon.vertices, color, alpha);
+    writeTriangleElements(cursor.elements, cursor.first_vertex, *polygon.triangle_mesh);
+}
+
+void writeFilledRectangle(VertexCursor cursor, vec2 bottom_left, vec2 upper_right,
+                          vec3 color, float alpha) noexcept
+{
+    const std::array<vec2, 4> vertices = setupRectangleVertices(bottom_left, upper_right);
+    for (int i = 0; i < 4; ++i)
+        cursor.vertices[i] =
+            ColorVertex({ vertices[i].x, vertices[i].y, color[0], color[1], color[2], alpha });
+
+    const GLuint indices[] = { 0, 1, 2, 0, 2, 3 };
+    for (int i = 0; i < 6; ++i)
+        cursor.elements[i] = cursor.first_vertex + indices[i];
+}
+
+void writeFilledCircle(VertexCursor cursor, vec2 center, float radius, vec3 color,
+                       float alpha) noexcept
+{
+    writeCircleVertices(cursor.vertices, center, radius, color, alpha);
+    writeTriangleElements(cursor.elements, cursor.first_vertex, *unitCircle().triangle_mesh);
+}
+
+void writeFilledShape(VertexCursor cursor, Shape shape, const mat3& model_to_world,
+                      vec3 color, float alpha) noexcept
+{
+    writeShapeVertices(cursor.vertices, shape, model_to_world, color, alpha);
+    if (shape == Shape::SQUARE) {
+        const GLuint indices[] = { 0, 1, 2, 0, 2, 3 };
+        for (int i = 0; i < 6; ++i)
+            cursor.elements[i] = cursor.first_vertex + indices[i];
+    }
+    else {
+        writeTriangleElements(cursor.elements, cursor.first_vertex,
+                              *unitCircle().triangle_mesh);
+    }
+}
+
+void writeFilledEllipse(VertexCursor cursor, vec2 center, vec2 radii, int n_segments,
+                        vec3 color, float alpha) noexcept
+{
+    const Polygon& circle = unitCircle(n_segments);
+    for (size_t i = 0; i < circle.vertices.size(); ++i)
+        cursor.vertices[i] = colorVertex(center + radii * circle.vertices[i], color, alpha);
+    writeTriangleElements(cursor.elements, cursor.first_vertex, *circle.triangle_mesh);
+}
+
+void writeFilledArc(VertexCursor cursor, vec2 center, float radius, float start_angle,
+                    float sweep, int n_segments, vec3 color, float alpha) noexcept
+{
+    cursor.vertices[0] = colorVertex(center, color, alpha);
+    writeArcVertices(cursor.vertices + 1, center, radius, start_angle, sweep, n_segments,
+                     color, alpha);
+    writeFanElements(cursor.elements, cursor.first_vertex,
+                     numArcSegments(sweep, n_segments) + 2);
+}
+
+void writeFilledRoundedRectangle(VertexCursor cursor, vec2 bottom_left, vec2 upper_right,
+                                 float corner_radius, int n_segments, vec3 color,
+                                 float alpha) noexcept
+{
+    writeRoundedRectangleVertices(cursor.vertices, bottom_left, upper_right, corner_radius,
+                                  n_segments, color, alpha);
+    writeFanElements(cursor.elements, cursor.first_vertex, n_segments + 4);
+}
+
+} // namespace sini
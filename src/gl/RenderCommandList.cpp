@@ -0,0 +1,223 @@
+#include <sini2D/gl/RenderCommandList.hpp>
+
+#include <sini2D/geometry/Polygon.hpp>
+
+#include <algorithm>    // For std::max
+#include <cmath>        // For std::abs
+
+
+namespace sini {
+
+// Member functions
+// -----------------------------------------------------------------------------
+void RenderCommandList::drawPolygon(Polygon& polygon, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f || polygon.vertices.size() < 3)
+        return;
+
+    const size_t n = polygon.vertices.size();
+    writePolygonOutline(reserve(false, n, 2*n, alpha < 1.0f), polygon, color, alpha);
+}
+
+void RenderCommandList::drawPolygonTriangleMesh(Polygon& polygon, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f || polygon.vertices.size() < 3)
+        return;
+
+    if (!polygon.triangle_mesh)
+        polygon.buildTriangleMesh();
+
+    writePolygonTriangleMesh(reserve(false, polygon.vertices.size(),
+        6*polygon.triangle_mesh->size(), alpha < 1.0f), polygon, color, alpha);
+}
+
+void RenderCommandList::fillPolygon(Polygon& polygon, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f || polygon.vertices.size() < 3)
+        return;
+
+    if (!polygon.triangle_mesh)
+        polygon.buildTriangleMesh();
+
+    writeFilledPolygon(reserve(true, polygon.vertices.size(),
+        3*polygon.triangle_mesh->size(), alpha < 1.0f), polygon, color, alpha);
+}
+
+void RenderCommandList::drawRectangle(vec2 bottom_left, vec2 upper_right, vec3 color,
+                                      float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    writeRectangleOutline(reserve(false, 4, 8, alpha < 1.0f), bottom_left, upper_right,
+        color, alpha);
+}
+
+void RenderCommandList::fillRectangle(vec2 bottom_left, vec2 upper_right, vec3 color,
+                                      float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    writeFilledRectangle(reserve(true, 4, 6, alpha < 1.0f), bottom_left, upper_right,
+        color, alpha);
+}
+
+void RenderCommandList::drawCircle(vec2 center, float radius, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(radius, pixels_per_unit);
+    writeEllipseOutline(reserve(false, n, 2*n, alpha < 1.0f), center,
+        vec2(radius, radius), n, color, alpha);
+}
+
+void RenderCommandList::fillCircle(vec2 center, float radius, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(radius, pixels_per_unit);
+    writeFilledEllipse(reserve(true, n, 3*(n-2), alpha < 1.0f), center,
+        vec2(radius, radius), n, color, alpha);
+}
+
+void RenderCommandList::drawShape(Shape shape, const mat3& model_to_world, vec3 color,
+                                  float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const size_t n = numShapeVertices(shape);
+    writeShapeOutline(reserve(false, n, 2*n, alpha < 1.0f), shape, model_to_world,
+        color, alpha);
+}
+
+void RenderCommandList::fillShape(Shape shape, const mat3& model_to_world, vec3 color,
+                                  float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    writeFilledShape(reserve(true, numShapeVertices(shape), numFilledShapeElements(shape),
+        alpha < 1.0f), shape, model_to_world, color, alpha);
+}
+
+void RenderCommandList::drawEllipse(vec2 center, vec2 radii, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(std::max(std::abs(radii.x), std::abs(radii.y)),
+                                pixels_per_unit);
+    writeEllipseOutline(reserve(false, n, 2*n, alpha < 1.0f), center, radii, n,
+        color, alpha);
+}
+
+void RenderCommandList::fillEllipse(vec2 center, vec2 radii, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(std::max(std::abs(radii.x), std::abs(radii.y)),
+                                pixels_per_unit);
+    writeFilledEllipse(reserve(true, n, 3*(n-2), alpha < 1.0f), center, radii, n,
+        color, alpha);
+}
+
+void RenderCommandList::drawArc(vec2 center, float radius, float start_angle, float sweep,
+                                vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(radius, pixels_per_unit);
+    const size_t m = numArcSegments(sweep, n);
+    writeArc(reserve(false, m+1, 2*m, alpha < 1.0f), center, radius, start_angle, sweep,
+        n, color, alpha);
+}
+
+void RenderCommandList::fillArc(vec2 center, float radius, float start_angle, float sweep,
+                                vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(radius, pixels_per_unit);
+    const size_t m = numArcSegments(sweep, n);
+    writeFilledArc(reserve(true, m+2, 3*m, alpha < 1.0f), center, radius, start_angle,
+        sweep, n, color, alpha);
+}
+
+void RenderCommandList::drawRoundedRectangle(vec2 bottom_left, vec2 upper_right,
+                                             float corner_radius, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(
+        roundedCornerRadius(bottom_left, upper_right, corner_radius), pixels_per_unit);
+    writeRoundedRectangleOutline(reserve(false, n+4, 2*(n+4), alpha < 1.0f), bottom_left,
+        upper_right, corner_radius, n, color, alpha);
+}
+
+void RenderCommandList::fillRoundedRectangle(vec2 bottom_left, vec2 upper_right,
+                                             float corner_radius, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(
+        roundedCornerRadius(bottom_left, upper_right, corner_radius), pixels_per_unit);
+    writeFilledRoundedRectangle(reserve(true, n+4, 3*(n+2), alpha < 1.0f), bottom_left,
+        upper_right, corner_radius, n, color, alpha);
+}
+
+VertexCursor RenderCommandList::reserveTriangles(size_t n_new_vertices,
+                                                 size_t n_new_elements)
+{
+    // The caller may write any alpha
+    return reserve(true, n_new_vertices, n_new_elements, true);
+}
+
+VertexCursor RenderCommandList::reserveLines(size_t n_new_vertices, size_t n_new_elements)
+{
+    return reserve(false, n_new_vertices, n_new_elements, true);
+}
+
+void RenderCommandList::clear() noexcept
+{
+    batches.clear();
+    n_vertices = 0;
+    n_elements = 0;
+}
+
+
+// Private member functions
+// -----------------------------------------------------------------------------
+VertexCursor RenderCommandList::reserve(bool triangles, size_t n_new_vertices,
+                                        size_t n_new_elements, bool translucent)
+{
+    if (batches.empty() || batches.back().triangles != triangles)
+        batches.push_back(Batch{ triangles, false, n_vertices, 0, n_elements, 0 });
+    Batch& batch = batches.back();
+    if (translucent) batch.translucent = true;
+
+    // Elements are relative to the batch, and offset when submitted
+    const GLuint first_batch_vertex = static_cast<GLuint>(batch.n_vertices);
+    const size_t first_vertex = n_vertices,
+                 first_element = n_elements;
+    n_vertices += n_new_vertices;
+    n_elements += n_new_elements;
+    batch.n_vertices += n_new_vertices;
+    batch.n_elements += n_new_elements;
+    if (n_vertices > vertices.size())
+        vertices.resize(std::max(2*vertices.size(), std::max(n_vertices, size_t(1024))));
+    if (n_elements > elements.size())
+        elements.resize(std::max(2*elements.size(), std::max(n_elements, size_t(1024))));
+    return VertexCursor{ vertices.data() + first_vertex, elements.data() + first_element,
+                         first_batch_vertex };
+}
+
+} // namespace sini
@@ -0,0 +1,113 @@
+#include <sini2D/gl/ShaderProgram.hpp>
+
+#include <sini2D/gl/glutil.hpp>
+#include <sini2D/gl/OpenGlException.hpp>
+
+#include <algorithm>    // For std::equal, std::copy
+#include <cstring>      // For std::strcmp
+
+
+namespace sini {
+
+ShaderProgram::ShaderProgram(const char* vertex_shader_src,
+                             const char* geometry_shader_src,
+                             const char* fragment_shader_src)
+{
+    std::string error_msg;
+    program = loadShaderProgram(vertex_shader_src, geometry_shader_src,
+        fragment_shader_src, nullptr, &error_msg);
+    if (program == 0) {
+        throw OpenGlException(error_msg.empty() ? "Shader program could not load"
+            : "Shader program could not load: " + error_msg);
+    }
+
+    // Resolve all uniform locations up front, rather than calling
+    // glGetUniformLocation for every upload
+    GLint n_uniforms = 0, max_name_length = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &n_uniforms);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+    std::vector<char> name(std::max(max_name_length, 1));
+    uniforms.reserve(n_uniforms);
+    for (GLint i = 0; i < n_uniforms; ++i) {
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(program, static_cast<GLuint>(i), max_name_length, nullptr,
+            &size, &type, name.data());
+        Uniform uniform;
+        uniform.name = name.data();
+        uniform.location = glGetUniformLocation(program, name.data());
+        // Uniforms in uniform blocks have no location
+        if (uniform.location != -1)
+            uniforms.push_back(std::move(uniform));
+    }
+}
+
+ShaderProgram::~ShaderProgram()
+{
+    glDeleteProgram(program);
+}
+
+
+// Member functions
+// -----------------------------------------------------------------------------
+GLint ShaderProgram::uniformLocation(const char* name) const noexcept
+{
+    for (const Uniform& uniform : uniforms)
+        if (std::strcmp(uniform.name.c_str(), name) == 0)
+            return uniform.location;
+    return -1;
+}
+
+bool ShaderProgram::setUniform(GLint location, float value) noexcept
+{
+    if (!updateCachedValue(location, &value, 1))
+        return false;
+    glProgramUniform1f(program, location, value);
+    return true;
+}
+
+bool ShaderProgram::setUniform(GLint location, const vec4& value) noexcept
+{
+    if (!updateCachedValue(location, value.data(), 4))
+        return false;
+    glProgramUniform4fv(program, location, 1, value.data());
+    return true;
+}
+
+bool ShaderProgram::setUniform(GLint location, const mat2& value) noexcept
+{
+    if (!updateCachedValue(location, value.data(), 4))
+        return false;
+    // GL_TRUE (transpose) since OpenGL expects matrices in column-major order
+    glProgramUniformMatrix2fv(program, location, 1, GL_TRUE, value.data());
+    return true;
+}
+
+bool ShaderProgram::setUniform(GLint location, const mat3& value) noexcept
+{
+    if (!updateCachedValue(location, value.data(), 9))
+        return false;
+    glProgramUniformMatrix3fv(program, location, 1, GL_TRUE, value.data());
+    return true;
+}
+
+
+// Private member functions
+// -----------------------------------------------------------------------------
+bool ShaderProgram::updateCachedValue(GLint location, const float* value,
+                                      size_t size) noexcept
+{
+    // Programs have a handful of uniforms, so a linear search is fine
+    for (Uniform& uniform : uniforms) {
+        if (uniform.location != location)
+            continue;
+        if (uniform.uploaded && std::equal(value, value + size, uniform.value.begin()))
+            return false;
+        std::copy(value, value + size, uniform.value.begin());
+        uniform.uploaded = true;
+        return true;
+    }
+    return false;
+}
+
+} // namespace sini
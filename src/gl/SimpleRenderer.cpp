@@ -1,109 +1,319 @@
 #include <sini2D/gl/SimpleRenderer.hpp>
 
 #include <sini2D/geometry/Polygon.hpp>
-#include <sini2D/gl/glutil.hpp>
 #include <sini2D/gl/OpenGlException.hpp>
 #include <sini2D/sdl/Window.hpp>
+#include <sini2D/util/Profiler.hpp>
 
+#include <algorithm>    // For std::min, std::max, std::copy_n
 #include <array>
+#include <chrono>
+#include <cmath>        // For std::abs
+#include <cstddef>      // For offsetof
 #include <vector>
 
 
 namespace sini {
 
-// Simple vertex and fragment shader source
+// Simple vertex and fragment shader source. Alpha is applied by hardware
+// blending.
 // -----------------------------------------------------------------------------
 static const char* simple_vertex_shader_src = R"glsl(
     #version 420 core
     precision highp float;
 
-    uniform mat2 model_to_world_transf;
+    uniform mat3 model_to_world_transf;
     uniform mat3 world_to_cam_transf;
 
     layout(location = 0) in vec2 position;
-    layout(location = 1) in vec3 in_color;
-    out vec2 texcoord;
-    out vec3 color;
+    layout(location = 1) in vec4 in_color;
+    out vec4 color;
 
     void main() {
         color = in_color;
-        vec3 camview_pos = world_to_cam_transf * vec3(model_to_world_transf
-            * position, 1.0f);
-        texcoord = 0.5f * (camview_pos.xy + vec2(1.0f));
+        vec3 camview_pos = world_to_cam_transf * model_to_world_transf
+            * vec3(position, 1.0f);
         gl_Position = vec4(camview_pos.xy, 0.0f, 1.0f);
     }
 )glsl";
-// TODO simple geometry shader
-static const char* simple_geometry_shader_src = nullptr;
 static const char* simple_fragment_shader_src = R"glsl(
     #version 420 core
     precision highp float;
 
-    uniform float alpha;
-    uniform sampler2D backbuffer;
-
-    in vec2 texcoord;
-    in vec3 color;
+    in vec4 color;
     layout(location = 0) out vec4 fragment_color;
 
     void main() {
-        fragment_color = mix(
-            vec4(color, 1.0f), texture(backbuffer, texcoord), 1.0f - alpha);
+        fragment_color = color;
     }
 )glsl";
-// Shader for drawing the framebuffer on the screen
+// Shader for instanced shapes, i.e. a unit shape mesh with an affine transform
+// per instance. Alpha is applied by hardware blending.
 // -----------------------------------------------------------------------------
-static const char* screen_vertex_shader_src = R"glsl(
+static const char* instance_vertex_shader_src = R"glsl(
     #version 420 core
     precision highp float;
 
+    uniform mat3 world_to_cam_transf;
+
     layout(location = 0) in vec2 position;
-    layout(location = 1) in vec2 texture_coord;
-    out vec2 texcoord;
+    layout(location = 2) in vec2 instance_offset;
+    layout(location = 3) in vec2 instance_axis_x;
+    layout(location = 4) in vec2 instance_axis_y;
+    layout(location = 5) in vec4 instance_color;
+    out vec4 color;
 
     void main() {
-        gl_Position = vec4(position, 0.0f, 1.0f);
-        texcoord = texture_coord;
+        color = instance_color;
+        vec3 camview_pos = world_to_cam_transf
+            * vec3(instance_offset + position.x * instance_axis_x
+                   + position.y * instance_axis_y, 1.0f);
+        gl_Position = vec4(camview_pos.xy, 0.0f, 1.0f);
     }
 )glsl";
-static const char* screen_fragment_shader_src = R"glsl(
+static const char* instance_fragment_shader_src = R"glsl(
     #version 420 core
     precision highp float;
 
-    uniform sampler2D framebuffer;
-    in vec2 texcoord;
+    in vec4 color;
     layout(location = 0) out vec4 fragment_color;
 
     void main() {
-        fragment_color = texture(framebuffer, texcoord);
+        fragment_color = color;
     }
 )glsl";
+// Shader for SDF shapes: rounded boxes (which circles and capsules are too),
+// evaluated per fragment on a quad half a pixel larger than the shape on
+// every side. The coverage of the pixel is estimated from the distance to the
+// edge. Always blended.
+// -----------------------------------------------------------------------------
+static const char* sdf_vertex_shader_src = R"glsl(
+    #version 420 core
+    precision highp float;
 
+    uniform mat3 world_to_cam_transf;
+    uniform float pixel_size;   // In world units
+
+    layout(location = 0) in vec2 center;
+    layout(location = 1) in vec2 axis;
+    layout(location = 2) in vec2 half_extents;
+    layout(location = 3) in vec2 radius_and_width;
+    layout(location = 4) in vec4 instance_color;
+    out vec2 local_position;
+    flat out vec2 box_half_extents;
+    flat out float corner_radius;
+    flat out float line_width;
+    flat out vec4 color;
 
-// Helper functions
+    void main() {
+        // Triangle strip (-1,-1), (1,-1), (-1,1), (1,1)
+        vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0f - 1.0f;
+        local_position = corner * (half_extents + pixel_size);
+        box_half_extents = half_extents;
+        corner_radius = radius_and_width.x;
+        line_width = radius_and_width.y;
+        color = instance_color;
+        vec2 world_pos = center + local_position.x * axis
+                         + local_position.y * vec2(-axis.y, axis.x);
+        vec3 camview_pos = world_to_cam_transf * vec3(world_pos, 1.0f);
+        gl_Position = vec4(camview_pos.xy, 0.0f, 1.0f);
+    }
+)glsl";
+static const char* sdf_fragment_shader_src = R"glsl(
+    #version 420 core
+    precision highp float;
+
+    uniform float pixel_size;
+
+    in vec2 local_position;
+    flat in vec2 box_half_extents;
+    flat in float corner_radius;
+    flat in float line_width;
+    flat in vec4 color;
+    layout(location = 0) out vec4 fragment_color;
+
+    void main() {
+        vec2 q = abs(local_position) - box_half_extents + corner_radius;
+        float distance = length(max(q, 0.0f)) + min(max(q.x, q.y), 0.0f) - corner_radius;
+        if (line_width > 0.0f)
+            distance = abs(distance + 0.5f * line_width) - 0.5f * line_width;
+        float coverage = clamp(0.5f - distance / pixel_size, 0.0f, 1.0f);
+        if (coverage <= 0.0f)
+            discard;
+        fragment_color = vec4(color.rgb, color.a * coverage);
+    }
+)glsl";
+// Shader for thick polylines, with a segment per instance. The vertex shader
+// expands the segment to a quad, which is either cut at the miter lines shared
+// with the neighboring segments or extended past the end points for caps and
+// round joins. A miter join past the miter limit is beveled instead: the
+// outer edge keeps its full width up to the bevel line, so each end has an
+// extra corner between the edge and the miter line. The fragment shader cuts
+// off the caps, round joins and bevels by their distance, antialiased like
+// the SDF shapes. Always blended.
 // -----------------------------------------------------------------------------
-namespace {
+static const char* polyline_vertex_shader_src = R"glsl(
+    #version 420 core
+    precision highp float;
 
-std::array<vec2,4> setupRectangleVertices(vec2 bottom_left, vec2 upper_right) noexcept
-{
-    std::array<vec2, 4> vertices;
-    vertices[0] = bottom_left;
-    vertices[1] = { upper_right.x, bottom_left.y };
-    vertices[2] = upper_right;
-    vertices[3] = { bottom_left.x, upper_right.y };
+    uniform mat3 world_to_cam_transf;
+    uniform float pixel_size;   // In world units
+    // Half width, miter limit, round joins (1) or miters (0), and cap (0 butt,
+    // 1 square, 2 round)
+    uniform vec4 line_style;
+    // Of an open polyline, or -1 if closed
+    uniform float last_segment;
+
+    layout(location = 0) in vec2 prev;
+    layout(location = 1) in vec2 a;
+    layout(location = 2) in vec2 b;
+    layout(location = 3) in vec2 next;
+    out vec2 local_position;    // Along and across the segment, from a
+    flat out float segment_length;
+    // How the line ends at a and b: 0 at miter joins, 1 flat at the end point,
+    // 2 flat half a width past it, 3 round, 4 beveled
+    flat out vec2 end_kinds;
+    // Bevel lines at a and b, as their outward normal and offset in the
+    // coordinates of 'local_position'
+    flat out vec3 bevel_a;
+    flat out vec3 bevel_b;
+
+    // Miter line of a join from the unit direction 'incoming' to 'outgoing',
+    // as a unit vector to the left of both and the cosine of half the turn.
+    // Both joined segments compute it alike, so that they share the line.
+    vec3 miterLine(vec2 incoming, vec2 outgoing) {
+        vec2 sum = vec2(-incoming.y, incoming.x) + vec2(-outgoing.y, outgoing.x);
+        float cos_half_turn = 0.5f * length(sum);
+        return vec3(cos_half_turn > 1e-6f ? sum / length(sum) : incoming, cos_half_turn);
+    }
 
-    return vertices;
-}
+    float joinKind(vec3 join) {
+        if (line_style.z > 0.5f)
+            return 3.0f;
+        return join.z * line_style.y < 1.0f ? 4.0f : 0.0f;
+    }
+
+    // 'out_dir' points away from the segment at the end point 'along'
+    vec3 bevelLine(vec3 join, vec2 out_dir, float along, vec2 dir, vec2 normal) {
+        vec2 miter = dot(join.xy, out_dir) < 0.0f ? -join.xy : join.xy;
+        vec2 local_miter = vec2(dot(miter, dir), dot(miter, normal));
+        return vec3(local_miter, along * local_miter.x + line_style.x * join.z);
+    }
+
+    void main() {
+        float half_width = line_style.x;
+        vec2 ab = b - a;
+        segment_length = length(ab);
+        vec2 dir = segment_length > 0.0f ? ab / segment_length : vec2(1.0f, 0.0f);
+        vec2 normal = vec2(-dir.y, dir.x);
+        float prev_length = length(a - prev),
+              next_length = length(next - b);
+        vec3 join_a = miterLine(prev_length > 0.0f ? (a - prev) / prev_length : dir, dir),
+             join_b = miterLine(dir, next_length > 0.0f ? (next - b) / next_length : dir);
+
+        float cap_kind = 1.0f + line_style.w;
+        bool open = last_segment >= 0.0f;
+        end_kinds = vec2(open && gl_InstanceID == 0 ? cap_kind : joinKind(join_a),
+                         open && float(gl_InstanceID) == last_segment ? cap_kind
+                                                                      : joinKind(join_b));
+        bevel_a = bevelLine(join_a, -dir, 0.0f, dir, normal);
+        bevel_b = bevelLine(join_b, dir, segment_length, dir, normal);
+
+        // Triangle strip with the corners at a before those at b. Each end has
+        // a corner on the miter line and one on the edge, farther from the
+        // end point, which are the same unless beveled.
+        int end = gl_VertexID >> 2,
+            pair = gl_VertexID >> 1;
+        float side = (gl_VertexID & 1) == 0 ? -1.0f : 1.0f;
+        bool on_edge = pair == 1 || pair == 2;
+        vec2 point = end == 0 ? a : b,
+             out_dir = end == 0 ? -dir : dir;
+        float kind = end == 0 ? end_kinds.x : end_kinds.y;
+        // Half a pixel of margin for antialiasing
+        float extent = half_width + pixel_size;
+        vec2 position;
+        if (kind == 0.0f || kind == 4.0f) {
+            vec3 join = end == 0 ? join_a : join_b;
+            vec2 miter = side * join.xy;
+            float cos_half_turn = join.z,
+                  outwards = dot(miter, out_dir);
+            if (kind == 4.0f && outwards > 0.0f) {
+                position = on_edge
+                    ? point + side * extent * normal
+                      + pixel_size * (1.0f - cos_half_turn) / max(outwards, 1e-6f) * out_dir
+                    : point + (half_width * cos_half_turn + pixel_size) * miter;
+            }
+            else {
+                float miter_extent = extent / max(cos_half_turn, 1e-3f);
+                // An inner corner is kept within half of the shorter segment,
+                // so that the quad doesn't fold over at sharp turns
+                if (outwards < 0.0f) {
+                    float sin_half_turn = sqrt(max(1.0f - cos_half_turn * cos_half_turn, 0.0f)),
+                          other_length = end == 0 ? prev_length : next_length;
+                    miter_extent = min(miter_extent, 0.5f * min(segment_length, other_length)
+                                                     / max(sin_half_turn, 1e-6f));
+                }
+                position = point + miter_extent * miter;
+            }
+        }
+        else {
+            float extension = kind == 1.0f ? pixel_size : extent;
+            position = point + side * extent * normal + extension * out_dir;
+        }
+        local_position = vec2(dot(position - a, dir), dot(position - a, normal));
+        vec3 camview_pos = world_to_cam_transf * vec3(position, 1.0f);
+        gl_Position = vec4(camview_pos.xy, 0.0f, 1.0f);
+    }
+)glsl";
+static const char* polyline_fragment_shader_src = R"glsl(
+    #version 420 core
+    precision highp float;
+
+    uniform float pixel_size;
+    uniform vec4 line_style;
+    uniform vec4 line_color;
+
+    in vec2 local_position;
+    flat in float segment_length;
+    flat in vec2 end_kinds;
+    flat in vec3 bevel_a;
+    flat in vec3 bevel_b;
+    layout(location = 0) out vec4 fragment_color;
+
+    // Distance to the line, 'beyond' the end point of the given kind
+    float endDistance(float kind, vec3 bevel, float beyond, float across, float distance) {
+        float half_width = line_style.x;
+        if (kind == 4.0f)
+            return max(distance, dot(local_position, bevel.xy) - bevel.z);
+        else if (kind == 0.0f || beyond <= 0.0f)
+            return distance;
+        else if (kind == 3.0f)
+            return length(vec2(beyond, across)) - half_width;
+        return max(distance, kind == 2.0f ? beyond - half_width : beyond);
+    }
+
+    void main() {
+        float along = local_position.x,
+              across = local_position.y;
+        float distance = abs(across) - line_style.x;
+        distance = endDistance(end_kinds.x, bevel_a, -along, across, distance);
+        distance = endDistance(end_kinds.y, bevel_b, along - segment_length, across, distance);
+        float coverage = clamp(0.5f - distance / pixel_size, 0.0f, 1.0f);
+        if (coverage <= 0.0f)
+            discard;
+        fragment_color = vec4(line_color.rgb, line_color.a * coverage);
+    }
+)glsl";
+
+
+// Helper functions
+// -----------------------------------------------------------------------------
+namespace {
 
-Polygon* createCirclePolygon()
+uint8_t toUnorm8(float value) noexcept
 {
-    std::vector<vec2> vertices;
-    constexpr int n_vertices = 64;
-    vertices.reserve(n_vertices);
-    constexpr float two_pi = 2.0f * 3.1415926535f;
-    for (float angle = 0.0f; angle < two_pi; angle += two_pi / n_vertices)
-        vertices.push_back({ std::cos(angle), std::sin(angle) });
-    return new Polygon(std::move(vertices));
+    value = std::min(std::max(value, 0.0f), 1.0f);
+    return static_cast<uint8_t>(value * 255.0f + 0.5f);
 }
 
 size_t sizeGrowthFunction(size_t current_size, size_t target_minimum_size) noexcept
@@ -114,31 +324,73 @@ size_t sizeGrowthFunction(size_t current_size, size_t target_minimum_size) noexc
     return new_size;
 }
 
+double millisecondsSince(std::chrono::steady_clock::time_point start) noexcept
+{
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// Adds the time until it goes out of scope to 'milliseconds'
+class CpuTimerScope {
+public:
+    explicit CpuTimerScope(double& milliseconds) noexcept
+        : milliseconds(milliseconds), start(std::chrono::steady_clock::now())
+    {}
+    ~CpuTimerScope() { milliseconds += millisecondsSince(start); }
+private:
+    double& milliseconds;
+    const std::chrono::steady_clock::time_point start;
+};
+
 } // anonymous namespace
 
 
 // Constructors and destructor
 // -----------------------------------------------------------------------------
 SimpleRenderer::SimpleRenderer(const Window& window, Camera camera)
+    : SimpleRenderer(window, camera, RenderSettings())
+{}
+
+SimpleRenderer::SimpleRenderer(const Window& window, Camera camera,
+                               RenderSettings settings)
+    : SimpleRenderer(&window, window.dimensions(), camera, settings)
+{}
+
+#ifdef SINI_HEADLESS
+SimpleRenderer::SimpleRenderer(vec2i dimensions, Camera camera, RenderSettings settings)
+    : SimpleRenderer(nullptr, dimensions, camera, settings)
+{}
+#endif
+
+SimpleRenderer::SimpleRenderer(const Window* window, vec2i dimensions, Camera camera,
+                               RenderSettings settings)
     : camera(camera),
-      window(&window),
-      context(window.win_ptr, 4, 2, GLProfile::CORE)
+      window(window),
+      framebuffer_dimensions(dimensions),
+      context(window != nullptr
+              ? std::make_unique<GLContext>(window->win_ptr, 4, 2, GLProfile::CORE)
+              : nullptr),
+#ifdef SINI_HEADLESS
+      headless_context(window == nullptr
+                       ? std::make_unique<HeadlessContext>(4, 2)
+                       : nullptr),
+#endif
+      settings(settings)
 {
     glewInit();
-    shader_program = loadShaderProgram(simple_vertex_shader_src,
-        simple_geometry_shader_src, simple_fragment_shader_src);
-    screen_shader = loadShaderProgram(screen_vertex_shader_src,
-        nullptr, screen_fragment_shader_src);
-
-    // TODO Include error message in exception
-    if (shader_program == 0)
-        throw OpenGlException("Simple shader program could not load");
-
-    if (screen_shader == 0)
-        throw OpenGlException("Screen shader program could not load");
+    shader_program = std::make_unique<ShaderProgram>(simple_vertex_shader_src, nullptr,
+        simple_fragment_shader_src);
+    model_to_world_loc = shader_program->uniformLocation("model_to_world_transf");
+    world_to_cam_loc = shader_program->uniformLocation("world_to_cam_transf");
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     setupInternalVertexObjects();
     setupInternalFramebuffer();
+    if (settings.instanced_shapes)
+        setupShapeMeshes();
+    // The setup above binds objects without going through the state cache
+    gl_state.invalidate();
+    frame_start_time = std::chrono::steady_clock::now();
 }
 
 SimpleRenderer::SimpleRenderer(const Window& window)
@@ -147,24 +399,22 @@ SimpleRenderer::SimpleRenderer(const Window& window)
 
 SimpleRenderer::~SimpleRenderer()
 {
-    if (circle_polygon)
-        delete circle_polygon;
-
-    glDeleteProgram(shader_program);
-    glDeleteProgram(screen_shader);
-
-    glDeleteTextures(1, &backbuffer_texture);
     glDeleteTextures(1, &framebuffer_texture);
-
-    glDeleteFramebuffers(1, &backbuffer);
     glDeleteFramebuffers(1, &framebuffer);
 
-    glDeleteBuffers(1, &quad_vertex_buffer);
-    glDeleteVertexArrays(1, &quad_vertex_array);
-
     glDeleteBuffers(1, &element_buffer);
     glDeleteBuffers(1, &vertex_buffer);
     glDeleteVertexArrays(1, &vertex_array);
+
+    glDeleteBuffers(1, &instance_buffer);
+    glDeleteBuffers(1, &shape_element_buffer);
+    glDeleteBuffers(1, &shape_vertex_buffer);
+    glDeleteVertexArrays(1, &shape_vertex_array);
+
+    glDeleteBuffers(1, &sdf_instance_buffer);
+    glDeleteVertexArrays(1, &sdf_vertex_array);
+
+    glDeleteVertexArrays(1, &polyline_vertex_array);
 }
 
 
@@ -172,248 +422,855 @@ SimpleRenderer::~SimpleRenderer()
 // -----------------------------------------------------------------------------
 void SimpleRenderer::clear(vec4 clear_color) noexcept
 {
-    vec2i dim = window->dimensions();
+    CpuTimerScope cpu_timer{ frame_stats.cpu_submit_ms };
+    const vec2i dim = framebuffer_dimensions;
 
-    glBindFramebuffer(GL_FRAMEBUFFER, backbuffer);
-    glViewport(0, 0, dim.x, dim.y);
-    glClearColor(clear_color[0], clear_color[1], clear_color[2], clear_color[3]);
-    glDisable(GL_DEPTH_TEST);
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    gl_state.bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
     glViewport(0, 0, dim.x, dim.y);
     glClearColor(clear_color[0], clear_color[1], clear_color[2], clear_color[3]);
     glDisable(GL_DEPTH_TEST);
+    GpuTimer::Scope gpu_timer_scope{ gpu_timer.get(), GpuTimer::DRAW };
     glClear(GL_COLOR_BUFFER_BIT);
+    gl_state.countCalls(4);
 }
 
-void SimpleRenderer::drawPolygon(Polygon& polygon, vec3 color, float alpha) noexcept
+void SimpleRenderer::drawPolygon(Polygon& polygon, vec3 color, float alpha)
 {
     if (alpha <= 0.0f || polygon.vertices.size() < 3)
         return;
-    else if (alpha < 1.0f
-             || render_style != DRAW)
-    {
-        flushRenderQueue(render_style);
-        render_style = DRAW;
-    }
 
-    const size_t initial_queue_data_size = queued_vertex_data.size();
+    const size_t n_vertices = polygon.vertices.size();
+    writePolygonOutline(reserve(DRAW, n_vertices, 2*n_vertices, alpha < 1.0f),
+        polygon, color, alpha);
+}
 
-    for (vec2 vertex : polygon.vertices)
-        queued_vertex_data.push_back(
-            Vector<float, 5>({ vertex.x, vertex.y, color[0], color[1], color[2] }));
+void SimpleRenderer::fillPolygon(Polygon& polygon, vec3 color, float alpha)
+{
+    SINI_PROFILE_SCOPE("SimpleRenderer::fillPolygon");
+    if (alpha <= 0.0f || polygon.vertices.size() < 3)
+        return;
 
-    for (size_t i = 0; i < polygon.vertices.size()-1; ++i) {
-        queued_elements.push_back(static_cast<GLuint>(i + initial_queue_data_size));
-        queued_elements.push_back(static_cast<GLuint>(i+1 + initial_queue_data_size));
-    }
-    queued_elements.push_back(static_cast<GLuint>(polygon.vertices.size()-1
-                                                  + initial_queue_data_size));
-    queued_elements.push_back(static_cast<GLuint>(0 + initial_queue_data_size));
+    if (!polygon.triangle_mesh)
+        polygon.buildTriangleMesh();
 
-    if (alpha < 1.0f)
-        flushRenderQueue(render_style, alpha);
+    writeFilledPolygon(reserve(FILL, polygon.vertices.size(),
+        3*polygon.triangle_mesh->size(), alpha < 1.0f), polygon, color, alpha);
 }
 
-void SimpleRenderer::fillPolygon(Polygon& polygon, vec3 color, float alpha)
+void SimpleRenderer::drawPolygonTriangleMesh(Polygon& polygon, vec3 color, float alpha)
 {
     if (alpha <= 0.0f || polygon.vertices.size() < 3)
         return;
-    else if (alpha < 1.0f
-             || render_style != FILL)
-    {
-        flushRenderQueue(render_style);
-        render_style = FILL;
-    }
-
-    const size_t initial_queue_data_size = queued_vertex_data.size();
-    // no reserve, since it causes queued_vertex_data and queued_elements to grow linearly
-    // instead of exponentially
-    for (vec2 vertex : polygon.vertices)
-        queued_vertex_data.push_back(
-            Vector<float, 5>({ vertex.x, vertex.y, color[0], color[1], color[2] }));
 
     if (!polygon.triangle_mesh)
         polygon.buildTriangleMesh();
 
-    for (vec3i index_triplet : *polygon.triangle_mesh)
-        for (int idx : index_triplet)
-            queued_elements.push_back(static_cast<GLuint>(idx + initial_queue_data_size));
+    writePolygonTriangleMesh(reserve(DRAW, polygon.vertices.size(),
+        6*polygon.triangle_mesh->size(), alpha < 1.0f), polygon, color, alpha);
+}
 
-    if (alpha < 1.0f)
-        flushRenderQueue(render_style, alpha);
+void SimpleRenderer::drawRectangle(vec2 bottom_left, vec2 upper_right, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+    else if (settings.instanced_shapes) {
+        queueShapeInstance(RECTANGLE_OUTLINES, bottom_left,
+            vec2(upper_right.x - bottom_left.x, 0.0f),
+            vec2(0.0f, upper_right.y - bottom_left.y), color, alpha);
+        return;
+    }
+
+    writeRectangleOutline(reserve(DRAW, 4, 8, alpha < 1.0f), bottom_left, upper_right,
+        color, alpha);
 }
 
-void SimpleRenderer::drawPolygonTriangleMesh(Polygon& polygon, vec3 color, float alpha)
+void SimpleRenderer::fillRectangle(vec2 bottom_left, vec2 upper_right, vec3 color, float alpha)
 {
-    if (alpha <= 0.0f || polygon.vertices.size() < 3)
+    if (alpha <= 0.0f)
+        return;
+    else if (settings.instanced_shapes) {
+        queueShapeInstance(FILLED_RECTANGLES, bottom_left,
+            vec2(upper_right.x - bottom_left.x, 0.0f),
+            vec2(0.0f, upper_right.y - bottom_left.y), color, alpha);
         return;
-    else if (alpha < 1.0f
-             || render_style != DRAW)
-    {
-        flushRenderQueue(render_style);
-        render_style = DRAW;
     }
 
-    const size_t initial_queue_data_size = queued_vertex_data.size();
+    writeFilledRectangle(reserve(FILL, 4, 6, alpha < 1.0f), bottom_left, upper_right,
+        color, alpha);
+}
 
-    for (vec2 vertex : polygon.vertices)
-        queued_vertex_data.push_back(
-            Vector<float, 5>({ vertex.x, vertex.y, color[0], color[1], color[2] }));
+void SimpleRenderer::drawCircle(vec2 center, float radius, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+    else if (settings.instanced_shapes) {
+        queueShapeInstance(CIRCLE_OUTLINES, center, vec2(radius, 0.0f),
+                           vec2(0.0f, radius), color, alpha);
+        return;
+    }
 
-    if (!polygon.triangle_mesh)
-        polygon.buildTriangleMesh();
+    const int n = curveSegments(radius, pixelsPerUnit());
+    writeEllipseOutline(reserve(DRAW, n, 2*n, alpha < 1.0f), center,
+        vec2(radius, radius), n, color, alpha);
+}
 
-    for (vec3i vertex : *polygon.triangle_mesh) {
-        queued_elements.push_back(static_cast<GLuint>(vertex.x + initial_queue_data_size));
-        queued_elements.push_back(static_cast<GLuint>(vertex.y + initial_queue_data_size));
-        queued_elements.push_back(static_cast<GLuint>(vertex.y + initial_queue_data_size));
-        queued_elements.push_back(static_cast<GLuint>(vertex.z + initial_queue_data_size));
-        queued_elements.push_back(static_cast<GLuint>(vertex.z + initial_queue_data_size));
-        queued_elements.push_back(static_cast<GLuint>(vertex.x + initial_queue_data_size));
+void SimpleRenderer::fillCircle(vec2 center, float radius, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+    else if (settings.instanced_shapes) {
+        queueShapeInstance(FILLED_CIRCLES, center, vec2(radius, 0.0f),
+                           vec2(0.0f, radius), color, alpha);
+        return;
     }
 
-    if (alpha < 1.0f)
-        flushRenderQueue(render_style, alpha);
+    const int n = curveSegments(radius, pixelsPerUnit());
+    writeFilledEllipse(reserve(FILL, n, 3*(n-2), alpha < 1.0f), center,
+        vec2(radius, radius), n, color, alpha);
 }
 
-void SimpleRenderer::drawRectangle(vec2 bottom_left, vec2 upper_right, vec3 color, float alpha)
+void SimpleRenderer::drawShape(Shape shape, const mat3& model_to_world, vec3 color,
+                               float alpha)
 {
     if (alpha <= 0.0f)
         return;
-    else if (alpha < 1.0f
-             || render_style != DRAW)
-    {
-        flushRenderQueue(render_style);
-        render_style = DRAW;
+    else if (settings.instanced_shapes) {
+        const vec2 axis_x{ model_to_world.e00, model_to_world.e10 },
+                   axis_y{ model_to_world.e01, model_to_world.e11 },
+                   translation{ model_to_world.e02, model_to_world.e12 };
+        // The instanced unit square is [0,1]x[0,1] rather than centered
+        if (shape == Shape::SQUARE)
+            queueShapeInstance(RECTANGLE_OUTLINES, translation - 0.5f*(axis_x + axis_y),
+                               axis_x, axis_y, color, alpha);
+        else
+            queueShapeInstance(CIRCLE_OUTLINES, translation, axis_x, axis_y, color, alpha);
+        return;
+    }
+
+    const size_t n_vertices = numShapeVertices(shape);
+    writeShapeOutline(reserve(DRAW, n_vertices, 2*n_vertices, alpha < 1.0f),
+        shape, model_to_world, color, alpha);
+}
+
+void SimpleRenderer::fillShape(Shape shape, const mat3& model_to_world, vec3 color,
+                               float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+    else if (settings.instanced_shapes) {
+        const vec2 axis_x{ model_to_world.e00, model_to_world.e10 },
+                   axis_y{ model_to_world.e01, model_to_world.e11 },
+                   translation{ model_to_world.e02, model_to_world.e12 };
+        if (shape == Shape::SQUARE)
+            queueShapeInstance(FILLED_RECTANGLES, translation - 0.5f*(axis_x + axis_y),
+                               axis_x, axis_y, color, alpha);
+        else
+            queueShapeInstance(FILLED_CIRCLES, translation, axis_x, axis_y, color, alpha);
+        return;
     }
 
-    const std::array<vec2, 4> vertices = setupRectangleVertices(bottom_left, upper_right);
-    const size_t initial_queue_data_size = queued_vertex_data.size();
+    writeFilledShape(reserve(FILL, numShapeVertices(shape), numFilledShapeElements(shape),
+        alpha < 1.0f), shape, model_to_world, color, alpha);
+}
+
+void SimpleRenderer::drawEllipse(vec2 center, vec2 radii, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
 
-    for (vec2 vertex : vertices)
-        queued_vertex_data.push_back(
-            Vector<float, 5>({ vertex.x, vertex.y, color[0], color[1], color[2] }));
+    const int n = curveSegments(std::max(std::abs(radii.x), std::abs(radii.y)),
+                                pixelsPerUnit());
+    writeEllipseOutline(reserve(DRAW, n, 2*n, alpha < 1.0f), center, radii, n,
+        color, alpha);
+}
 
-    const int indices[] = { 0, 1, 1, 2, 2, 3, 3, 0 };
-    for (int idx : indices)
-        queued_elements.push_back(static_cast<GLuint>(idx + initial_queue_data_size));
+void SimpleRenderer::fillEllipse(vec2 center, vec2 radii, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
 
-    if (alpha < 1.0f)
-        flushRenderQueue(render_style, alpha);
+    const int n = curveSegments(std::max(std::abs(radii.x), std::abs(radii.y)),
+                                pixelsPerUnit());
+    writeFilledEllipse(reserve(FILL, n, 3*(n-2), alpha < 1.0f), center, radii, n,
+        color, alpha);
 }
 
-void SimpleRenderer::fillRectangle(vec2 bottom_left, vec2 upper_right, vec3 color, float alpha)
+void SimpleRenderer::drawArc(vec2 center, float radius, float start_angle, float sweep,
+                             vec3 color, float alpha)
 {
     if (alpha <= 0.0f)
         return;
-    else if (alpha < 1.0f
-             || render_style != FILL)
+
+    const int n = curveSegments(radius, pixelsPerUnit());
+    const size_t m = numArcSegments(sweep, n);
+    writeArc(reserve(DRAW, m+1, 2*m, alpha < 1.0f), center, radius, start_angle, sweep,
+        n, color, alpha);
+}
+
+void SimpleRenderer::fillArc(vec2 center, float radius, float start_angle, float sweep,
+                             vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(radius, pixelsPerUnit());
+    const size_t m = numArcSegments(sweep, n);
+    writeFilledArc(reserve(FILL, m+2, 3*m, alpha < 1.0f), center, radius, start_angle,
+        sweep, n, color, alpha);
+}
+
+void SimpleRenderer::drawRoundedRectangle(vec2 bottom_left, vec2 upper_right,
+                                          float corner_radius, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(
+        roundedCornerRadius(bottom_left, upper_right, corner_radius), pixelsPerUnit());
+    writeRoundedRectangleOutline(reserve(DRAW, n+4, 2*(n+4), alpha < 1.0f), bottom_left,
+        upper_right, corner_radius, n, color, alpha);
+}
+
+void SimpleRenderer::fillRoundedRectangle(vec2 bottom_left, vec2 upper_right,
+                                          float corner_radius, vec3 color, float alpha)
+{
+    if (alpha <= 0.0f)
+        return;
+
+    const int n = curveSegments(
+        roundedCornerRadius(bottom_left, upper_right, corner_radius), pixelsPerUnit());
+    writeFilledRoundedRectangle(reserve(FILL, n+4, 3*(n+2), alpha < 1.0f), bottom_left,
+        upper_right, corner_radius, n, color, alpha);
+}
+
+void SimpleRenderer::drawPolyline(const vec2* points, size_t n_points,
+                                  const LineStyle& line_style, vec3 color, float alpha,
+                                  bool closed)
+{
+    SINI_PROFILE_SCOPE("SimpleRenderer::drawPolyline");
+    if (alpha <= 0.0f || n_points < 2 || !(line_style.width > 0.0f))
+        return;
+
+    CpuTimerScope cpu_timer{ frame_stats.cpu_submit_ms };
+    flushRenderQueue(render_style);
+    if (!polyline_shader)
+        setupPolylines();
+
+    // Repeated points are skipped, so that every join is between segments
+    // with a direction. A single remaining point is kept twice, and drawn as
+    // a dot by the caps.
+    const GLuint old_handle = polyline_points->handle();
+    vec2* padded = static_cast<vec2*>(
+        polyline_points->map(sizeof(vec2) * (n_points + 3), sizeof(vec2)));
+    vec2* unique = padded + 1;
+    size_t n_unique = 1;
+    unique[0] = points[0];
+    for (size_t i = 1; i < n_points; ++i)
+        if (points[i] != unique[n_unique - 1])
+            unique[n_unique++] = points[i];
+    while (closed && n_unique > 1 && unique[n_unique - 1] == unique[0])
+        n_unique--;
+    if (n_unique == 1) {
+        if (closed) {
+            polyline_points->commit(0);
+            return;
+        }
+        unique[n_unique++] = points[0];
+    }
+
+    // The points are padded with the neighbors of the end points, which are
+    // only used by a closed polyline's joins
+    const size_t n_segments = closed ? n_unique : n_unique - 1,
+                 size = sizeof(vec2) * (n_segments + 3);
+    padded[0] = closed ? unique[n_unique - 1] : unique[0];
+    if (closed) {
+        padded[n_unique + 1] = unique[0];
+        padded[n_unique + 2] = unique[1];
+    }
+    else {
+        padded[n_unique + 1] = unique[n_unique - 1];
+    }
+    polyline_points->commit(size);
+    frame_stats.bytes_uploaded += size;
+    if (polyline_points->handle() != old_handle) {
+        frame_stats.buffer_growths++;
+        bindPolylineBuffer();
+    }
+
+    gl_state.useProgram(polyline_shader->handle());
+    gl_state.setUniform(*polyline_shader, polyline_world_to_cam_loc, worldToCameraMatrix());
+    gl_state.setUniform(*polyline_shader, polyline_pixel_size_loc, 1.0f / pixelsPerUnit());
+    gl_state.setUniform(*polyline_shader, polyline_style_loc, vec4(0.5f * line_style.width,
+        line_style.miter_limit, line_style.join == LineJoin::ROUND ? 1.0f : 0.0f,
+        static_cast<float>(line_style.cap)));
+    gl_state.setUniform(*polyline_shader, polyline_color_loc,
+                        vec4(color[0], color[1], color[2], alpha));
+    gl_state.setUniform(*polyline_shader, polyline_last_segment_loc,
+                        closed ? -1.0f : static_cast<float>(n_segments - 1));
+    gl_state.setBlending(true);
+    gl_state.bindVertexArray(polyline_vertex_array);
     {
-        flushRenderQueue(render_style);
-        render_style = FILL;
+        GpuTimer::Scope gpu_timer_scope{ gpu_timer.get(), GpuTimer::DRAW };
+        glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 8,
+            static_cast<GLsizei>(n_segments),
+            static_cast<GLuint>(polyline_points->offset() / sizeof(vec2)));
+    }
+    gl_state.countCalls(1);
+    polyline_points->fence();
+    frame_stats.draw_calls++;
+    frame_stats.vertices += 8 * uint64_t(n_segments);
+}
+
+void SimpleRenderer::drawPolyline(const std::vector<vec2>& points,
+                                  const LineStyle& line_style, vec3 color, float alpha,
+                                  bool closed)
+{
+    drawPolyline(points.data(), points.size(), line_style, color, alpha, closed);
+}
+
+void SimpleRenderer::drawPolygon(const Polygon& polygon, const LineStyle& line_style,
+                                 vec3 color, float alpha)
+{
+    drawPolyline(polygon.vertices, line_style, color, alpha, true);
+}
+
+void SimpleRenderer::fillSdfCircle(vec2 center, float radius, vec3 color, float alpha)
+{
+    queueSdfShape(center, vec2(1.0f, 0.0f), vec2(radius), radius, 0.0f, color, alpha);
+}
+
+void SimpleRenderer::drawSdfCircle(vec2 center, float radius, float line_width, vec3 color,
+                                   float alpha)
+{
+    queueSdfShape(center, vec2(1.0f, 0.0f), vec2(radius), radius, line_width, color, alpha);
+}
+
+void SimpleRenderer::fillSdfCapsule(vec2 a, vec2 b, float radius, vec3 color, float alpha)
+{
+    drawSdfCapsule(a, b, radius, 0.0f, color, alpha);
+}
+
+void SimpleRenderer::drawSdfCapsule(vec2 a, vec2 b, float radius, float line_width,
+                                    vec3 color, float alpha)
+{
+    const float segment_length = length(b - a);
+    const vec2 axis = segment_length > 0.0f ? (b - a) / segment_length : vec2(1.0f, 0.0f);
+    queueSdfShape(0.5f * (a + b), axis, vec2(0.5f * segment_length + radius, radius), radius,
+                  line_width, color, alpha);
+}
+
+void SimpleRenderer::fillSdfRoundedBox(vec2 bottom_left, vec2 upper_right,
+                                       float corner_radius, vec3 color, float alpha)
+{
+    drawSdfRoundedBox(bottom_left, upper_right, corner_radius, 0.0f, color, alpha);
+}
+
+void SimpleRenderer::drawSdfRoundedBox(vec2 bottom_left, vec2 upper_right,
+                                       float corner_radius, float line_width, vec3 color,
+                                       float alpha)
+{
+    const vec2 half_extents{ 0.5f * std::abs(upper_right.x - bottom_left.x),
+                             0.5f * std::abs(upper_right.y - bottom_left.y) };
+    corner_radius = std::max(0.0f, std::min(corner_radius,
+                                            std::min(half_extents.x, half_extents.y)));
+    queueSdfShape(0.5f * (bottom_left + upper_right), vec2(1.0f, 0.0f), half_extents,
+                  corner_radius, line_width, color, alpha);
+}
+
+void SimpleRenderer::submit(const RenderCommandList& list)
+{
+    for (const RenderCommandList::Batch& batch : list.batches) {
+        VertexCursor cursor = reserve(batch.triangles ? FILL : DRAW, batch.n_vertices,
+                                      batch.n_elements, batch.translucent);
+        std::copy_n(list.vertices.data() + batch.first_vertex, batch.n_vertices,
+                    cursor.vertices);
+        const GLuint* elements = list.elements.data() + batch.first_element;
+        for (size_t i = 0; i < batch.n_elements; ++i)
+            cursor.elements[i] = cursor.first_vertex + elements[i];
     }
+}
 
-    const std::array<vec2, 4> vertices = setupRectangleVertices(bottom_left, upper_right);
-    const size_t initial_queue_data_size = queued_vertex_data.size();
-    // no reserve, since it causes queued_vertex_data and queued_elements to grow linearly
-    // instead of exponentially
-    for (vec2 vertex : vertices)
-        queued_vertex_data.push_back(
-            Vector<float, 5>({ vertex.x, vertex.y, color[0], color[1], color[2] }));
+void SimpleRenderer::submit(const std::vector<RenderCommandList>& lists)
+{
+    for (const RenderCommandList& list : lists)
+        submit(list);
+}
 
-    const int indices[] = { 0, 1, 2, 0, 2, 3 };
-    for (int idx : indices)
-        queued_elements.push_back(static_cast<GLuint>(idx + initial_queue_data_size));
+void SimpleRenderer::drawStaticMesh(StaticMesh& mesh, const mat3& model_to_world)
+{
+    if (mesh.elements.empty())
+        return;
+
+    SINI_PROFILE_SCOPE("SimpleRenderer::drawStaticMesh");
+    // Queued primitives are drawn first, to keep the drawing order
+    flushRenderQueue(render_style);
+    CpuTimerScope cpu_timer{ frame_stats.cpu_submit_ms };
+    const bool had_buffers = mesh.vertex_buffer != 0;
+    const size_t old_capacity = mesh.vertex_capacity + mesh.element_capacity;
+    frame_stats.bytes_uploaded += mesh.upload(gl_state);
+    if (had_buffers && mesh.vertex_capacity + mesh.element_capacity != old_capacity)
+        frame_stats.buffer_growths++;
+
+    gl_state.useProgram(shader_program->handle());
+    gl_state.setUniform(*shader_program, model_to_world_loc, model_to_world);
+    gl_state.setUniform(*shader_program, world_to_cam_loc, worldToCameraMatrix());
+    gl_state.setBlending(mesh.n_translucent_polygons > 0);
+    gl_state.bindVertexArray(mesh.vertex_array);
+    {
+        GpuTimer::Scope gpu_timer_scope{ gpu_timer.get(), GpuTimer::DRAW };
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh.elements.size()),
+            GL_UNSIGNED_INT, nullptr);
+    }
+    gl_state.countCalls(1);
+    frame_stats.draw_calls++;
+    frame_stats.vertices += mesh.vertices.size();
+    frame_stats.elements += mesh.elements.size();
+    // Not left bound, since the mesh may be destroyed and its vertex array
+    // name reused before the next draw
+    gl_state.bindVertexArray(0);
+}
 
-    if (alpha < 1.0f)
-        flushRenderQueue(render_style, alpha);
+SimpleRenderer::VertexCursor SimpleRenderer::reserveTriangles(size_t n_vertices,
+                                                              size_t n_elements)
+{
+    // The caller may write any alpha
+    return reserve(FILL, n_vertices, n_elements, true);
 }
 
-void SimpleRenderer::drawCircle(vec2 center, float radius, vec3 color, float alpha)
+SimpleRenderer::VertexCursor SimpleRenderer::reserveLines(size_t n_vertices,
+                                                          size_t n_elements)
 {
-    Polygon circle{ setupCircle(center, radius) };
-    drawPolygon(circle, color, alpha);
+    return reserve(DRAW, n_vertices, n_elements, true);
 }
 
-void SimpleRenderer::fillCircle(vec2 center, float radius, vec3 color, float alpha)
+void SimpleRenderer::readPixels(uint8_t* rgb_out)
 {
-    if (!circle_polygon) circle_polygon = createCirclePolygon();
-    if (!circle_polygon->triangle_mesh) circle_polygon->buildTriangleMesh();
+    flushRenderQueue(render_style);
 
-    Polygon circle{ setupCircle(center, radius) };
-    fillPolygon(circle, color, alpha);
+    const vec2i dims = framebuffer_dimensions;
+    const size_t row_size = 3 * size_t(dims.x);
+    gl_state.bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, dims.x, dims.y, GL_RGB, GL_UNSIGNED_BYTE, rgb_out);
+    gl_state.countCalls(2);
+    frame_stats.framebuffer_bytes_copied += row_size * size_t(dims.y);
+
+    // GL's rows are from bottom to top
+    std::vector<uint8_t> row(row_size);
+    for (int y = 0; y < dims.y / 2; ++y) {
+        uint8_t* top = rgb_out + y * row_size;
+        uint8_t* bottom = rgb_out + (dims.y - 1 - y) * row_size;
+        std::copy_n(top, row_size, row.data());
+        std::copy_n(bottom, row_size, top);
+        std::copy_n(row.data(), row_size, bottom);
+    }
+}
+
+std::vector<uint8_t> SimpleRenderer::readPixels()
+{
+    std::vector<uint8_t> pixels(3 * size_t(framebuffer_dimensions.x)
+                                  * size_t(framebuffer_dimensions.y));
+    readPixels(pixels.data());
+    return pixels;
 }
 
-void SimpleRenderer::updateScreen() noexcept
+void SimpleRenderer::updateScreen()
 {
+    SINI_PROFILE_SCOPE("SimpleRenderer::updateScreen");
     flushRenderQueue(render_style);
-    renderFramebuffer(0);
-    SDL_GL_SwapWindow(window->win_ptr);
+    {
+        CpuTimerScope cpu_timer{ frame_stats.cpu_submit_ms };
+        GpuTimer::Scope gpu_timer_scope{ gpu_timer.get(), GpuTimer::PRESENT };
+        if (frame_capture != nullptr)
+            frame_stats.framebuffer_bytes_copied +=
+                frame_capture->capture(gl_state, framebuffer, framebuffer_dimensions);
+        if (window != nullptr)
+            presentFramebuffer();
+    }
+    // May wait for vertical sync, and is therefore not counted as submitting
+    if (window != nullptr) {
+        SINI_PROFILE_SCOPE("SDL_GL_SwapWindow");
+        SDL_GL_SwapWindow(window->win_ptr);
+    }
+
+    frame_stats.frame_index = n_finished_frames++;
+    frame_stats.gl_calls = gl_state.callCount();
+    gl_state.resetCallCount();
+    frame_stats.cpu_frame_ms = millisecondsSince(frame_start_time);
+    frame_start_time = std::chrono::steady_clock::now();
+    if (gpu_timer)
+        gpu_timer->endFrame(frame_stats, *frame_log);
+    last_frame_stats = frame_stats;
+    frame_stats = FrameStats();
+}
+
+void SimpleRenderer::setFrameLog(FrameLog* log)
+{
+    if (gpu_timer)
+        gpu_timer->finish(*frame_log);
+    frame_log = log;
+    if (log == nullptr)
+        gpu_timer.reset();
+    else if (!gpu_timer)
+        gpu_timer = std::make_unique<GpuTimer>();
 }
 
 
 // Private member functions
 // -----------------------------------------------------------------------------
-void SimpleRenderer::flushRenderQueue(RenderStyle style, float alpha) noexcept
+void SimpleRenderer::flushRenderQueue(RenderStyle style) noexcept
 {
-    if (queued_elements.size() == 0)
+    SINI_PROFILE_SCOPE("SimpleRenderer::flushRenderQueue");
+    CpuTimerScope cpu_timer{ frame_stats.cpu_submit_ms };
+    if (style == SDF_SHAPES) {
+        flushSdfShapes();
         return;
+    }
+    else if (style != DRAW && style != FILL) {
+        flushShapeInstances(style);
+        return;
+    }
 
-    const size_t queued_data_size = sizeof(Vector<float,5>) * queued_vertex_data.size(),
-              queued_element_size = sizeof(GLuint) * queued_elements.size();
-
-    if (queued_data_size > vertex_buffer_size) growInternalVertexBuffer(queued_data_size);
-    if (queued_element_size > element_buffer_size) growInternalElementBuffer(queued_element_size);
+    GLsizei n_elements;
+    GLint base_vertex = 0;
+    size_t element_offset = 0;
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER) {
+        if (mapped_batch.n_elements == 0)
+            return;
+
+        n_elements = static_cast<GLsizei>(mapped_batch.n_elements);
+        frame_stats.vertices += mapped_batch.n_vertices;
+        vertex_stream->commit(sizeof(Vertex) * mapped_batch.n_vertices);
+        element_stream->commit(sizeof(GLuint) * mapped_batch.n_elements);
+        frame_stats.bytes_uploaded += sizeof(Vertex) * mapped_batch.n_vertices
+                                      + sizeof(GLuint) * mapped_batch.n_elements;
+        mapped_batch = MappedBatch();
+
+        base_vertex = static_cast<GLint>(vertex_stream->offset() / sizeof(Vertex));
+        element_offset = element_stream->offset();
+        gl_state.bindVertexArray(vertex_array);
+    }
+    else {
+        if (n_queued_elements == 0)
+            return;
+
+        n_elements = static_cast<GLsizei>(n_queued_elements);
+        frame_stats.vertices += n_queued_vertices;
+        const size_t queued_data_size = sizeof(Vertex) * n_queued_vertices,
+                  queued_element_size = sizeof(GLuint) * n_queued_elements;
+
+        if (queued_data_size > vertex_buffer_size) growInternalVertexBuffer(queued_data_size);
+        if (queued_element_size > element_buffer_size) growInternalElementBuffer(queued_element_size);
+
+        gl_state.bindVertexArray(vertex_array);
+        gl_state.bindArrayBuffer(vertex_buffer);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, queued_data_size, queued_vertex_data.data()->data());
+        // The element buffer binding is part of the vertex array
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, queued_element_size, queued_elements.data());
+        gl_state.countCalls(2);
+        frame_stats.bytes_uploaded += queued_data_size + queued_element_size;
+
+        n_queued_vertices = 0;
+        n_queued_elements = 0;
+    }
 
-    glBindVertexArray(vertex_array);
-    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, queued_data_size, queued_vertex_data.data()->data());
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer);
-    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, queued_element_size, queued_elements.data());
+    gl_state.useProgram(shader_program->handle());
+    // Queued primitives are in world coordinates
+    gl_state.setUniform(*shader_program, model_to_world_loc, mat3::identity());
+    gl_state.setUniform(*shader_program, world_to_cam_loc, worldToCameraMatrix());
 
-    glUseProgram(shader_program);
-    setUniforms(alpha);
+    // Blending is only enabled when needed, since it's not free
+    gl_state.setBlending(translucent_primitives_queued);
+    translucent_primitives_queued = false;
 
     GLenum draw_mode = (style == FILL) ? GL_TRIANGLES : GL_LINES;
-    glDrawElements(draw_mode, queued_elements.size(), GL_UNSIGNED_INT, 0);
+    {
+        GpuTimer::Scope gpu_timer_scope{ gpu_timer.get(), GpuTimer::DRAW };
+        glDrawElementsBaseVertex(draw_mode, n_elements, GL_UNSIGNED_INT,
+            reinterpret_cast<void*>(element_offset), base_vertex);
+    }
+    gl_state.countCalls(1);
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER) {
+        vertex_stream->fence();
+        element_stream->fence();
+    }
+    frame_stats.draw_calls++;
+    frame_stats.elements += n_elements;
+}
+
+SimpleRenderer::VertexCursor SimpleRenderer::reserve(RenderStyle style,
+                                                     size_t n_vertices,
+                                                     size_t n_elements,
+                                                     bool translucent)
+{
+    if (style != render_style) {
+        flushRenderQueue(render_style);
+        render_style = style;
+    }
+
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER) {
+        if (n_vertices > mapped_batch.vertex_capacity - mapped_batch.n_vertices
+            || n_elements > mapped_batch.element_capacity - mapped_batch.n_elements)
+        {
+            flushRenderQueue(render_style);
+            mapBatch(n_vertices, n_elements);
+        }
+        if (translucent) translucent_primitives_queued = true;
+        VertexCursor cursor{ mapped_batch.vertices + mapped_batch.n_vertices,
+                             mapped_batch.elements + mapped_batch.n_elements,
+                             static_cast<GLuint>(mapped_batch.n_vertices) };
+        mapped_batch.n_vertices += n_vertices;
+        mapped_batch.n_elements += n_elements;
+        return cursor;
+    }
+
+    if (translucent) translucent_primitives_queued = true;
+    const size_t first_vertex = n_queued_vertices,
+                 first_element = n_queued_elements;
+    n_queued_vertices += n_vertices;
+    n_queued_elements += n_elements;
+    if (n_queued_vertices > queued_vertex_data.size())
+        queued_vertex_data.resize(sizeGrowthFunction(
+            std::max(queued_vertex_data.size(), size_t(1024)), n_queued_vertices));
+    if (n_queued_elements > queued_elements.size())
+        queued_elements.resize(sizeGrowthFunction(
+            std::max(queued_elements.size(), size_t(1024)), n_queued_elements));
+    return VertexCursor{ queued_vertex_data.data() + first_vertex,
+                         queued_elements.data() + first_element,
+                         static_cast<GLuint>(first_vertex) };
+}
+
+void SimpleRenderer::mapBatch(size_t min_vertices, size_t min_elements)
+{
+    const GLuint old_vertex_handle = vertex_stream->handle(),
+                 old_element_handle = element_stream->handle();
+
+    // Map (at least) a whole segment at a time, the unused part is given back
+    // when the batch is committed. The batch usually reaches into the next
+    // segment, which map() waits for until the draws of the previous lap are
+    // done, since flushRenderQueue() fences the streams after each draw.
+    const size_t vertex_capacity =
+        std::max(min_vertices, vertex_stream->segmentSize() / sizeof(Vertex));
+    const size_t element_capacity =
+        std::max(min_elements, element_stream->segmentSize() / sizeof(GLuint));
+    // Vertex data is aligned to whole vertices, for use as base vertex
+    mapped_batch.vertices = static_cast<Vertex*>(
+        vertex_stream->map(sizeof(Vertex) * vertex_capacity, sizeof(Vertex)));
+    mapped_batch.elements = static_cast<GLuint*>(
+        element_stream->map(sizeof(GLuint) * element_capacity, sizeof(GLuint)));
+    mapped_batch.vertex_capacity = vertex_capacity;
+    mapped_batch.element_capacity = element_capacity;
+
+    // The buffers are replaced if they had to grow
+    if (vertex_stream->handle() != old_vertex_handle
+        || element_stream->handle() != old_element_handle)
+    {
+        frame_stats.buffer_growths += (vertex_stream->handle() != old_vertex_handle)
+                                    + (element_stream->handle() != old_element_handle);
+        bindStreamBuffers();
+    }
+}
+
+void SimpleRenderer::queueShapeInstance(RenderStyle style, vec2 offset, vec2 axis_x,
+                                        vec2 axis_y, vec3 color, float alpha)
+{
+    if (style != render_style) {
+        flushRenderQueue(render_style);
+        render_style = style;
+    }
+
+    const ShapeInstance instance{ offset, axis_x, axis_y,
+        { toUnorm8(color[0]), toUnorm8(color[1]), toUnorm8(color[2]), toUnorm8(alpha) } };
+
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER) {
+        if (mapped_instances.n_instances == mapped_instances.capacity) {
+            flushRenderQueue(render_style);
+            const GLuint old_handle = instance_stream->handle();
+            mapped_instances.capacity = instance_stream->segmentSize() / sizeof(ShapeInstance);
+            mapped_instances.instances = static_cast<ShapeInstance*>(instance_stream->map(
+                sizeof(ShapeInstance) * mapped_instances.capacity, sizeof(ShapeInstance)));
+            if (instance_stream->handle() != old_handle) {
+                frame_stats.buffer_growths++;
+                bindInstanceBuffer(instance_stream->handle());
+            }
+        }
+        mapped_instances.instances[mapped_instances.n_instances++] = instance;
+    }
+    else {
+        queued_instances.push_back(instance);
+    }
+    // After any flush above, which resets it
+    if (alpha < 1.0f) translucent_primitives_queued = true;
+}
+
+void SimpleRenderer::flushShapeInstances(RenderStyle style) noexcept
+{
+    GLsizei n_instances;
+    GLuint base_instance = 0;
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER) {
+        if (mapped_instances.n_instances == 0)
+            return;
+
+        n_instances = static_cast<GLsizei>(mapped_instances.n_instances);
+        instance_stream->commit(sizeof(ShapeInstance) * mapped_instances.n_instances);
+        frame_stats.bytes_uploaded += sizeof(ShapeInstance) * mapped_instances.n_instances;
+        mapped_instances = MappedInstances();
+        base_instance = static_cast<GLuint>(instance_stream->offset() / sizeof(ShapeInstance));
+    }
+    else {
+        if (queued_instances.empty())
+            return;
+
+        n_instances = static_cast<GLsizei>(queued_instances.size());
+        const size_t queued_size = sizeof(ShapeInstance) * queued_instances.size();
+        gl_state.bindArrayBuffer(instance_buffer);
+        if (queued_size > instance_buffer_size) {
+            instance_buffer_size = sizeGrowthFunction(instance_buffer_size, queued_size);
+            glBufferData(GL_ARRAY_BUFFER, instance_buffer_size, NULL, GL_STREAM_DRAW);
+            gl_state.countCalls(1);
+            frame_stats.buffer_growths++;
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, queued_size, queued_instances.data());
+        gl_state.countCalls(1);
+        frame_stats.bytes_uploaded += queued_size;
+        queued_instances.clear();
+    }
 
-    glBindVertexArray(0);
-    queued_vertex_data.clear();
-    queued_elements.clear();
+    gl_state.useProgram(instance_shader->handle());
+    gl_state.setUniform(*instance_shader, instance_world_to_cam_loc, worldToCameraMatrix());
+    gl_state.setBlending(translucent_primitives_queued);
+    translucent_primitives_queued = false;
+    gl_state.bindVertexArray(shape_vertex_array);
 
-    renderFramebuffer(backbuffer);
-    glUseProgram(0);
+    const ShapeMesh& mesh = shape_meshes[style];
+    GLenum draw_mode = (style == FILLED_RECTANGLES || style == FILLED_CIRCLES)
+        ? GL_TRIANGLES : GL_LINES;
+    {
+        GpuTimer::Scope gpu_timer_scope{ gpu_timer.get(), GpuTimer::DRAW };
+        glDrawElementsInstancedBaseVertexBaseInstance(draw_mode, mesh.n_elements,
+            GL_UNSIGNED_INT, reinterpret_cast<void*>(mesh.element_offset),
+            n_instances, mesh.base_vertex, base_instance);
+    }
+    gl_state.countCalls(1);
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER)
+        instance_stream->fence();
+    frame_stats.draw_calls++;
+    frame_stats.vertices += uint64_t(mesh.n_vertices) * uint64_t(n_instances);
+    frame_stats.elements += uint64_t(mesh.n_elements) * uint64_t(n_instances);
 }
 
-void SimpleRenderer::setUniforms(float alpha) noexcept
+void SimpleRenderer::queueSdfShape(vec2 center, vec2 axis, vec2 half_extents,
+                                   float corner_radius, float line_width, vec3 color,
+                                   float alpha)
 {
-    int alpha_loc = glGetUniformLocation(shader_program, "alpha");
-    glUniform1f(alpha_loc, alpha);
-    int model_to_world_loc = glGetUniformLocation(shader_program, "model_to_world_transf");
-    mat2 id_mat = mat2::identity();
-    // GL_TRUE (transpose) since OpenGL expects matrices in column-major order
-    glUniformMatrix2fv(model_to_world_loc, 1, GL_TRUE, id_mat.data());
+    if (alpha <= 0.0f)
+        return;
+    if (render_style != SDF_SHAPES) {
+        flushRenderQueue(render_style);
+        render_style = SDF_SHAPES;
+    }
+    if (!sdf_shader)
+        setupSdfShapes();
+
+    const SdfShape shape{ center, axis, half_extents, corner_radius,
+        std::max(line_width, 0.0f),
+        { toUnorm8(color[0]), toUnorm8(color[1]), toUnorm8(color[2]), toUnorm8(alpha) } };
+
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER) {
+        if (mapped_sdf_shapes.n_shapes == mapped_sdf_shapes.capacity) {
+            flushRenderQueue(render_style);
+            const GLuint old_handle = sdf_stream->handle();
+            mapped_sdf_shapes.capacity = sdf_stream->segmentSize() / sizeof(SdfShape);
+            mapped_sdf_shapes.shapes = static_cast<SdfShape*>(sdf_stream->map(
+                sizeof(SdfShape) * mapped_sdf_shapes.capacity, sizeof(SdfShape)));
+            if (sdf_stream->handle() != old_handle) {
+                frame_stats.buffer_growths++;
+                bindSdfInstanceBuffer(sdf_stream->handle());
+            }
+        }
+        mapped_sdf_shapes.shapes[mapped_sdf_shapes.n_shapes++] = shape;
+    }
+    else {
+        queued_sdf_shapes.push_back(shape);
+    }
+}
 
-    int world_to_cam_loc = glGetUniformLocation(shader_program, "world_to_cam_transf");
-    mat3 transf_matrix = camera.worldToCameraViewMatrix();
-    glUniformMatrix3fv(world_to_cam_loc, 1, GL_TRUE, transf_matrix.data());
+void SimpleRenderer::flushSdfShapes() noexcept
+{
+    GLsizei n_shapes;
+    GLuint base_instance = 0;
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER) {
+        if (mapped_sdf_shapes.n_shapes == 0)
+            return;
+
+        n_shapes = static_cast<GLsizei>(mapped_sdf_shapes.n_shapes);
+        sdf_stream->commit(sizeof(SdfShape) * mapped_sdf_shapes.n_shapes);
+        frame_stats.bytes_uploaded += sizeof(SdfShape) * mapped_sdf_shapes.n_shapes;
+        mapped_sdf_shapes = MappedSdfShapes();
+        base_instance = static_cast<GLuint>(sdf_stream->offset() / sizeof(SdfShape));
+    }
+    else {
+        if (queued_sdf_shapes.empty())
+            return;
+
+        n_shapes = static_cast<GLsizei>(queued_sdf_shapes.size());
+        const size_t queued_size = sizeof(SdfShape) * queued_sdf_shapes.size();
+        gl_state.bindArrayBuffer(sdf_instance_buffer);
+        if (queued_size > sdf_instance_buffer_size) {
+            sdf_instance_buffer_size = sizeGrowthFunction(sdf_instance_buffer_size,
+                                                          queued_size);
+            glBufferData(GL_ARRAY_BUFFER, sdf_instance_buffer_size, NULL, GL_STREAM_DRAW);
+            gl_state.countCalls(1);
+            frame_stats.buffer_growths++;
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, queued_size, queued_sdf_shapes.data());
+        gl_state.countCalls(1);
+        frame_stats.bytes_uploaded += queued_size;
+        queued_sdf_shapes.clear();
+    }
+
+    gl_state.useProgram(sdf_shader->handle());
+    gl_state.setUniform(*sdf_shader, sdf_world_to_cam_loc, worldToCameraMatrix());
+    gl_state.setUniform(*sdf_shader, sdf_pixel_size_loc, 1.0f / pixelsPerUnit());
+    // Antialiased edges are always translucent
+    gl_state.setBlending(true);
+    translucent_primitives_queued = false;
+    gl_state.bindVertexArray(sdf_vertex_array);
+    {
+        GpuTimer::Scope gpu_timer_scope{ gpu_timer.get(), GpuTimer::DRAW };
+        glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, n_shapes, base_instance);
+    }
+    gl_state.countCalls(1);
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER)
+        sdf_stream->fence();
+    frame_stats.draw_calls++;
+    frame_stats.vertices += 4 * uint64_t(n_shapes);
+}
+
+const mat3& SimpleRenderer::worldToCameraMatrix() noexcept
+{
+    // Only recomputed (with cos and sin) when the camera has changed
+    if (!camera_matrix.valid || camera.position != camera_matrix.position
+        || camera.width != camera_matrix.width
+        || camera.orientation != camera_matrix.orientation)
+    {
+        camera_matrix.position = camera.position;
+        camera_matrix.width = camera.width;
+        camera_matrix.orientation = camera.orientation;
+        camera_matrix.matrix = camera.worldToCameraViewMatrix();
+        camera_matrix.valid = true;
+    }
+    return camera_matrix.matrix;
 }
 
 void SimpleRenderer::setupInternalFramebuffer()
 {
     // Generate frame and color buffers
     glGenFramebuffers(1, &framebuffer);
-    glGenFramebuffers(1, &backbuffer);
     glGenTextures(1, &framebuffer_texture);
-    glGenTextures(1, &backbuffer_texture);
-    vec2i dims = window->dimensions();
+    const vec2i dims = framebuffer_dimensions;
 
-    // Create textures
-    // -------------------------------------------
-    // Framebuffer
-    glActiveTexture(GL_TEXTURE0);
+    // Create texture
     glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
     glBindTexture(GL_TEXTURE_2D, framebuffer_texture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, dims.x, dims.y, 0,
@@ -429,39 +1286,20 @@ void SimpleRenderer::setupInternalFramebuffer()
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         throw OpenGlException("Framebuffer not complete");
 
-    // Backbuffer
-    glActiveTexture(GL_TEXTURE1);
-    glBindFramebuffer(GL_FRAMEBUFFER, backbuffer);
-    glBindTexture(GL_TEXTURE_2D, backbuffer_texture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, dims.x, dims.y, 0,
-        GL_RGB, GL_UNSIGNED_BYTE, NULL);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // Bind texture to backbuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, backbuffer);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
-        backbuffer_texture, 0);
-
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-        throw OpenGlException("Backbuffer not complete");
-
-    glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, 0);
-
-    setupQuadVertexArray();
-
-    // Bind textures to shaders
-    glUseProgram(screen_shader);
-    glUniform1i(glGetUniformLocation(screen_shader, "framebuffer"), 0);
-    glUseProgram(shader_program);
-    glUniform1i(glGetUniformLocation(shader_program, "backbuffer"), 1);
-    glUseProgram(0);
 }
 
-void SimpleRenderer::setupInternalVertexObjects() noexcept
+void SimpleRenderer::setupInternalVertexObjects()
 {
     glGenVertexArrays(1, &vertex_array);
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER) {
+        // The initial buffer sizes are used per ring segment
+        vertex_stream = std::make_unique<StreamBuffer>(vertex_buffer_size);
+        element_stream = std::make_unique<StreamBuffer>(element_buffer_size);
+        bindStreamBuffers();
+        return;
+    }
+
     glGenBuffers(1, &vertex_buffer);
     glGenBuffers(1, &element_buffer);
 
@@ -471,95 +1309,237 @@ void SimpleRenderer::setupInternalVertexObjects() noexcept
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, element_buffer_size, NULL, GL_STREAM_DRAW);
 
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6*sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)(2*sizeof(float)));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6*sizeof(float), (void*)(2*sizeof(float)));
     glEnableVertexAttribArray(1);
 }
 
-void SimpleRenderer::growInternalVertexBuffer(size_t minimum_capacity) noexcept
+void SimpleRenderer::bindStreamBuffers() noexcept
 {
-    glBindVertexArray(vertex_array);
-    const size_t new_size = sizeGrowthFunction(vertex_buffer_size, minimum_capacity);
-    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
-    glBufferData(GL_ARRAY_BUFFER, new_size, NULL, GL_STREAM_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)(2*sizeof(float)));
+    gl_state.bindVertexArray(vertex_array);
+    gl_state.bindArrayBuffer(vertex_stream->handle());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_stream->handle());
 
-    vertex_buffer_size = new_size;
-
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6*sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6*sizeof(float), (void*)(2*sizeof(float)));
+    glEnableVertexAttribArray(1);
+    gl_state.countCalls(5);
 }
 
-void SimpleRenderer::growInternalElementBuffer(size_t minimum_capacity) noexcept
+void SimpleRenderer::setupShapeMeshes()
 {
-    glBindVertexArray(vertex_array);
-    const size_t new_size = sizeGrowthFunction(element_buffer_size, minimum_capacity);
-    glBindBuffer(GL_ARRAY_BUFFER, element_buffer);
-    glBufferData(GL_ARRAY_BUFFER, new_size, NULL, GL_STREAM_DRAW);
+    instance_shader = std::make_unique<ShaderProgram>(instance_vertex_shader_src,
+        nullptr, instance_fragment_shader_src);
+    instance_world_to_cam_loc = instance_shader->uniformLocation("world_to_cam_transf");
+
+    const Polygon& circle = unitCircle();
+
+    // Unit rectangle [0,1]x[0,1] followed by the unit circle
+    std::vector<vec2> vertices{ { 0.0f, 0.0f }, { 1.0f, 0.0f },
+                                { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+    vertices.insert(vertices.end(),
+        circle.vertices.begin(), circle.vertices.end());
+    const GLint n_circle_vertices = static_cast<GLint>(circle.vertices.size());
+
+    std::vector<GLuint> elements;
+    auto addMesh = [&](RenderStyle style, GLint base_vertex, GLsizei n_vertices) {
+        shape_meshes[style].element_offset = sizeof(GLuint) * elements.size();
+        shape_meshes[style].base_vertex = base_vertex;
+        shape_meshes[style].n_vertices = n_vertices;
+    };
+    auto endMesh = [&](RenderStyle style) {
+        shape_meshes[style].n_elements = static_cast<GLsizei>(
+            elements.size() - shape_meshes[style].element_offset / sizeof(GLuint));
+    };
+
+    addMesh(FILLED_RECTANGLES, 0, 4);
+    elements.insert(elements.end(), { 0, 1, 2, 0, 2, 3 });
+    endMesh(FILLED_RECTANGLES);
+
+    addMesh(RECTANGLE_OUTLINES, 0, 4);
+    elements.insert(elements.end(), { 0, 1, 1, 2, 2, 3, 3, 0 });
+    endMesh(RECTANGLE_OUTLINES);
+
+    addMesh(FILLED_CIRCLES, 4, n_circle_vertices);
+    for (vec3i triangle : *circle.triangle_mesh)
+        for (int idx : triangle)
+            elements.push_back(static_cast<GLuint>(idx));
+    endMesh(FILLED_CIRCLES);
+
+    addMesh(CIRCLE_OUTLINES, 4, n_circle_vertices);
+    for (GLint i = 0; i < n_circle_vertices; ++i) {
+        elements.push_back(static_cast<GLuint>(i));
+        elements.push_back(static_cast<GLuint>((i + 1) % n_circle_vertices));
+    }
+    endMesh(CIRCLE_OUTLINES);
 
-    element_buffer_size = new_size;
+    glGenVertexArrays(1, &shape_vertex_array);
+    glGenBuffers(1, &shape_vertex_buffer);
+    glGenBuffers(1, &shape_element_buffer);
+
+    glBindVertexArray(shape_vertex_array);
+    glBindBuffer(GL_ARRAY_BUFFER, shape_vertex_buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vec2) * vertices.size(), vertices.data(),
+        GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(vec2), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, shape_element_buffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * elements.size(), elements.data(),
+        GL_STATIC_DRAW);
 
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER) {
+        instance_stream = std::make_unique<StreamBuffer>(instance_buffer_size);
+        bindInstanceBuffer(instance_stream->handle());
+    }
+    else {
+        glGenBuffers(1, &instance_buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+        glBufferData(GL_ARRAY_BUFFER, instance_buffer_size, NULL, GL_STREAM_DRAW);
+        bindInstanceBuffer(instance_buffer);
+    }
 }
 
-void SimpleRenderer::setupQuadVertexArray() noexcept
+void SimpleRenderer::setupSdfShapes()
 {
-    glGenVertexArrays(1, &quad_vertex_array);
-    glGenBuffers(1, &quad_vertex_buffer);
+    sdf_shader = std::make_unique<ShaderProgram>(sdf_vertex_shader_src, nullptr,
+        sdf_fragment_shader_src);
+    sdf_world_to_cam_loc = sdf_shader->uniformLocation("world_to_cam_transf");
+    sdf_pixel_size_loc = sdf_shader->uniformLocation("pixel_size");
+
+    glGenVertexArrays(1, &sdf_vertex_array);
+    if (settings.vertex_streaming == VertexStreaming::RING_BUFFER) {
+        sdf_stream = std::make_unique<StreamBuffer>(sdf_instance_buffer_size);
+        bindSdfInstanceBuffer(sdf_stream->handle());
+    }
+    else {
+        glGenBuffers(1, &sdf_instance_buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, sdf_instance_buffer);
+        glBufferData(GL_ARRAY_BUFFER, sdf_instance_buffer_size, NULL, GL_STREAM_DRAW);
+        bindSdfInstanceBuffer(sdf_instance_buffer);
+    }
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, quad_vertex_buffer);
-    //                        position      texture_coord
-    float quad_vertices[] = { -1.0f,  1.0f, 0.0f, 1.0f,
-                              -1.0f, -1.0f, 0.0f, 0.0f,
-                               1.0f, -1.0f, 1.0f, 0.0f,
-                               1.0f, -1.0f, 1.0f, 0.0f,
-                               1.0f,  1.0f, 1.0f, 1.0f,
-                              -1.0f,  1.0f, 0.0f, 1.0f };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quad_vertices), quad_vertices,
-        GL_STATIC_DRAW);
+void SimpleRenderer::bindSdfInstanceBuffer(GLuint buffer) noexcept
+{
+    gl_state.bindVertexArray(sdf_vertex_array);
+    gl_state.bindArrayBuffer(buffer);
+
+    const GLsizei stride = sizeof(SdfShape);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(SdfShape, center));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(SdfShape, axis));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(SdfShape, half_extents));
+    // The corner radius and line width
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(SdfShape, corner_radius));
+    glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+        (void*)offsetof(SdfShape, color));
+    for (GLuint attrib = 0; attrib <= 4; ++attrib) {
+        glVertexAttribDivisor(attrib, 1);
+        glEnableVertexAttribArray(attrib);
+    }
+    gl_state.countCalls(15);
+}
 
-    glBindVertexArray(quad_vertex_array);
-    glBindBuffer(GL_ARRAY_BUFFER, quad_vertex_buffer);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4*sizeof(float), 0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4*sizeof(float),
-        (void*)(2*sizeof(float)));
+void SimpleRenderer::setupPolylines()
+{
+    polyline_shader = std::make_unique<ShaderProgram>(polyline_vertex_shader_src, nullptr,
+        polyline_fragment_shader_src);
+    polyline_world_to_cam_loc = polyline_shader->uniformLocation("world_to_cam_transf");
+    polyline_pixel_size_loc = polyline_shader->uniformLocation("pixel_size");
+    polyline_style_loc = polyline_shader->uniformLocation("line_style");
+    polyline_color_loc = polyline_shader->uniformLocation("line_color");
+    polyline_last_segment_loc = polyline_shader->uniformLocation("last_segment");
+
+    glGenVertexArrays(1, &polyline_vertex_array);
+    // Room for 128k points per segment of the ring
+    polyline_points = std::make_unique<StreamBuffer>(1024*1024);
+    bindPolylineBuffer();
 }
 
-Polygon SimpleRenderer::setupCircle(vec2 offset, float radius)
+void SimpleRenderer::bindPolylineBuffer() noexcept
 {
-    if (!circle_polygon) circle_polygon = createCirclePolygon();
-    Polygon new_circle{ *circle_polygon };
-    for (vec2& vertex : new_circle.vertices) {
-        vertex *= radius;
-        vertex += offset;
+    gl_state.bindVertexArray(polyline_vertex_array);
+    gl_state.bindArrayBuffer(polyline_points->handle());
+
+    // Instance i reads points i to i+3, i.e. the point before segment i, its
+    // end points and the point after it
+    for (GLuint attrib = 0; attrib < 4; ++attrib) {
+        glVertexAttribPointer(attrib, 2, GL_FLOAT, GL_FALSE, sizeof(vec2),
+            (void*)(attrib * sizeof(vec2)));
+        glVertexAttribDivisor(attrib, 1);
+        glEnableVertexAttribArray(attrib);
     }
-    return new_circle;
+    gl_state.countCalls(12);
 }
 
-void SimpleRenderer::renderFramebuffer(GLuint target_framebuffer) noexcept
+void SimpleRenderer::bindInstanceBuffer(GLuint buffer) noexcept
 {
-    // Render to target framebuffer (0 being the screen)
-    glBindFramebuffer(GL_FRAMEBUFFER, target_framebuffer);
+    gl_state.bindVertexArray(shape_vertex_array);
+    gl_state.bindArrayBuffer(buffer);
+
+    const GLsizei stride = sizeof(ShapeInstance);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(ShapeInstance, offset));
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(ShapeInstance, axis_x));
+    glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(ShapeInstance, axis_y));
+    glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+        (void*)offsetof(ShapeInstance, color));
+    for (GLuint attrib = 2; attrib <= 5; ++attrib) {
+        glVertexAttribDivisor(attrib, 1);
+        glEnableVertexAttribArray(attrib);
+    }
+    gl_state.countCalls(12);
+}
 
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+void SimpleRenderer::growInternalVertexBuffer(size_t minimum_capacity) noexcept
+{
+    SINI_PROFILE_SCOPE("SimpleRenderer::growInternalVertexBuffer");
+    gl_state.bindVertexArray(vertex_array);
+    const size_t new_size = sizeGrowthFunction(vertex_buffer_size, minimum_capacity);
+    gl_state.bindArrayBuffer(vertex_buffer);
+    glBufferData(GL_ARRAY_BUFFER, new_size, NULL, GL_STREAM_DRAW);
+    frame_stats.buffer_growths++;
 
-    glUseProgram(screen_shader);
-    glBindVertexArray(quad_vertex_array);
-    glDisable(GL_DEPTH_TEST);
-    glBindTexture(GL_TEXTURE_2D, framebuffer_texture);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    glUseProgram(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6*sizeof(float), (void*)0);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6*sizeof(float), (void*)(2*sizeof(float)));
+    gl_state.countCalls(3);
+
+    vertex_buffer_size = new_size;
+}
+
+void SimpleRenderer::growInternalElementBuffer(size_t minimum_capacity) noexcept
+{
+    SINI_PROFILE_SCOPE("SimpleRenderer::growInternalElementBuffer");
+    const size_t new_size = sizeGrowthFunction(element_buffer_size, minimum_capacity);
+    gl_state.bindArrayBuffer(element_buffer);
+    glBufferData(GL_ARRAY_BUFFER, new_size, NULL, GL_STREAM_DRAW);
+    gl_state.countCalls(1);
+    frame_stats.buffer_growths++;
+
+    element_buffer_size = new_size;
+}
+
+void SimpleRenderer::presentFramebuffer() noexcept
+{
+    // The framebuffer is blitted to the screen, rather than drawn as a
+    // textured quad, which lets the driver do a plain copy
+    const vec2i dims = framebuffer_dimensions;
+    gl_state.bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    gl_state.bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, dims.x, dims.y, 0, 0, dims.x, dims.y,
+        GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    gl_state.countCalls(1);
+    frame_stats.framebuffer_bytes_copied += 3 * uint64_t(dims.x) * uint64_t(dims.y);
 
     // Rebind internal framebuffer for future rendering
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-    glBindTexture(GL_TEXTURE_2D, framebuffer_texture);
+    gl_state.bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
 }
 
 
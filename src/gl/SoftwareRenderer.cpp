@@ -0,0 +1,480 @@
+#include <sini2D/gl/SoftwareRenderer.hpp>
+
+#include <sini2D/util/Profiler.hpp>
+#include <sini2D/util/ThreadPool.hpp>
+
+#include <algorithm>    // For std::min, std::max, std::clamp, std::fill, std::swap
+#include <cmath>        // For std::isfinite, std::llround, std::sqrt
+
+// The edge functions are exact integers, so unlike the float SIMD code paths
+// (see sini2D/math/Simd.hpp) SSE2 is used whenever available
+#if defined(__SSE2__) || defined(_M_X64)
+#define SINI_SOFTWARE_RENDERER_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace sini {
+
+// Helper functions
+// -----------------------------------------------------------------------------
+namespace {
+
+// Vertex positions are snapped to 1/16 pixel
+constexpr int subpixel_bits = 4;
+constexpr int64_t subpixels = 1 << subpixel_bits;
+// Vertices further off screen are clamped, which keeps all edge function
+// arithmetic within 64 bits
+constexpr float max_coordinate = float(1 << 22);
+
+// Edge values within a tile that fit in this range are evaluated with 32-bit
+// integers, also the differences between them
+constexpr int64_t int32_safe_limit = int64_t(1) << 30;
+
+uint8_t unorm8(float value) noexcept
+{
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+uint32_t packColor(const ColorVertex& vertex) noexcept
+{
+    return uint32_t(unorm8(vertex[2]))
+         | uint32_t(unorm8(vertex[3])) << 8
+         | uint32_t(unorm8(vertex[4])) << 16
+         | uint32_t(unorm8(vertex[5])) << 24;
+}
+
+int64_t toFixed(float coordinate) noexcept
+{
+    return std::llround(std::clamp(coordinate, -max_coordinate, max_coordinate)
+                        * float(subpixels));
+}
+
+// Source over destination with the source's alpha, rounded to nearest
+void blendPixel(uint32_t& destination, uint32_t color) noexcept
+{
+    const uint32_t alpha = color >> 24;
+    if (alpha == 255) {
+        destination = color;
+        return;
+    }
+    uint32_t result = 0;
+    for (int shift = 0; shift < 24; shift += 8) {
+        const uint32_t src = (color >> shift) & 0xFF,
+                       dst = (destination >> shift) & 0xFF;
+        result |= ((src * alpha + dst * (255 - alpha) + 127) / 255) << shift;
+    }
+    destination = result | 0xFF000000;
+}
+
+} // anonymous namespace
+
+
+// Constructors
+// -----------------------------------------------------------------------------
+SoftwareRenderer::SoftwareRenderer(vec2i dimensions, Camera camera)
+    : SoftwareRenderer(dimensions, camera, ThreadPool::shared())
+{}
+
+SoftwareRenderer::SoftwareRenderer(vec2i dimensions, Camera camera, ThreadPool& thread_pool)
+    : camera(camera),
+      framebuffer_dimensions(dimensions),
+      n_tiles((dimensions.x + tile_size - 1) / tile_size,
+              (dimensions.y + tile_size - 1) / tile_size),
+      thread_pool(thread_pool),
+      pixels(size_t(dimensions.x) * size_t(dimensions.y), 0xFF000000),
+      tile_bins(size_t(n_tiles.x) * size_t(n_tiles.y))
+{}
+
+
+// Member functions
+// -----------------------------------------------------------------------------
+void SoftwareRenderer::clear(vec4 clear_color)
+{
+    rasterizeQueue();
+    const uint32_t color = uint32_t(unorm8(clear_color[0]))
+                         | uint32_t(unorm8(clear_color[1])) << 8
+                         | uint32_t(unorm8(clear_color[2])) << 16
+                         | 0xFF000000;
+    std::fill(pixels.begin(), pixels.end(), color);
+}
+
+void SoftwareRenderer::drawPolygon(Polygon& polygon, vec3 color, float alpha)
+{
+    queue.drawPolygon(polygon, color, alpha);
+}
+
+void SoftwareRenderer::drawPolygonTriangleMesh(Polygon& polygon, vec3 color, float alpha)
+{
+    queue.drawPolygonTriangleMesh(polygon, color, alpha);
+}
+
+void SoftwareRenderer::fillPolygon(Polygon& polygon, vec3 color, float alpha)
+{
+    queue.fillPolygon(polygon, color, alpha);
+}
+
+void SoftwareRenderer::drawRectangle(vec2 bottom_left, vec2 upper_right, vec3 color,
+                                     float alpha)
+{
+    queue.drawRectangle(bottom_left, upper_right, color, alpha);
+}
+
+void SoftwareRenderer::fillRectangle(vec2 bottom_left, vec2 upper_right, vec3 color,
+                                     float alpha)
+{
+    queue.fillRectangle(bottom_left, upper_right, color, alpha);
+}
+
+void SoftwareRenderer::drawCircle(vec2 center, float radius, vec3 color, float alpha)
+{
+    queue.setPixelsPerUnit(pixelsPerUnit());
+    queue.drawCircle(center, radius, color, alpha);
+}
+
+void SoftwareRenderer::fillCircle(vec2 center, float radius, vec3 color, float alpha)
+{
+    queue.setPixelsPerUnit(pixelsPerUnit());
+    queue.fillCircle(center, radius, color, alpha);
+}
+
+void SoftwareRenderer::drawShape(Shape shape, const mat3& model_to_world, vec3 color,
+                                 float alpha)
+{
+    queue.drawShape(shape, model_to_world, color, alpha);
+}
+
+void SoftwareRenderer::fillShape(Shape shape, const mat3& model_to_world, vec3 color,
+                                 float alpha)
+{
+    queue.fillShape(shape, model_to_world, color, alpha);
+}
+
+void SoftwareRenderer::drawEllipse(vec2 center, vec2 radii, vec3 color, float alpha)
+{
+    queue.setPixelsPerUnit(pixelsPerUnit());
+    queue.drawEllipse(center, radii, color, alpha);
+}
+
+void SoftwareRenderer::fillEllipse(vec2 center, vec2 radii, vec3 color, float alpha)
+{
+    queue.setPixelsPerUnit(pixelsPerUnit());
+    queue.fillEllipse(center, radii, color, alpha);
+}
+
+void SoftwareRenderer::drawArc(vec2 center, float radius, float start_angle, float sweep,
+                               vec3 color, float alpha)
+{
+    queue.setPixelsPerUnit(pixelsPerUnit());
+    queue.drawArc(center, radius, start_angle, sweep, color, alpha);
+}
+
+void SoftwareRenderer::fillArc(vec2 center, float radius, float start_angle, float sweep,
+                               vec3 color, float alpha)
+{
+    queue.setPixelsPerUnit(pixelsPerUnit());
+    queue.fillArc(center, radius, start_angle, sweep, color, alpha);
+}
+
+void SoftwareRenderer::drawRoundedRectangle(vec2 bottom_left, vec2 upper_right,
+                                            float corner_radius, vec3 color, float alpha)
+{
+    queue.setPixelsPerUnit(pixelsPerUnit());
+    queue.drawRoundedRectangle(bottom_left, upper_right, corner_radius, color, alpha);
+}
+
+void SoftwareRenderer::fillRoundedRectangle(vec2 bottom_left, vec2 upper_right,
+                                            float corner_radius, vec3 color, float alpha)
+{
+    queue.setPixelsPerUnit(pixelsPerUnit());
+    queue.fillRoundedRectangle(bottom_left, upper_right, corner_radius, color, alpha);
+}
+
+void SoftwareRenderer::submit(const RenderCommandList& list)
+{
+    // The queue is also a command list, so rasterize it first to keep the
+    // order
+    rasterizeQueue();
+    setupTriangles(list);
+}
+
+void SoftwareRenderer::submit(const std::vector<RenderCommandList>& lists)
+{
+    rasterizeQueue();
+    for (const RenderCommandList& list : lists)
+        setupTriangles(list);
+}
+
+void SoftwareRenderer::updateScreen()
+{
+    rasterizeQueue();
+}
+
+void SoftwareRenderer::readPixels(uint8_t* rgb_out)
+{
+    rasterizeQueue();
+    for (uint32_t pixel : pixels) {
+        *rgb_out++ = static_cast<uint8_t>(pixel);
+        *rgb_out++ = static_cast<uint8_t>(pixel >> 8);
+        *rgb_out++ = static_cast<uint8_t>(pixel >> 16);
+    }
+}
+
+std::vector<uint8_t> SoftwareRenderer::readPixels()
+{
+    std::vector<uint8_t> rgb(3 * pixels.size());
+    readPixels(rgb.data());
+    return rgb;
+}
+
+
+// Private member functions
+// -----------------------------------------------------------------------------
+void SoftwareRenderer::setupTriangles(const RenderCommandList& list)
+{
+    // World to pixel coordinates, with y pointing down
+    const mat3 view = camera.worldToCameraViewMatrix();
+    const float half_width = 0.5f * float(framebuffer_dimensions.x),
+                half_height = 0.5f * float(framebuffer_dimensions.y);
+    const auto toScreen = [&](const ColorVertex& vertex) {
+        const float x = view.a * vertex[0] + view.b * vertex[1] + view.c,
+                    y = view.d * vertex[0] + view.e * vertex[1] + view.f;
+        return vec2((x + 1.0f) * half_width, (1.0f - y) * half_height);
+    };
+
+    for (const RenderCommandList::Batch& batch : list.batches) {
+        const ColorVertex* vertices = list.vertices.data() + batch.first_vertex;
+        const GLuint* elements = list.elements.data() + batch.first_element;
+        if (batch.triangles) {
+            for (size_t i = 0; i + 3 <= batch.n_elements; i += 3) {
+                const ColorVertex& v0 = vertices[elements[i]];
+                addTriangle(toScreen(v0), toScreen(vertices[elements[i+1]]),
+                            toScreen(vertices[elements[i+2]]), packColor(v0));
+            }
+        }
+        else {
+            for (size_t i = 0; i + 2 <= batch.n_elements; i += 2) {
+                const ColorVertex& v0 = vertices[elements[i]];
+                addLine(toScreen(v0), toScreen(vertices[elements[i+1]]), packColor(v0));
+            }
+        }
+    }
+}
+
+void SoftwareRenderer::addTriangle(vec2 p0, vec2 p1, vec2 p2, uint32_t color)
+{
+    if (!std::isfinite(p0.x + p0.y + p1.x + p1.y + p2.x + p2.y))
+        return;
+
+    int64_t x[3] = { toFixed(p0.x), toFixed(p1.x), toFixed(p2.x) },
+            y[3] = { toFixed(p0.y), toFixed(p1.y), toFixed(p2.y) };
+    // Orient all triangles the same way, so that the inside is where all
+    // edge functions are positive
+    const int64_t area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0)
+        return;
+    if (area < 0) {
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+    }
+
+    Triangle triangle;
+    // Pixels whose centers may be covered, i.e. conservatively rounded
+    const int64_t min_x = std::min({ x[0], x[1], x[2] }),
+                  max_x = std::max({ x[0], x[1], x[2] }),
+                  min_y = std::min({ y[0], y[1], y[2] }),
+                  max_y = std::max({ y[0], y[1], y[2] });
+    triangle.min_pixel = vec2i(int(std::max(min_x >> subpixel_bits, int64_t(0))),
+                               int(std::max(min_y >> subpixel_bits, int64_t(0))));
+    triangle.max_pixel =
+        vec2i(int(std::min(max_x >> subpixel_bits, int64_t(framebuffer_dimensions.x - 1))),
+              int(std::min(max_y >> subpixel_bits, int64_t(framebuffer_dimensions.y - 1))));
+    if (triangle.min_pixel.x > triangle.max_pixel.x
+        || triangle.min_pixel.y > triangle.max_pixel.y)
+        return;
+
+    for (int i = 0; i < 3; ++i) {
+        const int j = (i + 1) % 3;
+        const int64_t dx = x[j] - x[i],
+                      dy = y[j] - y[i];
+        // E(p) = dx * (p.y - y[i]) - dy * (p.x - x[i]), in subpixels
+        const int64_t a = -dy,
+                      b = dx,
+                      c = dy * x[i] - dx * y[i];
+        // Top-left fill rule: pixel centers exactly on an edge are only
+        // covered by the triangle to the right of or below the edge
+        const bool top_left = dy < 0 || (dy == 0 && dx > 0);
+        // Evaluated at pixel centers (x + 1/2, y + 1/2) with integer x and y
+        triangle.a[i] = a * subpixels;
+        triangle.b[i] = b * subpixels;
+        triangle.c[i] = c + (a + b) * (subpixels / 2) - (top_left ? 0 : 1);
+    }
+    triangle.color = color;
+
+    triangles.push_back(triangle);
+}
+
+void SoftwareRenderer::addLine(vec2 p0, vec2 p1, uint32_t color)
+{
+    // A quad one pixel wide, centered on the line
+    const vec2 direction = p1 - p0;
+    const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (!(length > 0.0f))
+        return;
+    const vec2 normal = vec2(-direction.y, direction.x) * (0.5f / length);
+    // The quad's diagonal is shared by two triangles, which the fill rule
+    // keeps from covering the same pixel twice
+    addTriangle(p0 + normal, p1 + normal, p1 - normal, color);
+    addTriangle(p0 + normal, p1 - normal, p0 - normal, color);
+}
+
+void SoftwareRenderer::rasterizeQueue()
+{
+    SINI_PROFILE_SCOPE("SoftwareRenderer::rasterizeQueue");
+    if (!queue.empty()) {
+        setupTriangles(queue);
+        queue.clear();
+    }
+    if (triangles.empty())
+        return;
+
+    // Bin in submission order, so that each tile draws its triangles in the
+    // same order
+    for (std::vector<uint32_t>& bin : tile_bins)
+        bin.clear();
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        const Triangle& triangle = triangles[i];
+        const vec2i min_tile = triangle.min_pixel / tile_size,
+                    max_tile = triangle.max_pixel / tile_size;
+        for (int tile_y = min_tile.y; tile_y <= max_tile.y; ++tile_y)
+            for (int tile_x = min_tile.x; tile_x <= max_tile.x; ++tile_x)
+                tile_bins[size_t(tile_y) * n_tiles.x + tile_x].push_back(uint32_t(i));
+    }
+
+    // Each tile owns its pixels, so the rows of tiles can be rasterized in any
+    // order without changing the result
+    thread_pool.parallelFor(size_t(n_tiles.y), [this](size_t tile_y) {
+        for (int tile_x = 0; tile_x < n_tiles.x; ++tile_x)
+            rasterizeTile(tile_x, int(tile_y));
+    });
+    triangles.clear();
+}
+
+void SoftwareRenderer::rasterizeTile(int tile_x, int tile_y) noexcept
+{
+    const std::vector<uint32_t>& bin = tile_bins[size_t(tile_y) * n_tiles.x + tile_x];
+    const int width = framebuffer_dimensions.x;
+
+    for (uint32_t index : bin) {
+        const Triangle& triangle = triangles[index];
+        // Pixels of the tile inside the triangle's bounding box
+        const int x0 = std::max(tile_x * tile_size, triangle.min_pixel.x),
+                  x1 = std::min(tile_x * tile_size + tile_size - 1, triangle.max_pixel.x),
+                  y0 = std::max(tile_y * tile_size, triangle.min_pixel.y),
+                  y1 = std::min(tile_y * tile_size + tile_size - 1, triangle.max_pixel.y);
+
+        // Classify the edges by their values at the corners of the box. Edges
+        // that are positive in the whole box need no per-pixel test.
+        int n_partial_edges = 0;
+        int partial_edges[3];
+        bool outside = false,
+             fits_int32 = true;
+        for (int i = 0; i < 3; ++i) {
+            const int64_t a = triangle.a[i],
+                          b = triangle.b[i],
+                          origin = a * x0 + b * y0 + triangle.c[i],
+                          max = origin + std::max(a, int64_t(0)) * (x1 - x0)
+                                       + std::max(b, int64_t(0)) * (y1 - y0),
+                          min = origin + std::min(a, int64_t(0)) * (x1 - x0)
+                                       + std::min(b, int64_t(0)) * (y1 - y0);
+            if (max < 0) {
+                outside = true;
+                break;
+            }
+            if (min < 0) {
+                partial_edges[n_partial_edges++] = i;
+                fits_int32 = fits_int32 && min >= -int32_safe_limit
+                                        && max < int32_safe_limit;
+            }
+        }
+        if (outside)
+            continue;
+
+        const int n_columns = x1 - x0 + 1;
+        const uint32_t all_columns = (1u << n_columns) - 1;
+        uint32_t* row = pixels.data() + size_t(y0) * width + x0;
+        if (n_partial_edges == 0) {
+            for (int y = y0; y <= y1; ++y, row += width)
+                for (int i = 0; i < n_columns; ++i)
+                    blendPixel(row[i], triangle.color);
+            continue;
+        }
+
+        if (fits_int32) {
+            // Edge values of the first row, one lane per column. Columns past
+            // the box repeat the last one, to stay within range.
+            int32_t row_values[3][tile_size],
+                    steps[3];
+            for (int e = 0; e < n_partial_edges; ++e) {
+                const int i = partial_edges[e];
+                const int64_t origin = triangle.a[i] * x0 + triangle.b[i] * y0 + triangle.c[i];
+                for (int column = 0; column < tile_size; ++column)
+                    row_values[e][column] = static_cast<int32_t>(
+                        origin + triangle.a[i] * std::min(column, n_columns - 1));
+                steps[e] = static_cast<int32_t>(triangle.b[i]);
+            }
+#ifdef SINI_SOFTWARE_RENDERER_SSE2
+            __m128i low[3], high[3], step[3];
+            for (int e = 0; e < n_partial_edges; ++e) {
+                low[e] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_values[e]));
+                high[e] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_values[e] + 4));
+                step[e] = _mm_set1_epi32(steps[e]);
+            }
+#endif
+            for (int y = y0; y <= y1; ++y, row += width) {
+                uint32_t covered = all_columns;
+#ifdef SINI_SOFTWARE_RENDERER_SSE2
+                // Sign bits of 8 columns, set where the edge is negative
+                for (int e = 0; e < n_partial_edges; ++e) {
+                    const int negative = _mm_movemask_ps(_mm_castsi128_ps(low[e]))
+                                       | _mm_movemask_ps(_mm_castsi128_ps(high[e])) << 4;
+                    covered &= ~uint32_t(negative);
+                    if (y < y1) {
+                        low[e] = _mm_add_epi32(low[e], step[e]);
+                        high[e] = _mm_add_epi32(high[e], step[e]);
+                    }
+                }
+#else
+                for (int e = 0; e < n_partial_edges; ++e) {
+                    for (int column = 0; column < n_columns; ++column)
+                        if (row_values[e][column] < 0)
+                            covered &= ~(1u << column);
+                    if (y < y1)
+                        for (int column = 0; column < tile_size; ++column)
+                            row_values[e][column] += steps[e];
+                }
+#endif
+                for (int column = 0; covered != 0; ++column, covered >>= 1)
+                    if (covered & 1)
+                        blendPixel(row[column], triangle.color);
+            }
+        }
+        else {
+            // Huge triangles, evaluated with 64 bits per pixel
+            for (int y = y0; y <= y1; ++y, row += width) {
+                for (int x = x0; x <= x1; ++x) {
+                    bool inside = true;
+                    for (int e = 0; e < n_partial_edges; ++e) {
+                        const int i = partial_edges[e];
+                        inside = inside
+                            && triangle.a[i] * x + triangle.b[i] * y + triangle.c[i] >= 0;
+                    }
+                    if (inside)
+                        blendPixel(row[x - x0], triangle.color);
+                }
+            }
+        }
+    }
+}
+
+} // namespace sini
@@ -0,0 +1,195 @@
+#include <sini2D/gl/StaticMesh.hpp>
+
+#include <sini2D/geometry/Polygon.hpp>
+
+#include <algorithm>    // For std::min, std::max
+#include <cstddef>      // For std::ptrdiff_t
+
+
+namespace sini {
+
+StaticMesh::~StaticMesh()
+{
+    if (vertex_array) glDeleteVertexArrays(1, &vertex_array);
+    if (vertex_buffer) glDeleteBuffers(1, &vertex_buffer);
+    if (element_buffer) glDeleteBuffers(1, &element_buffer);
+}
+
+
+// Member functions
+// -----------------------------------------------------------------------------
+size_t StaticMesh::addPolygon(Polygon& polygon, vec3 color, float alpha)
+{
+    if (!polygon.triangle_mesh)
+        polygon.buildTriangleMesh();
+
+    const Range range{ vertices.size(), polygon.vertices.size(),
+                       elements.size(), 3*polygon.triangle_mesh->size(),
+                       alpha < 1.0f };
+    vertices.resize(vertices.size() + range.n_vertices);
+    elements.resize(elements.size() + range.n_elements);
+    writePolygon(range, polygon, color, alpha);
+    ranges.push_back(range);
+    if (range.translucent) n_translucent_polygons++;
+
+    markDirty(range.first_vertex, vertices.size(), range.first_element, elements.size());
+    return ranges.size() - 1;
+}
+
+void StaticMesh::updatePolygon(size_t index, Polygon& polygon, vec3 color, float alpha)
+{
+    if (!polygon.triangle_mesh)
+        polygon.buildTriangleMesh();
+
+    Range& range = ranges[index];
+    if (range.translucent) n_translucent_polygons--;
+    range.translucent = alpha < 1.0f;
+    if (range.translucent) n_translucent_polygons++;
+
+    const size_t n_vertices = polygon.vertices.size(),
+                 n_elements = 3*polygon.triangle_mesh->size();
+    if (n_vertices == range.n_vertices && n_elements == range.n_elements) {
+        writePolygon(range, polygon, color, alpha);
+        markDirty(range.first_vertex, range.first_vertex + n_vertices,
+                  range.first_element, range.first_element + n_elements);
+        return;
+    }
+
+    // Resize the polygon's ranges and shift all polygons after it
+    const std::ptrdiff_t
+        vertex_shift = static_cast<std::ptrdiff_t>(n_vertices - range.n_vertices),
+        element_shift = static_cast<std::ptrdiff_t>(n_elements - range.n_elements);
+    const size_t old_vertices_end = range.first_vertex + range.n_vertices,
+                 old_elements_end = range.first_element + range.n_elements;
+    if (vertex_shift > 0)
+        vertices.insert(vertices.begin() + old_vertices_end, vertex_shift, Vertex());
+    else
+        vertices.erase(vertices.begin() + old_vertices_end + vertex_shift,
+                       vertices.begin() + old_vertices_end);
+    if (element_shift > 0)
+        elements.insert(elements.begin() + old_elements_end, element_shift, 0);
+    else
+        elements.erase(elements.begin() + old_elements_end + element_shift,
+                       elements.begin() + old_elements_end);
+
+    range.n_vertices = n_vertices;
+    range.n_elements = n_elements;
+    writePolygon(range, polygon, color, alpha);
+    for (size_t i = index + 1; i < ranges.size(); ++i) {
+        ranges[i].first_vertex += vertex_shift;
+        ranges[i].first_element += element_shift;
+    }
+    // Elements are absolute vertex indices
+    for (size_t i = range.first_element + n_elements; i < elements.size(); ++i)
+        elements[i] += static_cast<GLuint>(vertex_shift);
+
+    markDirty(range.first_vertex, vertices.size(), range.first_element, elements.size());
+}
+
+void StaticMesh::clear() noexcept
+{
+    vertices.clear();
+    elements.clear();
+    ranges.clear();
+    n_translucent_polygons = 0;
+    dirty_vertices_begin = dirty_vertices_end = 0;
+    dirty_elements_begin = dirty_elements_end = 0;
+}
+
+
+// Private member functions
+// -----------------------------------------------------------------------------
+void StaticMesh::writePolygon(const Range& range, const Polygon& polygon, vec3 color,
+                              float alpha) noexcept
+{
+    // Elements are absolute vertex indices
+    writeFilledPolygon(VertexCursor{ vertices.data() + range.first_vertex,
+                                     elements.data() + range.first_element,
+                                     static_cast<GLuint>(range.first_vertex) },
+                       polygon, color, alpha);
+}
+
+void StaticMesh::markDirty(size_t vertices_begin, size_t vertices_end,
+                           size_t elements_begin, size_t elements_end) noexcept
+{
+    // The dirty ranges are merged into one, which is good enough when only a
+    // few polygons change per frame
+    if (dirty_vertices_begin >= dirty_vertices_end) {
+        dirty_vertices_begin = vertices_begin;
+        dirty_vertices_end = vertices_end;
+    }
+    else {
+        dirty_vertices_begin = std::min(dirty_vertices_begin, vertices_begin);
+        dirty_vertices_end = std::max(dirty_vertices_end, vertices_end);
+    }
+    if (dirty_elements_begin >= dirty_elements_end) {
+        dirty_elements_begin = elements_begin;
+        dirty_elements_end = elements_end;
+    }
+    else {
+        dirty_elements_begin = std::min(dirty_elements_begin, elements_begin);
+        dirty_elements_end = std::max(dirty_elements_end, elements_end);
+    }
+}
+
+size_t StaticMesh::upload(GLStateCache& gl_state)
+{
+    if (!vertex_array) {
+        glGenVertexArrays(1, &vertex_array);
+        glGenBuffers(1, &vertex_buffer);
+        glGenBuffers(1, &element_buffer);
+
+        gl_state.bindVertexArray(vertex_array);
+        gl_state.bindArrayBuffer(vertex_buffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6*sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6*sizeof(float),
+            (void*)(2*sizeof(float)));
+        glEnableVertexAttribArray(1);
+        gl_state.countCalls(8);
+        // Not left bound, since the buffer name may be reused once the mesh
+        // is destroyed
+        gl_state.bindArrayBuffer(0);
+    }
+
+    // The buffers are written through GL_COPY_WRITE_BUFFER, which is not
+    // used for drawing
+    size_t bytes_uploaded = 0;
+    auto uploadRange = [&](GLuint buffer, size_t& capacity, const void* data,
+                           size_t size, size_t element_size, size_t& begin,
+                           size_t& end)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        if (size > capacity) {
+            // Reallocating loses the contents, so everything is uploaded
+            capacity = std::max(2*capacity, size);
+            glBufferData(GL_COPY_WRITE_BUFFER, capacity * element_size, NULL,
+                GL_STATIC_DRAW);
+            gl_state.countCalls(1);
+            begin = 0;
+            end = size;
+        }
+        // Polygons may have shrunk since the range was marked
+        end = std::min(end, size);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, begin * element_size,
+            (end - begin) * element_size,
+            static_cast<const char*>(data) + begin * element_size);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        gl_state.countCalls(3);
+        bytes_uploaded += (end - begin) * element_size;
+        begin = end = 0;
+    };
+
+    if (dirty_vertices_begin < dirty_vertices_end || vertices.size() > vertex_capacity) {
+        uploadRange(vertex_buffer, vertex_capacity, vertices.data(), vertices.size(),
+            sizeof(Vertex), dirty_vertices_begin, dirty_vertices_end);
+    }
+    if (dirty_elements_begin < dirty_elements_end || elements.size() > element_capacity) {
+        uploadRange(element_buffer, element_capacity, elements.data(), elements.size(),
+            sizeof(GLuint), dirty_elements_begin, dirty_elements_end);
+    }
+    return bytes_uploaded;
+}
+
+} // namespace sini
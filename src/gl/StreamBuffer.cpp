@@ -0,0 +1,172 @@
+#include <sini2D/gl/StreamBuffer.hpp>
+
+#include <sini2D/gl/OpenGlException.hpp>
+
+#include <algorithm>    // For std::max
+#include <cassert>
+
+
+namespace sini {
+
+StreamBuffer::StreamBuffer(size_t segment_size)
+    : StreamBuffer(segment_size, Mode::PERSISTENT_MAPPING)
+{}
+
+StreamBuffer::StreamBuffer(size_t segment_size, Mode mode)
+    : mapping_mode(mode),
+      segment_size(segment_size)
+{
+    // Fall back to orphaning if persistent mapping is not supported
+    if (mapping_mode == Mode::PERSISTENT_MAPPING && !GLEW_ARB_buffer_storage)
+        mapping_mode = Mode::ORPHANING;
+    allocate();
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    release();
+}
+
+
+// Member functions
+// -----------------------------------------------------------------------------
+void* StreamBuffer::map(size_t size, size_t alignment)
+{
+    // An empty range is treated as one byte, to keep the segment arithmetic
+    // simple and since zero-length mappings are not allowed
+    size = std::max(size, size_t(1));
+    if (size > segment_size) {
+        release();
+        while (segment_size < size)
+            segment_size *= 2;
+        allocate();
+    }
+
+    const size_t capacity = n_segments * segment_size;
+    size_t start = (head + alignment - 1) / alignment * alignment;
+    bool wrap_around = start + size > capacity;
+    if (wrap_around) start = 0;
+
+    mapped_offset = start;
+    head = start + size;
+
+    if (mapping_mode == Mode::PERSISTENT_MAPPING) {
+        // Wait for the GPU to be done with the segments that are entered,
+        // which were last written (and fenced after being drawn) a full ring
+        // ago
+        const size_t last_segment = (head - 1) / segment_size;
+        for (size_t segment = segment_of_last_write; segment != last_segment; ) {
+            segment = (segment + 1) % n_segments;
+            assert(!unfenced_segments[segment]);
+            waitForSegment(segment);
+        }
+        segment_of_last_write = last_segment;
+        return persistent_ptr + start;
+    }
+    else {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        if (wrap_around)
+            glBufferData(GL_COPY_WRITE_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+        void* ptr = glMapBufferRange(GL_COPY_WRITE_BUFFER, start, size,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        if (!ptr)
+            throw OpenGlException("Stream buffer could not be mapped");
+        return ptr;
+    }
+}
+
+void StreamBuffer::commit(size_t used_size) noexcept
+{
+    head = mapped_offset + used_size;
+    if (head > 0) segment_of_last_write = (head - 1) / segment_size;
+    if (used_size > 0) {
+        for (size_t segment = mapped_offset / segment_size;
+             segment <= segment_of_last_write; segment++)
+            unfenced_segments[segment] = true;
+    }
+
+    // Persistent mappings are coherent, so the data is already visible to
+    // subsequent draw calls
+    if (mapping_mode == Mode::ORPHANING) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+}
+
+
+void StreamBuffer::fence() noexcept
+{
+    if (mapping_mode != Mode::PERSISTENT_MAPPING)
+        return;
+    for (size_t segment = 0; segment < n_segments; segment++) {
+        if (unfenced_segments[segment]) fenceSegment(segment);
+        unfenced_segments[segment] = false;
+    }
+}
+
+
+// Private member functions
+// -----------------------------------------------------------------------------
+void StreamBuffer::allocate()
+{
+    const size_t capacity = n_segments * segment_size;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (mapping_mode == Mode::PERSISTENT_MAPPING) {
+        const GLbitfield flags =
+            GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, capacity, nullptr, flags);
+        persistent_ptr = static_cast<char*>(
+            glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, capacity, flags));
+        if (!persistent_ptr) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            throw OpenGlException("Stream buffer could not be mapped persistently");
+        }
+    }
+    else {
+        glBufferData(GL_COPY_WRITE_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    head = 0;
+    segment_of_last_write = 0;
+    unfenced_segments.fill(false);
+}
+
+void StreamBuffer::release() noexcept
+{
+    for (GLsync& fence : segment_fences) {
+        if (fence) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    // Deleting the buffer (which also unmaps it) is fine even if queued draws
+    // still use it, the driver keeps the memory alive until they're done
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+    persistent_ptr = nullptr;
+}
+
+void StreamBuffer::fenceSegment(size_t segment) noexcept
+{
+    if (segment_fences[segment]) glDeleteSync(segment_fences[segment]);
+    segment_fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamBuffer::waitForSegment(size_t segment) noexcept
+{
+    GLsync& fence = segment_fences[segment];
+    if (!fence) return;
+
+    // Flush on the first try, so that the fence is guaranteed to be signaled
+    // eventually
+    constexpr GLuint64 timeout_ns = 1000000000;
+    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_ns);
+    while (result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(fence, 0, timeout_ns);
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+} // namespace sini
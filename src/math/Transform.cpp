@@ -0,0 +1,90 @@
+#include <sini2D/math/Transform.hpp>
+
+#include <sini2D/util/ThreadPool.hpp>
+
+#include <algorithm>    // For std::min
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+
+namespace sini {
+
+namespace {
+// Large enough for the per-chunk overhead to be negligible, small enough to
+// balance the work between threads
+constexpr size_t points_per_chunk = 1 << 16;
+}
+
+void transformPoints(const mat3& transf, const vec2* in, vec2* out, size_t n) noexcept
+{
+    if (n == 0) return;
+    // vec2 arrays are tightly packed x0 y0 x1 y1 ..., so with each point's x
+    // and y duplicated to (x x) and (y y) one multiply-add step computes
+    // (a*x + b*y + c, d*x + e*y + f) for several points at once
+    const float* in_ = in->data();
+    float* out_ = out->data();
+    size_t i = 0;
+#if defined(__AVX__)
+    const __m256 ad = _mm256_setr_ps(transf.a, transf.d, transf.a, transf.d,
+                                     transf.a, transf.d, transf.a, transf.d),
+                 be = _mm256_setr_ps(transf.b, transf.e, transf.b, transf.e,
+                                     transf.b, transf.e, transf.b, transf.e),
+                 cf = _mm256_setr_ps(transf.c, transf.f, transf.c, transf.f,
+                                     transf.c, transf.f, transf.c, transf.f);
+    for (; i + 4 <= n; i += 4) {
+        const __m256 points = _mm256_loadu_ps(in_ + 2*i);
+        const __m256 xx = _mm256_permute_ps(points, _MM_SHUFFLE(2, 2, 0, 0)),
+                     yy = _mm256_permute_ps(points, _MM_SHUFFLE(3, 3, 1, 1));
+        _mm256_storeu_ps(out_ + 2*i, _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(ad, xx), _mm256_mul_ps(be, yy)), cf));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 ad = _mm_setr_ps(transf.a, transf.d, transf.a, transf.d),
+                 be = _mm_setr_ps(transf.b, transf.e, transf.b, transf.e),
+                 cf = _mm_setr_ps(transf.c, transf.f, transf.c, transf.f);
+    for (; i + 2 <= n; i += 2) {
+        const __m128 points = _mm_loadu_ps(in_ + 2*i);
+        const __m128 xx = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0)),
+                     yy = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+        _mm_storeu_ps(out_ + 2*i, _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(ad, xx), _mm_mul_ps(be, yy)), cf));
+    }
+#endif
+    for (; i < n; i++) {
+        const vec2 point = in[i];
+        out[i] = vec2(transf.a*point.x + transf.b*point.y + transf.c,
+                      transf.d*point.x + transf.e*point.y + transf.f);
+    }
+}
+
+void transformPoints(const mat3& transf, vec2* points, size_t n) noexcept
+{
+    transformPoints(transf, points, points, n);
+}
+
+void transformPoints(const mat3& transf, const vec2* in, vec2* out, size_t n,
+                     ThreadPool& thread_pool)
+{
+    const size_t n_chunks = (n + points_per_chunk - 1) / points_per_chunk;
+    if (n_chunks <= 1 || thread_pool.numThreads() == 0) {
+        transformPoints(transf, in, out, n);
+        return;
+    }
+    thread_pool.parallelFor(n_chunks, [&](size_t chunk) {
+        const size_t begin = chunk * points_per_chunk;
+        transformPoints(transf, in + begin, out + begin,
+                        std::min(points_per_chunk, n - begin));
+    });
+}
+
+void transformPoints(const mat3& transf, vec2* points, size_t n,
+                     ThreadPool& thread_pool)
+{
+    transformPoints(transf, points, points, n, thread_pool);
+}
+
+} // namespace sini
@@ -0,0 +1 @@
+#include <sini2D/math/VectorArray.hpp>
@@ -0,0 +1,151 @@
+#include <sini2D/util/Profiler.hpp>
+
+#include <algorithm>    // For std::min, std::max
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace sini {
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t begin_ns, end_ns;
+};
+
+// Ring of the scopes recorded by one thread. Kept alive by the registry after
+// the thread has finished.
+struct ThreadEvents {
+    std::unique_ptr<Event[]> events{ new Event[Profiler::events_per_thread] };
+    // Total number of scopes recorded, and recorded before the last clear().
+    // Only the owning thread writes to 'n_recorded'.
+    std::atomic<uint64_t> n_recorded{ 0 },
+                          n_cleared{ 0 };
+    std::atomic<const char*> name{ nullptr };
+    uint32_t id = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadEvents>> threads;
+};
+
+// Never destroyed, since threads may record scopes during static destruction
+Registry& registry()
+{
+    static Registry* const registry = new Registry();
+    return *registry;
+}
+
+ThreadEvents& threadEvents()
+{
+    thread_local const std::shared_ptr<ThreadEvents> events = []() {
+        auto events = std::make_shared<ThreadEvents>();
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock{ reg.mutex };
+        events->id = static_cast<uint32_t>(reg.threads.size());
+        reg.threads.push_back(events);
+        return events;
+    }();
+    return *events;
+}
+
+void writeJsonString(std::ostream& out, const char* str)
+{
+    out << '"';
+    for (; *str != '\0'; ++str) {
+        if (*str == '"' || *str == '\\') out << '\\' << *str;
+        else if (static_cast<unsigned char>(*str) < 0x20) out << ' ';
+        else out << *str;
+    }
+    out << '"';
+}
+
+// Microseconds with three decimals, independent of the stream's locale
+void writeMicroseconds(std::ostream& out, uint64_t ns)
+{
+    const uint64_t fraction = ns % 1000;
+    out << ns / 1000 << '.'
+        << static_cast<char>('0' + fraction / 100)
+        << static_cast<char>('0' + fraction / 10 % 10)
+        << static_cast<char>('0' + fraction % 10);
+}
+
+} // anonymous namespace
+
+
+void Profiler::record(const char* name, uint64_t begin_ns, uint64_t end_ns) noexcept
+{
+    ThreadEvents& thread = threadEvents();
+    const uint64_t n = thread.n_recorded.load(std::memory_order_relaxed);
+    thread.events[n % events_per_thread] = { name, begin_ns, end_ns };
+    thread.n_recorded.store(n + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const char* name) noexcept
+{
+    threadEvents().name.store(name, std::memory_order_relaxed);
+}
+
+void Profiler::writeChromeTrace(std::ostream& out)
+{
+    std::vector<std::shared_ptr<ThreadEvents>> threads;
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock{ reg.mutex };
+        threads = reg.threads;
+    }
+
+    // Range of recorded scopes still in each ring
+    std::vector<uint64_t> first(threads.size()), last(threads.size());
+    uint64_t start_ns = UINT64_MAX;
+    for (size_t t = 0; t < threads.size(); ++t) {
+        last[t] = threads[t]->n_recorded.load(std::memory_order_acquire);
+        first[t] = std::max(threads[t]->n_cleared.load(std::memory_order_relaxed),
+                            last[t] - std::min(last[t], uint64_t(events_per_thread)));
+        for (uint64_t i = first[t]; i < last[t]; ++i)
+            start_ns = std::min(start_ns, threads[t]->events[i % events_per_thread].begin_ns);
+    }
+
+    // Complete ("X") events, which the viewers nest by time, with timestamps
+    // relative to the first scope
+    out << "{\"traceEvents\":[";
+    bool first_event = true;
+    for (size_t t = 0; t < threads.size(); ++t) {
+        const ThreadEvents& thread = *threads[t];
+        if (const char* name = thread.name.load(std::memory_order_relaxed)) {
+            out << (first_event ? "\n" : ",\n")
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.id
+                << ",\"args\":{\"name\":";
+            writeJsonString(out, name);
+            out << "}}";
+            first_event = false;
+        }
+        for (uint64_t i = first[t]; i < last[t]; ++i) {
+            const Event& event = thread.events[i % events_per_thread];
+            out << (first_event ? "\n" : ",\n") << "{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.id << ",\"ts\":";
+            writeMicroseconds(out, event.begin_ns - start_ns);
+            out << ",\"dur\":";
+            writeMicroseconds(out, event.end_ns - event.begin_ns);
+            out << "}";
+            first_event = false;
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void Profiler::clear() noexcept
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock{ reg.mutex };
+    for (const std::shared_ptr<ThreadEvents>& thread : reg.threads)
+        thread->n_cleared.store(thread->n_recorded.load(std::memory_order_acquire),
+                                std::memory_order_relaxed);
+}
+
+} // namespace sini
@@ -0,0 +1,118 @@
+#include <sini2D/util/ThreadPool.hpp>
+
+#include <sini2D/util/Profiler.hpp>
+
+#include <algorithm>    // For std::max
+
+
+namespace sini {
+
+ThreadPool::ThreadPool(uint32_t n_threads)
+{
+    threads.reserve(n_threads);
+    for (uint32_t i = 0; i < n_threads; i++)
+        threads.emplace_back([this]() { workerLoop(); });
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        stopping = true;
+    }
+    job_available.notify_all();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+void ThreadPool::parallelFor(size_t n_tasks, const std::function<void(size_t)>& task)
+{
+    if (n_tasks == 0) return;
+    std::lock_guard<std::mutex> parallel_for_lock{ parallel_for_mutex };
+
+    Job job;
+    job.task = &task;
+    job.n_tasks = n_tasks;
+    job.remaining_tasks = n_tasks;
+    if (n_tasks > 1 && !threads.empty()) {
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            current_job = &job;
+            job_generation++;
+        }
+        job_available.notify_all();
+    }
+
+    runTasks(job);
+
+    {
+        // The job lives on this stack frame, so wait for the worker threads to
+        // also be done with it before returning
+        std::unique_lock<std::mutex> lock{ mutex };
+        job_done.wait(lock, [&job]() {
+            return job.remaining_tasks == 0 && job.n_participating_threads == 0;
+        });
+        current_job = nullptr;
+    }
+    if (job.exception)
+        std::rethrow_exception(job.exception);
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool shared_pool{
+        std::max(std::thread::hardware_concurrency(), 1u) - 1 };
+    return shared_pool;
+}
+
+void ThreadPool::workerLoop()
+{
+#ifdef SINI_PROFILE
+    Profiler::setThreadName("sini::ThreadPool worker");
+#endif
+    uint64_t seen_generation = 0;
+    while (true) {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock{ mutex };
+            job_available.wait(lock, [&]() {
+                return stopping || job_generation != seen_generation;
+            });
+            if (stopping) return;
+            seen_generation = job_generation;
+            // The job may already be finished by other threads
+            job = current_job;
+            if (!job) continue;
+            job->n_participating_threads++;
+        }
+
+        runTasks(*job);
+
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            job->n_participating_threads--;
+        }
+        job_done.notify_all();
+    }
+}
+
+void ThreadPool::runTasks(Job& job)
+{
+    SINI_PROFILE_SCOPE("ThreadPool::runTasks");
+    for (size_t i = job.next_task++; i < job.n_tasks; i = job.next_task++) {
+        try {
+            (*job.task)(i);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock{ mutex };
+            if (!job.exception) job.exception = std::current_exception();
+        }
+        if (--job.remaining_tasks == 0) {
+            // Lock to not notify between the waiting thread's check and wait
+            std::lock_guard<std::mutex> lock{ mutex };
+            job_done.notify_all();
+        }
+    }
+}
+
+} // namespace sini
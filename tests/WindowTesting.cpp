@@ -5,11 +5,13 @@
 #include <sini2D/sdl/SdlException.hpp>
 #include <sini2D/sdl/SubsystemInitializer.hpp>
 #include <sini2D/sdl/Window.hpp>
+#include <sini2D/util/Profiler.hpp>
 
 #include <GL/glew.h>
 
 #include <chrono>
 #include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <thread>
@@ -34,17 +36,21 @@ mat2 rot_mat(float angle)
 
 struct CommandLineOptions {
     bool display_frame_times;
+    // Chrome trace written on exit, if profiling is enabled
+    const char* trace_path;
 };
 
 CommandLineOptions parseCommandLine(int argc, char** argv)
 {
-    CommandLineOptions options = { false };
+    CommandLineOptions options = { false, nullptr };
     for (int argi = 1; argi < argc; ++argi) {
         if (std::strcmp(argv[argi], "-p") == 0
             || std::strcmp(argv[argi], "--print-frametimes") == 0)
         {
             options.display_frame_times = true;
         }
+        else if (std::strcmp(argv[argi], "--trace") == 0 && argi + 1 < argc)
+            options.trace_path = argv[++argi];
         else std::cout << "Ignoring unrecognised argument '" << argv[argi] << '\'' << std::endl;
     }
 
@@ -99,13 +105,17 @@ int main(int argc, char** argv)
         SDL_Event e;
         bool quit = false;
         while (!quit) {
-            while (SDL_PollEvent(&e)) {
-                if (e.type == SDL_QUIT)
-                    quit = true;
-                else if (e.type == SDL_KEYDOWN) {
-                    if (e.key.keysym.sym == SDLK_c &&
-                        e.key.keysym.mod & KMOD_CTRL)
+            SINI_PROFILE_SCOPE("Frame");
+            {
+                SINI_PROFILE_SCOPE("Event handling");
+                while (SDL_PollEvent(&e)) {
+                    if (e.type == SDL_QUIT)
                         quit = true;
+                    else if (e.type == SDL_KEYDOWN) {
+                        if (e.key.keysym.sym == SDLK_c &&
+                            e.key.keysym.mod & KMOD_CTRL)
+                            quit = true;
+                    }
                 }
             }
 
@@ -157,6 +167,15 @@ int main(int argc, char** argv)
             else if (options.display_frame_times)
                 std::cout << std::endl;
         }
+
+        if (options.trace_path != nullptr) {
+#ifdef SINI_PROFILE
+            std::ofstream trace{ options.trace_path };
+            Profiler::writeChromeTrace(trace);
+#else
+            std::cerr << "--trace requires building with SINI_2D_ENABLE_PROFILING" << std::endl;
+#endif
+        }
     }
     catch (const SdlException& e) {
         std::cerr << "SDL error:" << std::endl << e.what() << std::endl;
@@ -0,0 +1,222 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>    // For std::sort, std::max
+#include <chrono>
+#include <cmath>        // For std::sqrt, std::ceil
+#include <fstream>
+#include <iomanip>
+#include <locale>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace sini::bench {
+
+namespace {
+
+double elapsedNs(std::chrono::steady_clock::time_point start)
+{
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Time of 'n_runs' runs, in nanoseconds
+double timeRuns(const std::function<void()>& run, size_t n_runs)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n_runs; i++)
+        run();
+    return elapsedNs(start);
+}
+
+// Linear interpolation between the closest ranks of the sorted samples
+double percentile(const std::vector<double>& sorted, double p)
+{
+    const double pos = p * static_cast<double>(sorted.size() - 1);
+    const size_t below = static_cast<size_t>(pos);
+    if (below + 1 >= sorted.size())
+        return sorted.back();
+    const double fraction = pos - static_cast<double>(below);
+    return sorted[below] + fraction * (sorted[below + 1] - sorted[below]);
+}
+
+Result summarize(std::string name, size_t ops_per_run, size_t runs_per_sample,
+                 std::vector<double> samples)
+{
+    Result result;
+    result.name = std::move(name);
+    result.ops_per_run = ops_per_run;
+    result.runs_per_sample = runs_per_sample;
+    result.samples = samples.size();
+
+    std::sort(samples.begin(), samples.end());
+    result.min_ns = samples.front();
+    result.median_ns = percentile(samples, 0.5);
+    result.p95_ns = percentile(samples, 0.95);
+    result.p99_ns = percentile(samples, 0.99);
+    double sum = 0.0;
+    for (double sample : samples) sum += sample;
+    result.mean_ns = sum / static_cast<double>(samples.size());
+    double squares = 0.0;
+    for (double sample : samples)
+        squares += (sample - result.mean_ns) * (sample - result.mean_ns);
+    result.stddev_ns = samples.size() > 1
+        ? std::sqrt(squares / static_cast<double>(samples.size() - 1)) : 0.0;
+    return result;
+}
+
+// Time with a unit suitable for humans
+std::string formatTime(double ns)
+{
+    std::stringstream s;
+    s << std::fixed << std::setprecision(ns < 10.0 ? 2 : 1);
+    if (ns < 1e3)      s << ns << " ns";
+    else if (ns < 1e6) s << ns / 1e3 << " us";
+    else               s << ns / 1e6 << " ms";
+    return s.str();
+}
+
+constexpr int name_width = 54,
+              col_width = 12;
+
+} // anonymous namespace
+
+
+void Suite::add(std::string name, size_t ops_per_run, Setup setup)
+{
+    benchmarks.push_back({ std::move(name), std::max(ops_per_run, size_t(1)), std::move(setup) });
+}
+
+std::vector<Result> Suite::run(const Options& options, std::ostream& log) const
+{
+    log << std::left << std::setw(name_width) << "benchmark (time per operation)"
+        << std::right << std::setw(col_width) << "median"
+        << std::setw(col_width) << "p95"
+        << std::setw(col_width) << "p99"
+        << std::setw(col_width) << "stddev" << std::endl;
+
+    std::vector<Result> results;
+    for (const Benchmark& benchmark : benchmarks) {
+        if (benchmark.name.find(options.filter) == std::string::npos)
+            continue;
+        const std::function<void()> run = benchmark.setup();
+
+        // Enough runs per sample to take at least the minimum time, estimated
+        // from the first run, which also counts as warmup
+        const double first_run_ns = std::max(timeRuns(run, 1), 1.0);
+        const size_t runs_per_sample = static_cast<size_t>(
+            std::max(1.0, std::ceil(options.min_sample_ms * 1e6 / first_run_ns)));
+        for (int i = 0; i < options.warmup_samples; i++)
+            timeRuns(run, runs_per_sample);
+
+        std::vector<double> samples;
+        samples.reserve(options.samples);
+        const double ops_per_sample =
+            static_cast<double>(runs_per_sample * benchmark.ops_per_run);
+        for (int i = 0; i < std::max(options.samples, 1); i++)
+            samples.push_back(timeRuns(run, runs_per_sample) / ops_per_sample);
+
+        results.push_back(summarize(benchmark.name, benchmark.ops_per_run,
+                                    runs_per_sample, std::move(samples)));
+        const Result& result = results.back();
+        log << std::left << std::setw(name_width) << result.name
+            << std::right << std::setw(col_width) << formatTime(result.median_ns)
+            << std::setw(col_width) << formatTime(result.p95_ns)
+            << std::setw(col_width) << formatTime(result.p99_ns)
+            << std::setw(col_width) << formatTime(result.stddev_ns) << std::endl;
+    }
+    return results;
+}
+
+
+void writeJson(const std::vector<Result>& results, std::ostream& out)
+{
+    out.imbue(std::locale::classic());
+    out << std::setprecision(6);
+    out << "{\"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        out << (i == 0 ? "\n  " : ",\n  ")
+            << "{\"name\": \"" << r.name << "\""
+            << ", \"ops_per_run\": " << r.ops_per_run
+            << ", \"runs_per_sample\": " << r.runs_per_sample
+            << ", \"samples\": " << r.samples
+            << ", \"median_ns\": " << r.median_ns
+            << ", \"p95_ns\": " << r.p95_ns
+            << ", \"p99_ns\": " << r.p99_ns
+            << ", \"mean_ns\": " << r.mean_ns
+            << ", \"stddev_ns\": " << r.stddev_ns
+            << ", \"min_ns\": " << r.min_ns << "}";
+    }
+    out << "\n]}\n";
+}
+
+std::map<std::string, double> readBaselineMedians(const std::string& path)
+{
+    std::ifstream in{ path };
+    if (!in)
+        throw std::runtime_error("Could not open baseline file " + path);
+
+    // Benchmark names never contain quotes
+    const std::string name_key = "\"name\": \"",
+                      median_key = "\"median_ns\": ";
+    std::map<std::string, double> medians;
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t name_pos = line.find(name_key),
+                     median_pos = line.find(median_key);
+        if (name_pos == std::string::npos || median_pos == std::string::npos)
+            continue;
+        const size_t name_start = name_pos + name_key.size(),
+                     name_end = line.find('"', name_start);
+        std::istringstream median{ line.substr(median_pos + median_key.size()) };
+        median.imbue(std::locale::classic());
+        double median_ns;
+        if (name_end == std::string::npos || !(median >> median_ns))
+            throw std::runtime_error("Malformed benchmark in baseline file " + path);
+        medians[line.substr(name_start, name_end - name_start)] = median_ns;
+    }
+    if (medians.empty())
+        throw std::runtime_error("No benchmarks in baseline file " + path);
+    return medians;
+}
+
+int compareWithBaseline(const std::vector<Result>& results,
+                        const std::map<std::string, double>& baseline_medians,
+                        double threshold, std::ostream& out)
+{
+    out << std::left << std::setw(name_width) << "benchmark (median)"
+        << std::right << std::setw(col_width) << "baseline"
+        << std::setw(col_width) << "current"
+        << std::setw(col_width) << "change" << std::endl;
+
+    int n_regressions = 0;
+    for (const Result& result : results) {
+        out << std::left << std::setw(name_width) << result.name << std::right;
+        const auto baseline = baseline_medians.find(result.name);
+        if (baseline == baseline_medians.end()) {
+            out << std::setw(col_width) << "-"
+                << std::setw(col_width) << formatTime(result.median_ns)
+                << std::setw(col_width) << "new" << std::endl;
+            continue;
+        }
+        const double change = result.median_ns / baseline->second - 1.0;
+        std::stringstream percent;
+        percent << std::showpos << std::fixed << std::setprecision(1) << 100.0 * change << " %";
+        out << std::setw(col_width) << formatTime(baseline->second)
+            << std::setw(col_width) << formatTime(result.median_ns)
+            << std::setw(col_width) << percent.str();
+        if (change > threshold) {
+            out << "  REGRESSION";
+            n_regressions++;
+        }
+        else if (change < -threshold)
+            out << "  improved";
+        out << std::endl;
+    }
+    return n_regressions;
+}
+
+} // namespace sini::bench
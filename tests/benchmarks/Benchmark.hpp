@@ -0,0 +1,92 @@
+// Minimal benchmark harness for sini2D_Benchmarks. Each benchmark is timed
+// over a number of samples, after a few warmup samples, and each sample runs
+// the benchmark enough times to take at least a minimum time, so that the
+// clock resolution doesn't matter. Results are reported as time per
+// operation, where a run of a benchmark performs a given number of operations
+// (e.g. 1024 matrix multiplications, or one frame).
+#pragma once
+
+#include <cstddef>      // For std::size_t
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sini::bench {
+
+// Keeps the compiler from optimizing away the computation of 'value'
+template<typename T>
+inline void doNotOptimize(const T& value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+struct Options {
+    int warmup_samples = 3;
+    int samples = 30;
+    double min_sample_ms = 5.0;
+    // Only benchmarks whose names contain the filter are run
+    std::string filter;
+};
+
+// Time per operation, in nanoseconds, over the samples
+struct Result {
+    std::string name;
+    size_t ops_per_run = 1,
+           runs_per_sample = 1,
+           samples = 0;
+    double median_ns = 0.0,
+           p95_ns = 0.0,
+           p99_ns = 0.0,
+           mean_ns = 0.0,
+           stddev_ns = 0.0,
+           min_ns = 0.0;
+};
+
+class Suite {
+public:
+    // Prepares the data of a benchmark, and returns the function doing one run.
+    // Only called if the benchmark is selected, right before it's timed, and
+    // the returned function is destroyed right after.
+    using Setup = std::function<std::function<void()>()>;
+
+    void add(std::string name, size_t ops_per_run, Setup setup);
+    // Runs the selected benchmarks in the order they were added, printing each
+    // result as it's done
+    std::vector<Result> run(const Options& options, std::ostream& log) const;
+
+private:
+    struct Benchmark {
+        std::string name;
+        size_t ops_per_run;
+        Setup setup;
+    };
+    std::vector<Benchmark> benchmarks;
+};
+
+// The benchmarks of each module
+void addMathBenchmarks(Suite& suite);
+void addGeometryBenchmarks(Suite& suite);
+void addRenderingBenchmarks(Suite& suite);
+
+// One benchmark per line, so that the files diff well
+void writeJson(const std::vector<Result>& results, std::ostream& out);
+// Median times by name, from a file written by writeJson(). Throws
+// std::runtime_error if it can't be read.
+std::map<std::string, double> readBaselineMedians(const std::string& path);
+
+// Prints the change of each median compared to the baseline, and returns the
+// number of benchmarks slower than the baseline by more than 'threshold'
+// (a fraction, e.g. 0.1 for 10 %)
+int compareWithBaseline(const std::vector<Result>& results,
+                        const std::map<std::string, double>& baseline_medians,
+                        double threshold, std::ostream& out);
+
+} // namespace sini::bench
@@ -0,0 +1,100 @@
+// Benchmarks of the math, geometry and rendering code, for catching
+// performance regressions between releases. Results can be written as JSON,
+// and compared with an earlier run:
+//
+//     sini2D_Benchmarks --json before.json
+//     (change things)
+//     sini2D_Benchmarks --baseline before.json
+//
+// The exit code is 2 if a benchmark got slower than the baseline by more than
+// the threshold. The OpenGL renderer is only benchmarked when built with
+// SINI_2D_ENABLE_HEADLESS.
+#include "Benchmark.hpp"
+
+#include <cstdlib>      // For std::atof, std::atoi
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+
+using namespace sini::bench;
+
+namespace {
+
+void printUsage()
+{
+    std::cout
+        << "Usage: sini2D_Benchmarks [options]\n"
+           "  --filter <text>       Only run benchmarks whose names contain <text>\n"
+           "  --samples <n>         Timed samples per benchmark (default 30)\n"
+           "  --warmup <n>          Untimed samples before them (default 3)\n"
+           "  --min-sample-ms <ms>  Minimum time of a sample (default 5)\n"
+           "  --json <file>         Write the results as JSON\n"
+           "  --baseline <file>     Compare the medians with an earlier --json file\n"
+           "  --threshold <frac>    Slowdown counted as a regression (default 0.1)\n";
+}
+
+} // anonymous namespace
+
+
+int main(int argc, char** argv)
+{
+    Options options;
+    const char* json_path = nullptr;
+    const char* baseline_path = nullptr;
+    double threshold = 0.1;
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && has_value)
+            options.filter = argv[++i];
+        else if (std::strcmp(argv[i], "--samples") == 0 && has_value)
+            options.samples = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--warmup") == 0 && has_value)
+            options.warmup_samples = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--min-sample-ms") == 0 && has_value)
+            options.min_sample_ms = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--json") == 0 && has_value)
+            json_path = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && has_value)
+            baseline_path = argv[++i];
+        else if (std::strcmp(argv[i], "--threshold") == 0 && has_value)
+            threshold = std::atof(argv[++i]);
+        else {
+            printUsage();
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    try {
+        // Read first, to not run all benchmarks only to fail afterwards
+        std::map<std::string, double> baseline_medians;
+        if (baseline_path != nullptr)
+            baseline_medians = readBaselineMedians(baseline_path);
+
+        Suite suite;
+        addMathBenchmarks(suite);
+        addGeometryBenchmarks(suite);
+        addRenderingBenchmarks(suite);
+        const std::vector<Result> results = suite.run(options, std::cout);
+
+        if (json_path != nullptr) {
+            std::ofstream json{ json_path };
+            writeJson(results, json);
+            if (!json)
+                throw std::runtime_error(std::string("Could not write ") + json_path);
+        }
+        if (baseline_path != nullptr) {
+            std::cout << std::endl;
+            if (compareWithBaseline(results, baseline_medians, threshold, std::cout) > 0)
+                return 2;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "Benchmark.hpp"
+
+#include <sini2D/geometry/Line.hpp>
+#include <sini2D/geometry/Polygon.hpp>
+#include <sini2D/geometry/Triangulation.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using namespace sini;
+
+namespace sini::bench {
+
+namespace {
+
+constexpr size_t n_queries = 1024;
+
+// Star-shaped polygon with random radii, making roughly half of the vertices
+// reflex (as in TriangulationBenchmark)
+std::vector<vec2> generateStarPolygon(int n_vertices, std::default_random_engine& rand_engine)
+{
+    std::uniform_real_distribution<float> radius_dist{ 0.5f, 1.0f };
+    std::vector<vec2> vertices;
+    vertices.reserve(n_vertices);
+    constexpr float two_pi = 2.0f * 3.1415926535f;
+    for (int i = 0; i < n_vertices; i++) {
+        const float angle = two_pi * i / n_vertices,
+                    radius = radius_dist(rand_engine);
+        vertices.push_back(radius * vec2(std::cos(angle), std::sin(angle)));
+    }
+    return vertices;
+}
+
+std::vector<vec2> randomPoints(size_t n, std::default_random_engine& rand_engine)
+{
+    std::uniform_real_distribution<float> dist{ -1.0f, 1.0f };
+    std::vector<vec2> points(n);
+    for (vec2& point : points)
+        point = vec2(dist(rand_engine), dist(rand_engine));
+    return points;
+}
+
+struct PolygonQueries {
+    Polygon polygon;
+    std::vector<vec2> points;
+    std::vector<float> xs, ys;
+
+    PolygonQueries(int n_vertices)
+        : polygon(std::vector<vec2>())
+    {
+        std::default_random_engine rand_engine{ 10476 };
+        polygon.vertices = generateStarPolygon(n_vertices, rand_engine);
+        points = randomPoints(n_queries, rand_engine);
+        for (vec2 point : points) {
+            xs.push_back(point.x);
+            ys.push_back(point.y);
+        }
+    }
+};
+
+} // anonymous namespace
+
+
+void addGeometryBenchmarks(Suite& suite)
+{
+    // Per pair of lines
+    const auto segments = []() {
+        std::default_random_engine rand_engine{ 10476 };
+        return std::make_shared<const std::vector<vec2>>(randomPoints(2 * n_queries, rand_engine));
+    };
+    suite.add("geometry/intersect(LineSegment, LineSegment)", n_queries, [segments]() {
+        return [p = segments()]() {
+            const std::vector<vec2>& points = *p;
+            for (size_t i = 0, j = n_queries - 1; i < n_queries; j = i++)
+                doNotOptimize(intersect(LineSegment(points[2*i], points[2*i + 1]),
+                                        LineSegment(points[2*j], points[2*j + 1])));
+        };
+    });
+    suite.add("geometry/intersection(LineSegment, LineSegment)", n_queries, [segments]() {
+        return [p = segments()]() {
+            const std::vector<vec2>& points = *p;
+            for (size_t i = 0, j = n_queries - 1; i < n_queries; j = i++)
+                doNotOptimize(intersection(LineSegment(points[2*i], points[2*i + 1]),
+                                           LineSegment(points[2*j], points[2*j + 1])));
+        };
+    });
+    suite.add("geometry/intersection(Line, Line)", n_queries, [segments]() {
+        return [p = segments()]() {
+            const std::vector<vec2>& points = *p;
+            for (size_t i = 0, j = n_queries - 1; i < n_queries; j = i++)
+                doNotOptimize(intersection(Line(points[2*i], points[2*i + 1]),
+                                           Line(points[2*j], points[2*j + 1])));
+        };
+    });
+
+    // Per point
+    for (int n_vertices : { 16, 256 }) {
+        const std::string suffix = " (" + std::to_string(n_vertices) + " vertices)";
+        suite.add("geometry/Polygon::envelops" + suffix, n_queries, [n_vertices]() {
+            return [q = std::make_shared<const PolygonQueries>(n_vertices)]() {
+                for (vec2 point : q->points)
+                    doNotOptimize(q->polygon.envelops(point));
+            };
+        });
+        suite.add("geometry/Polygon::envelopsBatch" + suffix, n_queries, [n_vertices]() {
+            auto q = std::make_shared<const PolygonQueries>(n_vertices);
+            auto out = std::make_shared<std::vector<uint8_t>>(n_queries);
+            return [q, out]() {
+                q->polygon.envelopsBatch(q->xs.data(), q->ys.data(), n_queries, out->data());
+                doNotOptimize(out->front());
+            };
+        });
+        suite.add("geometry/PreparedPolygon::envelops" + suffix, n_queries, [n_vertices]() {
+            auto q = std::make_shared<const PolygonQueries>(n_vertices);
+            auto prepared = std::make_shared<const PreparedPolygon>(q->polygon);
+            return [q, prepared]() {
+                for (vec2 point : q->points)
+                    doNotOptimize(prepared->envelops(point));
+            };
+        });
+    }
+
+    // Per polygon
+    for (int n_vertices : { 10, 100, 1000, 10000 }) {
+        const std::string suffix = " (" + std::to_string(n_vertices) + " vertices)";
+        suite.add("geometry/triangulate" + suffix, 1, [n_vertices]() -> std::function<void()> {
+            std::default_random_engine rand_engine{ 10476 };
+            auto vertices = std::make_shared<const std::vector<vec2>>(
+                generateStarPolygon(n_vertices, rand_engine));
+            return [vertices]() {
+                doNotOptimize(triangulate(*vertices).front());
+            };
+        });
+        // Hits in the shared triangulation cache
+        suite.add("geometry/Polygon::buildTriangleMesh, cached" + suffix, 1,
+                  [n_vertices]() -> std::function<void()> {
+            std::default_random_engine rand_engine{ 10476 };
+            auto polygon = std::make_shared<Polygon>(generateStarPolygon(n_vertices, rand_engine));
+            return [polygon]() {
+                polygon->buildTriangleMesh();
+                doNotOptimize(polygon->triangle_mesh->front());
+            };
+        });
+    }
+}
+
+} // namespace sini::bench
@@ -0,0 +1,102 @@
+#include "Benchmark.hpp"
+
+#include <sini2D/math/Matrix.hpp>
+#include <sini2D/math/VectorArray.hpp>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+
+using namespace sini;
+
+namespace sini::bench {
+
+namespace {
+
+constexpr size_t n_operands = 1024;
+
+// Random operands, the same in every run of the benchmarks
+struct Operands {
+    std::vector<vec2> vec2s = std::vector<vec2>(n_operands);
+    std::vector<vec3> vec3s = std::vector<vec3>(n_operands);
+    std::vector<vec4> vec4s = std::vector<vec4>(n_operands);
+    std::vector<mat3> mat3s = std::vector<mat3>(n_operands);
+    std::vector<mat4> mat4s = std::vector<mat4>(n_operands);
+
+    Operands()
+    {
+        std::default_random_engine rand_engine{ 2207 };
+        std::uniform_real_distribution<float> dist{ -1.0f, 1.0f };
+        for (size_t i = 0; i < n_operands; i++) {
+            for (int j = 0; j < 2; j++) vec2s[i][j] = dist(rand_engine);
+            for (int j = 0; j < 3; j++) vec3s[i][j] = dist(rand_engine);
+            for (int j = 0; j < 4; j++) vec4s[i][j] = dist(rand_engine);
+            for (int j = 0; j < 9; j++) mat3s[i].data()[j] = dist(rand_engine);
+            for (int j = 0; j < 16; j++) mat4s[i].data()[j] = dist(rand_engine);
+        }
+    }
+};
+
+// Benchmark of 'operation(operands, i, j)' for n_operands pairs of operands
+template<typename Operation>
+Suite::Setup operandsBenchmark(Operation operation)
+{
+    return [operation]() -> std::function<void()> {
+        auto operands = std::make_shared<const Operands>();
+        return [operands, operation]() {
+            for (size_t i = 0; i < n_operands; i++)
+                doNotOptimize(operation(*operands, i, n_operands - 1 - i));
+        };
+    };
+}
+
+} // anonymous namespace
+
+
+void addMathBenchmarks(Suite& suite)
+{
+    suite.add("math/vec2 + vec2", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t j) { return o.vec2s[i] + o.vec2s[j]; }));
+    suite.add("math/dot(vec4, vec4)", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t j) { return dot(o.vec4s[i], o.vec4s[j]); }));
+    suite.add("math/normalize(vec4)", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t) { return normalize(o.vec4s[i]); }));
+    suite.add("math/mat3 * vec3", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t j) { return o.mat3s[i] * o.vec3s[j]; }));
+    suite.add("math/mat3 * mat3", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t j) { return o.mat3s[i] * o.mat3s[j]; }));
+    suite.add("math/mat4 * vec4", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t j) { return o.mat4s[i] * o.vec4s[j]; }));
+    suite.add("math/mat4 * mat4", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t j) { return o.mat4s[i] * o.mat4s[j]; }));
+    suite.add("math/det(mat3)", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t) { return det(o.mat3s[i]); }));
+    suite.add("math/det(mat4)", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t) { return det(o.mat4s[i]); }));
+    suite.add("math/inverse(mat3)", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t) { return inverse(o.mat3s[i]); }));
+    suite.add("math/inverse(mat4)", n_operands, operandsBenchmark(
+        [](const Operands& o, size_t i, size_t) { return inverse(o.mat4s[i]); }));
+
+    // Per point
+    constexpr size_t n_points = 1 << 16;
+    suite.add("math/eqTransform(Vec2Array, affine mat3)", n_points, []() -> std::function<void()> {
+        std::default_random_engine rand_engine{ 2207 };
+        std::uniform_real_distribution<float> dist{ -1.0f, 1.0f };
+        std::vector<vec2> points(n_points);
+        for (vec2& point : points)
+            point = vec2(dist(rand_engine), dist(rand_engine));
+        auto point_array = std::make_shared<Vec2Array>(points);
+        // A rotation, so that the points stay bounded over many runs
+        const mat3 affine{{ 0.8f, -0.6f,  0.0f },
+                          { 0.6f,  0.8f,  0.0f },
+                          { 0.0f,  0.0f,  1.0f }};
+        return [point_array, affine]() {
+            eqTransform(*point_array, affine);
+            doNotOptimize(point_array->x()[0]);
+        };
+    });
+}
+
+} // namespace sini::bench
@@ -0,0 +1,250 @@
+#include "Benchmark.hpp"
+
+#include <sini2D/geometry/Polygon.hpp>
+#include <sini2D/gl/Camera.hpp>
+#include <sini2D/gl/RenderCommandList.hpp>
+#include <sini2D/gl/SoftwareRenderer.hpp>
+#ifdef SINI_HEADLESS
+#include <sini2D/gl/SimpleRenderer.hpp>
+
+#include <GL/glew.h>
+#endif
+
+#include <algorithm>    // For std::clamp
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+using namespace sini;
+
+namespace sini::bench {
+
+namespace {
+
+const vec2i frame_dimensions{ 800, 800 };
+constexpr size_t n_shapes = 10000;
+
+// Random shapes within the view of the camera, [-1, 1] in x and y
+struct Scene {
+    struct Shape {
+        vec2 position;
+        float size;
+        vec3 color;
+    };
+    std::vector<Shape> shapes;
+    std::vector<Polygon> polygons;
+
+    Scene()
+    {
+        std::default_random_engine rand_engine{ 10476 };
+        std::uniform_real_distribution<float> position_dist{ -1.0f, 1.0f },
+                                              size_dist{ 0.002f, 0.02f },
+                                              color_dist{ 0.0f, 1.0f };
+        shapes.resize(n_shapes);
+        for (Shape& shape : shapes) {
+            shape.position = vec2(position_dist(rand_engine), position_dist(rand_engine));
+            shape.size = size_dist(rand_engine);
+            shape.color = vec3(color_dist(rand_engine), color_dist(rand_engine),
+                               color_dist(rand_engine));
+        }
+        // Concave, and triangulated once up front
+        for (size_t i = 0; i < n_shapes / 10; i++) {
+            const vec2 p = shapes[i].position;
+            const float s = 2.0f * shapes[i].size;
+            polygons.push_back(Polygon{ p, p + vec2(s, 0.0f), p + vec2(0.5f*s, 0.5f*s),
+                                        p + vec2(s, s), p + vec2(0.0f, s) });
+            polygons.back().buildTriangleMesh();
+        }
+    }
+};
+
+enum class Shapes {
+    FILLED_RECTANGLES, RECTANGLE_OUTLINES, FILLED_CIRCLES, ADAPTIVE_CIRCLES,
+    ROTATED_SQUARES, POLYGONS
+};
+
+// Works with any of the renderers, or a RenderCommandList
+template<typename Renderer>
+void drawScene(Renderer& renderer, Scene& scene, Shapes shapes)
+{
+    switch (shapes) {
+    case Shapes::FILLED_RECTANGLES:
+        for (const Scene::Shape& s : scene.shapes)
+            renderer.fillRectangle(s.position, s.position + vec2(s.size), s.color, 1.0f);
+        break;
+    case Shapes::RECTANGLE_OUTLINES:
+        for (const Scene::Shape& s : scene.shapes)
+            renderer.drawRectangle(s.position, s.position + vec2(s.size), s.color, 1.0f);
+        break;
+    case Shapes::FILLED_CIRCLES:
+        for (const Scene::Shape& s : scene.shapes)
+            renderer.fillCircle(s.position, s.size, s.color, 1.0f);
+        break;
+    case Shapes::ADAPTIVE_CIRCLES:
+        for (const Scene::Shape& s : scene.shapes)
+            renderer.fillEllipse(s.position, vec2(s.size), s.color, 1.0f);
+        break;
+    case Shapes::ROTATED_SQUARES:
+        for (size_t i = 0; i < scene.shapes.size(); i++) {
+            const Scene::Shape& s = scene.shapes[i];
+            const float angle = 0.1f * i,
+                        c = s.size * std::cos(angle),
+                        d = s.size * std::sin(angle);
+            const mat3 model_to_world = {{ c, -d, s.position.x },
+                                         { d,  c, s.position.y },
+                                         { 0.0f, 0.0f, 1.0f }};
+            renderer.fillShape(Shape::SQUARE, model_to_world, s.color, 1.0f);
+        }
+        break;
+    case Shapes::POLYGONS:
+        for (size_t i = 0; i < scene.polygons.size(); i++)
+            renderer.fillPolygon(scene.polygons[i], scene.shapes[i].color, 0.5f);
+        break;
+    }
+}
+
+Camera sceneCamera()
+{
+    return Camera({ 0.0f, 0.0f }, 1.0f, 2.0f);
+}
+
+// Per frame, drawing and rasterizing the scene
+Suite::Setup softwareFrame(Shapes shapes)
+{
+    return [shapes]() -> std::function<void()> {
+        auto scene = std::make_shared<Scene>();
+        auto renderer = std::make_shared<SoftwareRenderer>(frame_dimensions, sceneCamera());
+        return [scene, renderer, shapes]() {
+            renderer->clear();
+            drawScene(*renderer, *scene, shapes);
+            renderer->updateScreen();
+        };
+    };
+}
+
+#ifdef SINI_HEADLESS
+// Per frame, including waiting for the GPU (often llvmpipe, on CI machines)
+// to finish it
+Suite::Setup openGlFrame(Shapes shapes, RenderSettings settings)
+{
+    return [shapes, settings]() -> std::function<void()> {
+        auto scene = std::make_shared<Scene>();
+        auto renderer = std::make_shared<SimpleRenderer>(frame_dimensions, sceneCamera(),
+                                                         settings);
+        return [scene, renderer, shapes]() {
+            renderer->clear();
+            drawScene(*renderer, *scene, shapes);
+            renderer->updateScreen();
+            glFinish();
+        };
+    };
+}
+
+// Same as openGlFrame(Shapes::FILLED_CIRCLES, ...), with SDF circles
+Suite::Setup openGlSdfCirclesFrame()
+{
+    return []() -> std::function<void()> {
+        auto scene = std::make_shared<Scene>();
+        auto renderer = std::make_shared<SimpleRenderer>(frame_dimensions, sceneCamera());
+        return [scene, renderer]() {
+            renderer->clear();
+            for (const Scene::Shape& s : scene->shapes)
+                renderer->fillSdfCircle(s.position, s.size, s.color, 1.0f);
+            renderer->updateScreen();
+            glFinish();
+        };
+    };
+}
+
+// Thick polyline of 100k segments, a random walk within the view, with round
+// joins and caps
+Suite::Setup openGlPolylineFrame()
+{
+    return []() -> std::function<void()> {
+        constexpr size_t n_segments = 100000;
+        auto points = std::make_shared<std::vector<vec2>>(n_segments + 1);
+        std::default_random_engine rand_engine{ 10476 };
+        std::uniform_real_distribution<float> step_dist{ -0.02f, 0.02f };
+        vec2 point{ 0.0f, 0.0f };
+        for (vec2& p : *points) {
+            point += vec2(step_dist(rand_engine), step_dist(rand_engine));
+            point.x = std::clamp(point.x, -1.0f, 1.0f);
+            point.y = std::clamp(point.y, -1.0f, 1.0f);
+            p = point;
+        }
+        auto renderer = std::make_shared<SimpleRenderer>(frame_dimensions, sceneCamera());
+        const LineStyle style{ 0.005f, LineJoin::ROUND, LineCap::ROUND };
+        return [points, renderer, style]() {
+            renderer->clear();
+            renderer->drawPolyline(*points, style, { 1.0f, 1.0f, 1.0f }, 1.0f);
+            renderer->updateScreen();
+            glFinish();
+        };
+    };
+}
+#endif
+
+} // anonymous namespace
+
+
+void addRenderingBenchmarks(Suite& suite)
+{
+    // Per shape
+    suite.add("render/RenderCommandList record 10k rects", n_shapes,
+              []() -> std::function<void()> {
+        auto scene = std::make_shared<Scene>();
+        auto list = std::make_shared<RenderCommandList>();
+        return [scene, list]() {
+            list->clear();
+            drawScene(*list, *scene, Shapes::FILLED_RECTANGLES);
+            doNotOptimize(list->numVertices());
+        };
+    });
+
+    suite.add("render/SoftwareRenderer 10k filled rects", 1,
+              softwareFrame(Shapes::FILLED_RECTANGLES));
+    suite.add("render/SoftwareRenderer 10k rect outlines", 1,
+              softwareFrame(Shapes::RECTANGLE_OUTLINES));
+    suite.add("render/SoftwareRenderer 10k filled circles", 1,
+              softwareFrame(Shapes::FILLED_CIRCLES));
+    suite.add("render/SoftwareRenderer 10k filled circles, adaptive detail", 1,
+              softwareFrame(Shapes::ADAPTIVE_CIRCLES));
+    suite.add("render/SoftwareRenderer 10k rotated squares", 1,
+              softwareFrame(Shapes::ROTATED_SQUARES));
+    suite.add("render/SoftwareRenderer 1k polygons", 1,
+              softwareFrame(Shapes::POLYGONS));
+
+#ifdef SINI_HEADLESS
+    RenderSettings instanced;
+    instanced.instanced_shapes = true;
+    RenderSettings ring_buffer;
+    ring_buffer.vertex_streaming = VertexStreaming::RING_BUFFER;
+
+    suite.add("render/SimpleRenderer 10k filled rects", 1,
+              openGlFrame(Shapes::FILLED_RECTANGLES, RenderSettings()));
+    suite.add("render/SimpleRenderer 10k filled rects, ring buffer", 1,
+              openGlFrame(Shapes::FILLED_RECTANGLES, ring_buffer));
+    suite.add("render/SimpleRenderer 10k filled rects, instanced", 1,
+              openGlFrame(Shapes::FILLED_RECTANGLES, instanced));
+    suite.add("render/SimpleRenderer 10k rect outlines", 1,
+              openGlFrame(Shapes::RECTANGLE_OUTLINES, RenderSettings()));
+    suite.add("render/SimpleRenderer 10k filled circles", 1,
+              openGlFrame(Shapes::FILLED_CIRCLES, RenderSettings()));
+    suite.add("render/SimpleRenderer 10k filled circles, instanced", 1,
+              openGlFrame(Shapes::FILLED_CIRCLES, instanced));
+    suite.add("render/SimpleRenderer 10k filled circles, adaptive detail", 1,
+              openGlFrame(Shapes::ADAPTIVE_CIRCLES, RenderSettings()));
+    suite.add("render/SimpleRenderer 10k filled circles, SDF", 1, openGlSdfCirclesFrame());
+    suite.add("render/SimpleRenderer 10k rotated squares", 1,
+              openGlFrame(Shapes::ROTATED_SQUARES, RenderSettings()));
+    suite.add("render/SimpleRenderer 10k rotated squares, instanced", 1,
+              openGlFrame(Shapes::ROTATED_SQUARES, instanced));
+    suite.add("render/SimpleRenderer 1k polygons", 1,
+              openGlFrame(Shapes::POLYGONS, RenderSettings()));
+    suite.add("render/SimpleRenderer 100k-segment polyline", 1, openGlPolylineFrame());
+#endif
+}
+
+} // namespace sini::bench
@@ -1,17 +1,52 @@
 #include <sini2D/geometry/Line.hpp>
 #include <sini2D/geometry/Polygon.hpp>
+#include <sini2D/geometry/Triangulation.hpp>
+#include <sini2D/util/testutil.hpp>
 
 #include <catch.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+
 
 using namespace sini;
 
+// The order in which triangles are produced is up to the triangulation
+// algorithm, so compare the meshes as sets
 void assertTriangleMeshesEqual(std::vector<vec3i> tm1, std::vector<vec3i> tm2) {
     REQUIRE(tm1.size() == tm2.size());
+    std::sort(tm1.begin(), tm1.end(), std::less<vec3i>());
+    std::sort(tm2.begin(), tm2.end(), std::less<vec3i>());
     for (size_t i = 0; i < tm1.size(); i++)
         REQUIRE(tm1[i] == tm2[i]);
 }
 
+float polygonArea(const std::vector<vec2>& vertices) {
+    float area = 0.0f;
+    for (size_t i = 0; i < vertices.size(); i++) {
+        vec2 p1 = vertices[i],
+             p2 = vertices[(i+1) % vertices.size()];
+        area += p1.x*p2.y - p2.x*p1.y;
+    }
+    return 0.5f * std::abs(area);
+}
+
+// Star-shaped (and therefore simple) polygon with random radii, which makes
+// roughly half of the vertices reflex
+std::vector<vec2> randomStarPolygon(int n_vertices, unsigned seed) {
+    std::default_random_engine rand_engine{ seed };
+    std::uniform_real_distribution<float> radius_dist{ 0.5f, 1.0f };
+    std::vector<vec2> vertices;
+    for (int i = 0; i < n_vertices; i++) {
+        float angle = 2.0f * 3.1415926535f * i / n_vertices,
+              radius = radius_dist(rand_engine);
+        vertices.push_back(radius * vec2(std::cos(angle), std::sin(angle)));
+    }
+    return vertices;
+}
+
 TEST_CASE("Polygon constructors", "[sini::Polygon]")
 {
     SECTION("Copy std::vector") {
@@ -50,6 +85,103 @@ TEST_CASE("Envelops point", "[sini::Polygon]")
                  { 0.0f, 1.0f }};
     REQUIRE(p.envelops(vec2(0.2f, 0.5f)));
     REQUIRE(!p.envelops(vec2(0.7f, 0.5f)));
+
+    SECTION("Ray through a vertex") {
+        REQUIRE(p.envelops(vec2(0.2f, 0.0f + 1e-7f)));
+        REQUIRE(!p.envelops(vec2(-0.5f, 0.5f)));
+        REQUIRE(!p.envelops(vec2(0.5f, 1.5f)));
+    }
+    SECTION("Prepared polygon") {
+        PreparedPolygon prepared{ p };
+        REQUIRE(prepared.envelops(vec2(0.2f, 0.5f)));
+        REQUIRE(!prepared.envelops(vec2(0.7f, 0.5f)));
+        REQUIRE(!prepared.envelops(vec2(-0.5f, 0.5f)));
+    }
+    SECTION("Prepared polygon with fewer than 3 vertices") {
+        PreparedPolygon prepared{ Polygon{{ 0.0f, 0.0f }, { 1.0f, 1.0f }} };
+        REQUIRE(!prepared.envelops(vec2(0.5f, 0.5f)));
+    }
+}
+
+TEST_CASE("Batched envelops", "[sini::Polygon]")
+{
+    Polygon polygon{ randomStarPolygon(500, 5) };
+
+    std::default_random_engine rand_engine{ 6 };
+    std::uniform_real_distribution<float> coord_dist{ -1.2f, 1.2f };
+    // Not a multiple of 8, to also cover the remainder
+    constexpr size_t n_points = 10003;
+    std::vector<float> xs(n_points), ys(n_points);
+    for (size_t i = 0; i < n_points; i++) {
+        xs[i] = coord_dist(rand_engine);
+        ys[i] = coord_dist(rand_engine);
+    }
+    std::vector<uint8_t> out(n_points, 2);
+    polygon.envelopsBatch(xs.data(), ys.data(), n_points, out.data());
+
+    for (size_t i = 0; i < n_points; i++)
+        REQUIRE(out[i] == (polygon.envelops(vec2(xs[i], ys[i])) ? 1 : 0));
+
+    SECTION("Fewer than 3 vertices") {
+        Polygon line = {{ -1.0f, -1.0f }, { 1.0f, 1.0f }};
+        line.envelopsBatch(xs.data(), ys.data(), n_points, out.data());
+        REQUIRE(std::count(out.begin(), out.end(), 0) == static_cast<long>(n_points));
+    }
+}
+
+TEST_CASE("Prepared polygon matches polygon", "[sini::PreparedPolygon]")
+{
+    Polygon polygon{ randomStarPolygon(1000, 3) };
+    PreparedPolygon prepared{ polygon };
+
+    std::default_random_engine rand_engine{ 4 };
+    std::uniform_real_distribution<float> coord_dist{ -1.2f, 1.2f };
+    int n_inside = 0;
+    for (int i = 0; i < 10000; i++) {
+        vec2 point{ coord_dist(rand_engine), coord_dist(rand_engine) };
+        bool inside = polygon.envelops(point);
+        REQUIRE(prepared.envelops(point) == inside);
+        if (inside) n_inside++;
+    }
+    // Sanity check that both outcomes are covered
+    REQUIRE(n_inside > 0);
+    REQUIRE(n_inside < 10000);
+    // Points inside the inner radius are always inside
+    REQUIRE(prepared.envelops(vec2(0.0f, 0.0f)));
+    REQUIRE(prepared.envelops(vec2(0.45f, 0.1f)));
+}
+
+TEST_CASE("Prepared comb polygon", "[sini::PreparedPolygon]")
+{
+    // Teeth whose edges all span nearly the whole height, more than the old
+    // banded index could hold
+    constexpr int n_teeth = 70000;
+    constexpr float tooth_width = 0.5f / n_teeth;
+    std::vector<vec2> vertices = {{ 0.0f, 0.0f }, { 1.0f, 0.0f }};
+    for (int i = n_teeth - 1; i >= 0; i--) {
+        const float x = static_cast<float>(i) / n_teeth;
+        vertices.push_back({ x + tooth_width, 0.1f });
+        vertices.push_back({ x + tooth_width, 1.0f });
+        vertices.push_back({ x, 1.0f });
+        vertices.push_back({ x, 0.1f });
+    }
+    Polygon polygon{ vertices };
+    PreparedPolygon prepared{ polygon };
+
+    std::default_random_engine rand_engine{ 7 };
+    std::uniform_real_distribution<float> coord_dist{ -0.1f, 1.1f };
+    int n_inside = 0;
+    for (int i = 0; i < 2000; i++) {
+        vec2 point{ coord_dist(rand_engine), coord_dist(rand_engine) };
+        bool inside = polygon.envelops(point);
+        REQUIRE(prepared.envelops(point) == inside);
+        if (inside) n_inside++;
+    }
+    REQUIRE(n_inside > 0);
+    REQUIRE(n_inside < 2000);
+    REQUIRE(prepared.envelops(vec2(0.25f / n_teeth, 0.5f)));
+    REQUIRE(!prepared.envelops(vec2(0.75f / n_teeth, 0.5f)));
+    REQUIRE(prepared.envelops(vec2(0.5f, 0.05f)));
 }
 
 TEST_CASE("Build triangle mesh", "[sini::Polygon]")
@@ -97,3 +229,41 @@ TEST_CASE("Build triangle mesh", "[sini::Polygon]")
         assertTriangleMeshesEqual(*(p.triangle_mesh), expected);
     }
 }
+
+TEST_CASE("Triangulate larger polygons", "[sini::triangulate]")
+{
+    auto requireValidTriangulation = [](const std::vector<vec2>& vertices) {
+        std::vector<vec3i> triangles = triangulate(vertices);
+        REQUIRE(triangles.size() == vertices.size() - 2);
+
+        float triangle_area_sum = 0.0f;
+        for (vec3i t : triangles) {
+            REQUIRE(t.x < t.y);
+            REQUIRE(t.y < t.z);
+            triangle_area_sum += polygonArea({ vertices[t.x], vertices[t.y], vertices[t.z] });
+        }
+        // Non-overlapping triangles inside the polygon add up to its area
+        REQUIRE_APPROX_EQUAL(triangle_area_sum, polygonArea(vertices), 1e-3f);
+    };
+
+    SECTION("Counter-clockwise star polygon") {
+        requireValidTriangulation(randomStarPolygon(1000, 1));
+    }
+    SECTION("Clockwise star polygon") {
+        std::vector<vec2> vertices = randomStarPolygon(1000, 2);
+        std::reverse(vertices.begin(), vertices.end());
+        requireValidTriangulation(vertices);
+    }
+    SECTION("Comb with collinear vertices") {
+        std::vector<vec2> vertices;
+        for (int i = 0; i < 50; i++) {
+            vertices.push_back({ static_cast<float>(2*i),   0.0f });
+            vertices.push_back({ static_cast<float>(2*i+1), 0.0f });
+            vertices.push_back({ static_cast<float>(2*i+1), 5.0f });
+            vertices.push_back({ static_cast<float>(2*i+2), 5.0f });
+        }
+        vertices.push_back({ 100.0f, -1.0f });
+        vertices.push_back({   0.0f, -1.0f });
+        requireValidTriangulation(vertices);
+    }
+}
@@ -0,0 +1,69 @@
+#include <sini2D/geometry/Polygon.hpp>
+#include <sini2D/geometry/TriangulationCache.hpp>
+
+#include <algorithm>    // For std::max
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+using namespace sini;
+
+// Star-shaped polygon with random radii, making roughly half of the vertices
+// reflex
+std::vector<vec2> generateStarPolygon(int n_vertices, std::default_random_engine& rand_engine)
+{
+    std::uniform_real_distribution<float> radius_dist{ 0.5f, 1.0f };
+    std::vector<vec2> vertices;
+    vertices.reserve(n_vertices);
+    constexpr float two_pi = 2.0f * 3.1415926535f;
+    for (int i = 0; i < n_vertices; i++) {
+        const float angle = two_pi * i / n_vertices,
+                    radius = radius_dist(rand_engine);
+        vertices.push_back(radius * vec2(std::cos(angle), std::sin(angle)));
+    }
+    return vertices;
+}
+
+
+void printReport(const int* sizes, const double* times, int n_entries)
+{
+    constexpr int col_width = 18;
+    std::cout << "Triangulation benchmark" << std::endl
+              << "-----------------------------" << std::endl
+              << std::left << std::setw(col_width) << "vertices"
+              << "avg. time" << std::endl;
+
+    for (int i = 0; i < n_entries; ++i)
+        std::cout << std::left << std::setw(col_width) << sizes[i]
+                  << times[i] << " ms" << std::endl;
+}
+
+
+int main()
+{
+    std::default_random_engine rand_engine{ 10476 };
+    const int polygon_sizes[] = { 10, 100, 1000, 10000, 100000 };
+    constexpr int n_sizes = sizeof(polygon_sizes) / sizeof(int);
+    double times[n_sizes];
+    // Times the triangulation itself, rather than cache hits
+    TriangulationCache::shared().setCapacity(0);
+
+    for (int i = 0; i < n_sizes; i++) {
+        Polygon polygon{ generateStarPolygon(polygon_sizes[i], rand_engine) };
+        // Keep the total amount of work roughly the same for all sizes
+        const int n_iterations = std::max(1000000 / polygon_sizes[i], 5);
+
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        for (int j = 0; j < n_iterations; j++)
+            polygon.buildTriangleMesh();
+        const auto end_time = std::chrono::high_resolution_clock::now();
+        const std::chrono::duration<double, std::milli> elapsed_time = end_time - start_time;
+        times[i] = elapsed_time.count() / n_iterations;
+    }
+
+    printReport(polygon_sizes, times, n_sizes);
+}
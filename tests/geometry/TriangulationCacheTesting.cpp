@@ -0,0 +1,132 @@
+#include <sini2D/geometry/Polygon.hpp>
+#include <sini2D/geometry/Triangulation.hpp>
+#include <sini2D/geometry/TriangulationCache.hpp>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+
+using namespace sini;
+
+namespace {
+
+// Distinct squares, offset along x
+std::vector<vec2> square(float offset)
+{
+    return { { offset, 0.0f }, { offset + 1.0f, 0.0f },
+             { offset + 1.0f, 1.0f }, { offset, 1.0f } };
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("Triangulation cache", "[sini::TriangulationCache]")
+{
+    const std::vector<vec2> concave = { { 0.0f, 0.0f }, { 2.0f, 0.0f }, { 1.0f, 1.0f },
+                                        { 2.0f, 2.0f }, { 0.0f, 2.0f } };
+
+    SECTION("Hits give the same triangulation") {
+        TriangulationCache cache{ 16 };
+        const std::vector<vec3i> expected = triangulate(concave);
+        REQUIRE(cache.triangulate(concave) == expected);
+        REQUIRE(cache.triangulate(std::vector<vec2>(concave)) == expected);
+
+        const TriangulationCache::Stats stats = cache.stats();
+        REQUIRE(stats.hits == 1);
+        REQUIRE(stats.misses == 1);
+        REQUIRE(stats.size == 1);
+        REQUIRE(stats.vertices == 5);
+        REQUIRE(stats.capacity == 16);
+        cache.resetStats();
+        REQUIRE(cache.stats().hits == 0);
+        REQUIRE(cache.stats().size == 1);
+    }
+    SECTION("Different vertices miss") {
+        TriangulationCache cache{ 16 };
+        std::vector<vec2> moved = concave;
+        cache.triangulate(concave);
+        moved[2].x += 0.25f;
+        REQUIRE(cache.triangulate(moved) == triangulate(moved));
+        REQUIRE(cache.stats().misses == 2);
+    }
+    SECTION("Least recently used are evicted first") {
+        // Room for two squares
+        TriangulationCache cache{ 8 };
+        cache.triangulate(square(0.0f));
+        cache.triangulate(square(2.0f));
+        cache.triangulate(square(0.0f));    // Now most recently used
+        cache.triangulate(square(4.0f));    // Evicts square(2)
+        REQUIRE(cache.stats().evictions == 1);
+        REQUIRE(cache.stats().size == 2);
+
+        cache.resetStats();
+        cache.triangulate(square(0.0f));
+        cache.triangulate(square(4.0f));
+        REQUIRE(cache.stats().hits == 2);
+        cache.triangulate(square(2.0f));
+        REQUIRE(cache.stats().misses == 1);
+
+        cache.setCapacity(4);
+        REQUIRE(cache.stats().size == 1);
+        cache.clear();
+        REQUIRE(cache.stats().size == 0);
+        REQUIRE(cache.stats().vertices == 0);
+    }
+    SECTION("Evicted by number of vertices") {
+        TriangulationCache cache{ 12 };
+        cache.triangulate(square(0.0f));
+        cache.triangulate(square(2.0f));
+        cache.triangulate(square(4.0f));
+        REQUIRE(cache.stats().vertices == 12);
+        // Makes room for its 5 vertices by evicting the two oldest squares
+        cache.triangulate(concave);
+        REQUIRE(cache.stats().evictions == 2);
+        REQUIRE(cache.stats().size == 2);
+        REQUIRE(cache.stats().vertices == 9);
+
+        // Too large to be cached, without evicting anything
+        std::vector<vec2> large;
+        for (int i = 0; i < 16; i++)
+            large.push_back(vec2(std::cos(0.39269908f * i), std::sin(0.39269908f * i)));
+        REQUIRE(cache.triangulate(large) == triangulate(large));
+        REQUIRE(cache.stats().evictions == 2);
+        REQUIRE(cache.stats().vertices == 9);
+    }
+    SECTION("Zero capacity disables caching") {
+        TriangulationCache cache{ 0 };
+        REQUIRE(cache.triangulate(concave) == triangulate(concave));
+        cache.triangulate(concave);
+        REQUIRE(cache.stats().misses == 2);
+        REQUIRE(cache.stats().size == 0);
+    }
+    SECTION("Concurrent lookups") {
+        TriangulationCache cache{ 32 };
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&cache]() {
+                for (int i = 0; i < 1000; i++)
+                    cache.triangulate(square(float(i % 16)));
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        const TriangulationCache::Stats stats = cache.stats();
+        REQUIRE(stats.hits + stats.misses == 4000);
+        REQUIRE(stats.size <= 8);
+        REQUIRE(stats.vertices <= 32);
+        for (int i = 0; i < 16; i++)
+            REQUIRE(cache.triangulate(square(float(i))) == triangulate(square(float(i))));
+    }
+    SECTION("Polygons use the shared cache") {
+        TriangulationCache::shared().resetStats();
+        Polygon first{ concave },
+                second{ concave };
+        first.buildTriangleMesh();
+        second.buildTriangleMesh();
+        REQUIRE(*second.triangle_mesh == *first.triangle_mesh);
+        REQUIRE(TriangulationCache::shared().stats().hits >= 1);
+    }
+}
@@ -3,12 +3,15 @@
 #include <sini2D/math/Matrix.hpp>
 #include <sini2D/sdl/SubsystemInitializer.hpp>
 #include <sini2D/sdl/Window.hpp>
+#include <sini2D/util/Profiler.hpp>
 
 #include <chrono>
 #include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <random>
 #include <sstream>
 #include <string>
@@ -137,10 +140,15 @@ void renderTerrain(SimpleRenderer& renderer,
 }
 
 
-void printReport(const int* sizes, const double* times, int n_entries)
+void printReport(const int* sizes, const double* times, int n_entries,
+                 RenderSettings settings)
 {
     constexpr int col_width = 18;
-    std::cout << "Drawing benchmark" << std::endl
+    std::cout << "Drawing benchmark ("
+              << (settings.vertex_streaming == VertexStreaming::RING_BUFFER
+                  ? "ring buffer" : "glBufferSubData")
+              << (settings.instanced_shapes ? ", instanced" : "")
+              << ")" << std::endl
               << "-----------------------------" << std::endl
               << std::left << std::setw(col_width) << "terrain size"
               << "avg. time" << std::endl;
@@ -155,22 +163,41 @@ void printReport(const int* sizes, const double* times, int n_entries)
 }
 
 
+// Renders offscreen if 'headless', leaving 'window' empty
+std::unique_ptr<SimpleRenderer> createRenderer(bool headless, const char* title,
+                                               std::unique_ptr<Window>& window,
+                                               const Camera& camera,
+                                               RenderSettings settings)
+{
+    const vec2i size{ 800, 800 };
+#ifdef SINI_HEADLESS
+    if (headless)
+        return std::make_unique<SimpleRenderer>(size, camera, settings);
+#else
+    (void)headless;
+#endif
+    window = std::make_unique<Window>(title, size,
+        std::initializer_list<WindowProperties>{ WindowProperties::OPENGL });
+    auto renderer = std::make_unique<SimpleRenderer>(*window, camera, settings);
+    window->setVSync(VSync::OFF);
+    return renderer;
+}
+
+
 #define STR(x) #x
 
 #define BENCHMARK_CASE(SIZE, RESULT_INDEX) {                            \
     const auto terrain = std::make_unique<Matrix<float,SIZE,SIZE>>(     \
         generateFractalTerrain<SIZE>(rand_engine));                     \
-    Window window{ "Drawing Benchmark " STR(SIZE),                      \
-                   { 800, 800 },                                        \
-                   { WindowProperties::OPENGL } };                      \
+    std::unique_ptr<Window> window;                                     \
     Camera camera{ static_cast<float>(SIZE) / 2.0f,                     \
                    1.0f,                                                \
                    static_cast<float>(SIZE) };                          \
-    SimpleRenderer renderer{ window, camera };                          \
-    window.setVSync(VSync::OFF);                                        \
+    const auto renderer = createRenderer(headless,                      \
+        "Drawing Benchmark " STR(SIZE), window, camera, settings);      \
     const auto start_time = std::chrono::high_resolution_clock::now();  \
     for (int i = 0; i < 10; i++)                                        \
-        renderTerrain(renderer, camera, *terrain, draw_lines);          \
+        renderTerrain(*renderer, camera, *terrain, draw_lines);         \
     const auto end_time = std::chrono::high_resolution_clock::now();    \
     const std::chrono::duration<double, std::milli> elapsed_time = end_time - start_time; \
     times[RESULT_INDEX] = elapsed_time.count() / 10.0;                  \
@@ -180,12 +207,43 @@ void printReport(const int* sizes, const double* times, int n_entries)
 
 int main(int argc, char** argv)
 {
-    bool draw_lines = false;
-    for (int i = 0; i < argc; ++i)
+    bool draw_lines = false,
+         headless = false;
+    RenderSettings settings;
+#ifdef SINI_PROFILE
+    const char* trace_path = nullptr;
+#endif
+    for (int i = 0; i < argc; ++i) {
         if (std::strcmp(argv[i], "--lines") == 0)
             draw_lines = true;
+        else if (std::strcmp(argv[i], "--ring-buffer") == 0)
+            settings.vertex_streaming = VertexStreaming::RING_BUFFER;
+        else if (std::strcmp(argv[i], "--instanced") == 0)
+            settings.instanced_shapes = true;
+        else if (std::strcmp(argv[i], "--headless") == 0) {
+#ifdef SINI_HEADLESS
+            headless = true;
+#else
+            std::cerr << "--headless requires building with SINI_2D_ENABLE_HEADLESS"
+                      << std::endl;
+            return 1;
+#endif
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+#ifdef SINI_PROFILE
+            trace_path = argv[++i];
+#else
+            std::cerr << "--trace requires building with SINI_2D_ENABLE_PROFILING"
+                      << std::endl;
+            return 1;
+#endif
+        }
+    }
 
-    SubsystemInitializer si{ { SubsystemFlags::VIDEO } };
+    // No video subsystem needed (or available, e.g. in CI) when headless
+    std::optional<SubsystemInitializer> si;
+    if (!headless)
+        si.emplace(std::initializer_list<SubsystemFlags>{ SubsystemFlags::VIDEO });
 
     std::default_random_engine rand_engine{ 10476 };
     // terrain size must be = 2^N + 1 for some integer N
@@ -200,5 +258,11 @@ int main(int argc, char** argv)
     BENCHMARK_CASE(513,  4);
     BENCHMARK_CASE(1025, 5);
 
-    printReport(terrain_sizes, times, n_sizes);
+    printReport(terrain_sizes, times, n_sizes, settings);
+#ifdef SINI_PROFILE
+    if (trace_path != nullptr) {
+        std::ofstream trace{ trace_path };
+        Profiler::writeChromeTrace(trace);
+    }
+#endif
 }
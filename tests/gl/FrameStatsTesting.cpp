@@ -0,0 +1,52 @@
+#include <sini2D/gl/FrameStats.hpp>
+
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+
+using namespace sini;
+
+TEST_CASE("Frame log export", "[sini::FrameLog]")
+{
+    FrameLog log;
+    FrameStats stats;
+    stats.draw_calls = 3;
+    stats.vertices = 12;
+    stats.cpu_submit_ms = 0.5;
+    log.add(stats);
+    stats.frame_index = 1;
+    stats.gpu_draw_ms = 1.25;
+    stats.gpu_present_ms = 0.25;
+    log.add(stats);
+    REQUIRE(log.frames().size() == 2);
+
+    SECTION("CSV has a header and a line per frame") {
+        std::stringstream csv;
+        log.writeCsv(csv);
+        std::string header, first, second, rest;
+        std::getline(csv, header);
+        std::getline(csv, first);
+        std::getline(csv, second);
+        REQUIRE(header.rfind("frame_index,draw_calls,vertices,", 0) == 0);
+        REQUIRE(first == "0,3,12,0,0,0,0,0,0.5,0,-1,-1,-1");
+        REQUIRE(second == "1,3,12,0,0,0,0,0,0.5,0,1.25,0.25,1.5");
+        REQUIRE(!std::getline(csv, rest));
+    }
+    SECTION("JSON is an array of objects") {
+        std::stringstream json;
+        log.writeJson(json);
+        const std::string text = json.str();
+        REQUIRE(text.front() == '[');
+        REQUIRE(text.find("{\"frame_index\": 0, \"draw_calls\": 3, \"vertices\": 12,")
+                != std::string::npos);
+        REQUIRE(text.find("\"gpu_ms\": 1.5}\n]") != std::string::npos);
+    }
+    SECTION("An empty log is still valid") {
+        log.clear();
+        std::stringstream json;
+        log.writeJson(json);
+        REQUIRE(json.str() == "[\n]\n");
+    }
+}
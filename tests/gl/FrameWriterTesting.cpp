@@ -0,0 +1,74 @@
+#include <sini2D/gl/FrameWriter.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <cstdio>       // For std::remove
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace sini;
+
+namespace {
+
+CapturedFrame testFrame(uint64_t index)
+{
+    CapturedFrame frame{ index, vec2i(2, 1), {} };
+    const uint8_t value = static_cast<uint8_t>(index);
+    frame.pixels = { value, 1, 2, 255, 3, 4, value, 128 };
+    return frame;
+}
+
+std::string readFile(const std::string& path)
+{
+    std::ifstream file{ path, std::ios::binary };
+    return std::string(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("Frame writing", "[sini::FrameWriter]")
+{
+    const std::string path = "sini2D_FrameWriterTesting.out";
+
+    SECTION("Raw frames are written in order, with alpha") {
+        {
+            FrameWriter writer{ path, FrameWriter::Format::RAW_RGBA, 1 };
+            for (uint64_t i = 0; i < 3; ++i)
+                writer.write(testFrame(i));
+            writer.flush();
+            REQUIRE(writer.numWrittenFrames() == 3);
+        }
+        const std::string data = readFile(path);
+        REQUIRE(data.size() == 3 * 8);
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(data[8*i] == char(i));
+            REQUIRE(data[8*i + 6] == char(i));
+            REQUIRE(data[8*i + 7] == char(128));
+        }
+    }
+    SECTION("PPM frames are written as a sequence of images, without alpha") {
+        {
+            FrameWriter writer{ path, FrameWriter::Format::PPM };
+            writer.write(testFrame(5));
+            writer.write(testFrame(6));
+            // Queued frames are written before the writer is destroyed
+        }
+        const std::string header = "P6\n2 1\n255\n";
+        const std::string expected = header + std::string{ 5, 1, 2, 3, 4, 5 }
+                                   + header + std::string{ 6, 1, 2, 3, 4, 6 };
+        REQUIRE(readFile(path) == expected);
+    }
+    SECTION("Failing to open the file throws") {
+        REQUIRE_THROWS_AS(FrameWriter("no_such_directory/frames.ppm",
+                                      FrameWriter::Format::PPM),
+                          const std::runtime_error&);
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,533 @@
+#include <sini2D/geometry/Polygon.hpp>
+#include <sini2D/gl/Camera.hpp>
+#include <sini2D/gl/FrameCapture.hpp>
+#include <sini2D/gl/PrimitiveVertices.hpp>
+#include <sini2D/gl/RenderCommandList.hpp>
+#include <sini2D/gl/SimpleRenderer.hpp>
+#include <sini2D/gl/StaticMesh.hpp>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>      // For std::abs
+#include <vector>
+
+
+using namespace sini;
+
+namespace {
+
+const vec2i dims{ 64, 64 };
+
+// Rows from top to bottom, as returned by SimpleRenderer::readPixels()
+vec3i pixelAt(const std::vector<uint8_t>& pixels, int x, int y)
+{
+    const size_t i = 3 * (size_t(y) * dims.x + x);
+    return vec3i(pixels[i], pixels[i+1], pixels[i+2]);
+}
+
+bool closeTo(vec3i color, vec3i expected)
+{
+    for (int i = 0; i < 3; ++i)
+        if (std::abs(color[i] - expected[i]) > 1)
+            return false;
+    return true;
+}
+
+// The world is [-1, 1] x [-1, 1], with y pointing up
+std::vector<uint8_t> renderScene(RenderSettings settings)
+{
+    SimpleRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f), settings };
+    renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    renderer.fillRectangle({ -1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, 1.0f);
+    renderer.fillRectangle({ -1.0f, 0.75f }, { -0.75f, 1.0f }, { 0.0f, 1.0f, 0.0f }, 0.5f);
+    renderer.fillRectangle({ 0.0f, -1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, 0.5f);
+    renderer.fillCircle({ 0.5f, 0.5f }, 0.25f, { 0.0f, 1.0f, 0.0f }, 1.0f);
+    // Ellipse rotated by 90 degrees, and a diamond (a square rotated by 45)
+    const mat3 ellipse = {{ 0.0f, -0.125f, -0.75f },
+                          { 0.25f,  0.0f, -0.5f },
+                          { 0.0f,  0.0f, 1.0f }},
+               diamond = {{ 0.25f, -0.25f, -0.5f },
+                          { 0.25f,  0.25f, 0.5f },
+                          { 0.0f,  0.0f, 1.0f }};
+    renderer.fillShape(Shape::CIRCLE, ellipse, { 1.0f, 1.0f, 0.0f }, 1.0f);
+    renderer.drawShape(Shape::SQUARE, diamond, { 0.0f, 1.0f, 1.0f }, 1.0f);
+    renderer.updateScreen();
+    return renderer.readPixels();
+}
+
+Polygon regularPolygon(vec2 center, float radius, int n_vertices)
+{
+    std::vector<vec2> vertices;
+    for (int i = 0; i < n_vertices; ++i) {
+        const float angle = 2.0f * 3.1415926535f * i / n_vertices;
+        vertices.push_back(center + radius * vec2(std::cos(angle), std::sin(angle)));
+    }
+    return Polygon(vertices);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("Headless rendering and readback", "[sini::SimpleRenderer]")
+{
+    const std::vector<uint8_t> pixels = renderScene(RenderSettings());
+    REQUIRE(pixels.size() == 3 * dims.x * dims.y);
+
+    SECTION("Rows are read back from top to bottom") {
+        REQUIRE(closeTo(pixelAt(pixels, 16, 16), { 255, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 16, 48), { 0, 0, 0 }));
+    }
+    SECTION("Translucent primitives are blended") {
+        REQUIRE(closeTo(pixelAt(pixels, 48, 48), { 0, 0, 128 }));
+        // Over an opaque primitive of the same batch
+        REQUIRE(closeTo(pixelAt(pixels, 4, 4), { 128, 128, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 4, 12), { 255, 0, 0 }));
+    }
+    SECTION("Circles are filled") {
+        REQUIRE(closeTo(pixelAt(pixels, 48, 16), { 0, 255, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 62, 1), { 0, 0, 0 }));
+    }
+    SECTION("Unit shapes are transformed") {
+        // The ellipse is 0.25 wide and 0.5 high
+        REQUIRE(closeTo(pixelAt(pixels, 8, 48), { 255, 255, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 8, 42), { 255, 255, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 14, 48), { 0, 0, 0 }));
+    }
+    SECTION("All settings render the same image") {
+        RenderSettings settings;
+        settings.vertex_streaming = VertexStreaming::RING_BUFFER;
+        REQUIRE(renderScene(settings) == pixels);
+        // The instanced circle is the fixed unit circle mesh, while the circle
+        // drawn by vertices is tessellated for its size, so their edges differ
+        settings.instanced_shapes = true;
+        const std::vector<uint8_t> instanced = renderScene(settings);
+        int n_off_edge = 0;
+        for (int y = 0; y < dims.y; ++y)
+            for (int x = 0; x < dims.x; ++x) {
+                if (pixelAt(instanced, x, y) == pixelAt(pixels, x, y))
+                    continue;
+                const vec2 world{ -1.0f + (x + 0.5f) / 32.0f, 1.0f - (y + 0.5f) / 32.0f };
+                n_off_edge += std::abs(length(world - vec2(0.5f, 0.5f)) - 0.25f) > 2.0f / 32.0f;
+            }
+        REQUIRE(n_off_edge == 0);
+    }
+}
+
+TEST_CASE("Streaming through a wrapped ring buffer", "[sini::SimpleRenderer]")
+{
+    // Finely tessellated circles, filled and outlined in turn so that each
+    // batch is drawn right away, and batches start mid-segment
+    std::vector<Polygon> circles;
+    for (int i = 0; i < 16; ++i) {
+        circles.push_back(unitCircle(1024));
+        const vec2 center{ -0.75f + 0.5f * (i % 4), -0.75f + 0.5f * (i / 4) };
+        for (vec2& vertex : circles.back().vertices)
+            vertex = center + 0.25f * vertex;
+    }
+    const auto render = [&circles](RenderSettings settings) {
+        SimpleRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f), settings };
+        renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        for (int i = 0; i < 2048; ++i) {
+            Polygon& circle = circles[i % circles.size()];
+            const vec3 color{ (i % 7) / 6.0f, (i % 5) / 4.0f, (i % 3) / 2.0f };
+            if (i % 2 == 0)
+                renderer.fillPolygon(circle, color, 0.75f);
+            else
+                renderer.drawPolygon(circle, color, 1.0f);
+        }
+        renderer.updateScreen();
+        // Enough to wrap the 3 x 8 MiB vertex ring more than twice
+        REQUIRE(renderer.frameStats().bytes_uploaded > 2 * 24 * 1024 * 1024);
+        return renderer.readPixels();
+    };
+
+    RenderSettings settings;
+    const std::vector<uint8_t> pixels = render(settings);
+    settings.vertex_streaming = VertexStreaming::RING_BUFFER;
+    REQUIRE(render(settings) == pixels);
+}
+
+TEST_CASE("Translucent instance starting a new batch", "[sini::SimpleRenderer]")
+{
+    RenderSettings settings;
+    settings.vertex_streaming = VertexStreaming::RING_BUFFER;
+    settings.instanced_shapes = true;
+    SimpleRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f), settings };
+    renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+
+    // A mapped batch holds a segment (8 MiB) of 28-byte instances. The batch
+    // is filled by opaque rectangles outside the view, so that the
+    // translucent one is the first and only instance of the next batch.
+    constexpr size_t batch_capacity = 8 * 1024 * 1024 / 28;
+    renderer.fillRectangle({ -1.0f, -1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, 1.0f);
+    for (size_t i = 1; i < batch_capacity; ++i)
+        renderer.fillRectangle({ 2.0f, 2.0f }, { 2.5f, 2.5f }, { 1.0f, 1.0f, 1.0f }, 1.0f);
+    renderer.fillRectangle({ -1.0f, -1.0f }, { 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, 0.5f);
+    renderer.updateScreen();
+    const std::vector<uint8_t> pixels = renderer.readPixels();
+
+    REQUIRE(renderer.frameStats().draw_calls == 2);
+    REQUIRE(closeTo(pixelAt(pixels, 16, 48), { 128, 0, 128 }));
+    REQUIRE(closeTo(pixelAt(pixels, 48, 16), { 255, 0, 0 }));
+}
+
+TEST_CASE("SDF shapes", "[sini::SimpleRenderer]")
+{
+    SimpleRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f) };
+    renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    // Centered on a pixel center, so that the edge goes through the centers
+    // of some pixels, which are then half covered
+    const float h = 1.0f / 64.0f;
+    renderer.fillSdfCircle({ 0.5f + h, 0.5f - h }, 0.25f, { 0.0f, 1.0f, 0.0f }, 1.0f);
+    renderer.drawSdfCircle({ -0.5f, -0.5f }, 0.25f, 0.0625f, { 1.0f, 1.0f, 1.0f }, 1.0f);
+    renderer.fillSdfCapsule({ -0.75f, 0.5f }, { -0.25f, 0.5f }, 0.1f, { 1.0f, 0.0f, 0.0f },
+                            1.0f);
+    renderer.drawSdfRoundedBox({ 0.25f, -0.75f }, { 0.75f, -0.25f }, 0.1f, 0.0625f,
+                               { 0.0f, 0.0f, 1.0f }, 1.0f);
+    renderer.updateScreen();
+    const std::vector<uint8_t> pixels = renderer.readPixels();
+
+    SECTION("Shapes are covered by their distance fields") {
+        REQUIRE(closeTo(pixelAt(pixels, 48, 16), { 0, 255, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 62, 1), { 0, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 16, 15), { 255, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 16, 10), { 0, 0, 0 }));
+    }
+    SECTION("Outlines are hollow") {
+        REQUIRE(closeTo(pixelAt(pixels, 16, 48), { 0, 0, 0 }));
+        REQUIRE(pixelAt(pixels, 23, 47).x > 240);
+        REQUIRE(closeTo(pixelAt(pixels, 48, 48), { 0, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 48, 41), { 0, 0, 255 }));
+    }
+    SECTION("Edges are antialiased") {
+        REQUIRE(closeTo(pixelAt(pixels, 56, 16), { 0, 128, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 48, 8), { 0, 128, 0 }));
+    }
+    SECTION("One draw call and no tessellation") {
+        const FrameStats& stats = renderer.frameStats();
+        REQUIRE(stats.draw_calls == 1);
+        REQUIRE(stats.vertices == 4 * 4);
+        REQUIRE(stats.elements == 0);
+    }
+    SECTION("Streamed through the ring buffer") {
+        RenderSettings settings;
+        settings.vertex_streaming = VertexStreaming::RING_BUFFER;
+        SimpleRenderer streamed{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f), settings };
+        streamed.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        // A batch outside the view first, so that the shapes below start at a
+        // later segment of the ring
+        streamed.fillSdfCircle({ 3.0f, 3.0f }, 0.25f, { 1.0f, 1.0f, 1.0f }, 1.0f);
+        streamed.fillRectangle({ 3.0f, 3.0f }, { 4.0f, 4.0f }, { 1.0f, 1.0f, 1.0f }, 1.0f);
+        streamed.fillSdfCircle({ 0.5f + h, 0.5f - h }, 0.25f, { 0.0f, 1.0f, 0.0f }, 1.0f);
+        streamed.drawSdfCircle({ -0.5f, -0.5f }, 0.25f, 0.0625f, { 1.0f, 1.0f, 1.0f }, 1.0f);
+        streamed.fillSdfCapsule({ -0.75f, 0.5f }, { -0.25f, 0.5f }, 0.1f,
+                                { 1.0f, 0.0f, 0.0f }, 1.0f);
+        streamed.drawSdfRoundedBox({ 0.25f, -0.75f }, { 0.75f, -0.25f }, 0.1f, 0.0625f,
+                                   { 0.0f, 0.0f, 1.0f }, 1.0f);
+        streamed.updateScreen();
+        REQUIRE(streamed.readPixels() == pixels);
+        REQUIRE(streamed.frameStats().draw_calls == 3);
+    }
+}
+
+TEST_CASE("Thick polylines", "[sini::SimpleRenderer]")
+{
+    SimpleRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f) };
+    renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    LineStyle style{ 0.25f };
+    renderer.drawPolyline({ { -0.75f, 0.75f }, { -0.25f, 0.75f } }, style,
+                          { 1.0f, 0.0f, 0.0f }, 1.0f);
+    style.cap = LineCap::ROUND;
+    renderer.drawPolyline({ { -0.75f, 0.375f }, { -0.25f, 0.375f } }, style,
+                          { 0.0f, 1.0f, 0.0f }, 1.0f);
+    style.cap = LineCap::BUTT;
+    renderer.drawPolyline({ { 0.25f, 0.75f }, { 0.75f, 0.75f }, { 0.75f, 0.25f } }, style,
+                          { 0.0f, 0.0f, 1.0f }, 1.0f);
+    style.join = LineJoin::ROUND;
+    renderer.drawPolyline({ { 0.25f, -0.25f }, { 0.75f, -0.25f }, { 0.75f, -0.75f } }, style,
+                          { 0.0f, 0.0f, 1.0f }, 1.0f);
+    const Polygon square{ { { -0.75f, -0.75f }, { -0.25f, -0.75f },
+                            { -0.25f, -0.25f }, { -0.75f, -0.25f } } };
+    renderer.drawPolygon(square, LineStyle{ 0.0625f }, { 1.0f, 1.0f, 1.0f }, 1.0f);
+    renderer.updateScreen();
+    const std::vector<uint8_t> pixels = renderer.readPixels();
+
+    SECTION("Lines are as wide as their style") {
+        REQUIRE(closeTo(pixelAt(pixels, 16, 4), { 255, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 16, 11), { 255, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 16, 1), { 0, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 16, 14), { 0, 0, 0 }));
+    }
+    SECTION("Caps") {
+        REQUIRE(closeTo(pixelAt(pixels, 25, 7), { 0, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 25, 19), { 0, 255, 0 }));
+    }
+    SECTION("Joins") {
+        REQUIRE(closeTo(pixelAt(pixels, 59, 4), { 0, 0, 255 }));
+        REQUIRE(closeTo(pixelAt(pixels, 59, 36), { 0, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(pixels, 57, 38), { 0, 0, 255 }));
+    }
+    SECTION("Joins past the miter limit are beveled") {
+        // A turn of 135 degrees at (0.25, 0), whose miter reaches 2.6 half
+        // widths from the joined point, drawn translucent to show overlaps
+        const std::vector<vec2> turn = {
+            { -0.674f, 0.383f }, { 0.25f, 0.0f }, { -0.674f, -0.383f } };
+        const auto render = [&renderer, &turn](float miter_limit) {
+            LineStyle sharp{ 0.25f };
+            sharp.miter_limit = miter_limit;
+            renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+            renderer.drawPolyline(turn, sharp, { 1.0f, 0.0f, 0.0f }, 0.5f);
+            renderer.updateScreen();
+            return renderer.readPixels();
+        };
+        const std::vector<uint8_t> beveled = render(2.0f);
+        // The tip is cut off
+        REQUIRE(closeTo(pixelAt(beveled, 46, 31), { 0, 0, 0 }));
+        // Inside the bevel, at the outer edge just before it and at the
+        // inner corner, each covered by one segment
+        REQUIRE(closeTo(pixelAt(beveled, 40, 31), { 128, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(beveled, 40, 29), { 128, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(beveled, 30, 31), { 128, 0, 0 }));
+
+        const std::vector<uint8_t> mitered = render(4.0f);
+        REQUIRE(closeTo(pixelAt(mitered, 46, 31), { 128, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(mitered, 30, 31), { 128, 0, 0 }));
+    }
+    SECTION("Repeated points are skipped") {
+        const auto render = [&renderer](const std::vector<vec2>& points, bool closed) {
+            renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+            renderer.drawPolyline(points, LineStyle{ 0.25f }, { 1.0f, 1.0f, 1.0f }, 0.5f,
+                                  closed);
+            renderer.updateScreen();
+            return renderer.readPixels();
+        };
+        REQUIRE(render({ { -0.5f, 0.0f }, { 0.0f, 0.5f }, { 0.0f, 0.5f }, { 0.5f, 0.0f } },
+                       false)
+                == render({ { -0.5f, 0.0f }, { 0.0f, 0.5f }, { 0.5f, 0.0f } }, false));
+        REQUIRE(render({ { -0.5f, -0.5f }, { 0.5f, 0.0f }, { 0.5f, 0.0f }, { -0.5f, 0.5f } },
+                       false)
+                == render({ { -0.5f, -0.5f }, { 0.5f, 0.0f }, { -0.5f, 0.5f } }, false));
+        REQUIRE(render({ { -0.5f, 0.0f }, { 0.0f, 0.5f }, { 0.5f, 0.0f }, { -0.5f, 0.0f } },
+                       true)
+                == render({ { -0.5f, 0.0f }, { 0.0f, 0.5f }, { 0.5f, 0.0f } }, true));
+    }
+    SECTION("Polygons are closed") {
+        REQUIRE(closeTo(pixelAt(pixels, 7, 47), { 255, 255, 255 }));
+        REQUIRE(closeTo(pixelAt(pixels, 16, 48), { 0, 0, 0 }));
+    }
+    SECTION("One draw call per polyline") {
+        renderer.clear();
+        std::vector<vec2> zigzag(100000);
+        for (size_t i = 0; i < zigzag.size(); ++i)
+            zigzag[i] = vec2(-1.0f + 2.0f * i / zigzag.size(), i % 2 == 0 ? -0.5f : 0.5f);
+        renderer.drawPolyline(zigzag, LineStyle{ 0.01f }, { 1.0f, 1.0f, 1.0f }, 0.5f);
+        renderer.updateScreen();
+        const FrameStats& stats = renderer.frameStats();
+        REQUIRE(stats.draw_calls == 1);
+        REQUIRE(stats.vertices == 8 * (zigzag.size() - 1));
+        // Covered many times over between the turns, and the sharp turns
+        // don't reach past them
+        const std::vector<uint8_t> zigzag_pixels = renderer.readPixels();
+        REQUIRE(closeTo(pixelAt(zigzag_pixels, 32, 32), { 255, 255, 255 }));
+        REQUIRE(closeTo(pixelAt(zigzag_pixels, 32, 8), { 0, 0, 0 }));
+        REQUIRE(closeTo(pixelAt(zigzag_pixels, 32, 56), { 0, 0, 0 }));
+    }
+}
+
+TEST_CASE("Static meshes", "[sini::StaticMesh]")
+{
+    SimpleRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f) };
+    struct Entry {
+        Polygon polygon;
+        vec3 color;
+        float alpha;
+    };
+    std::vector<Entry> entries = {
+        { regularPolygon({ -0.5f, 0.5f }, 0.4f, 4), { 1.0f, 0.0f, 0.0f }, 1.0f },
+        { regularPolygon({ 0.5f, 0.5f }, 0.4f, 5), { 0.0f, 1.0f, 0.0f }, 1.0f },
+        { regularPolygon({ 0.0f, 0.0f }, 0.6f, 6), { 0.0f, 0.0f, 1.0f }, 0.5f },
+        { regularPolygon({ 0.5f, -0.5f }, 0.3f, 7), { 1.0f, 1.0f, 0.0f }, 1.0f }
+    };
+    StaticMesh mesh;
+    for (Entry& entry : entries)
+        mesh.addPolygon(entry.polygon, entry.color, entry.alpha);
+
+    // The mesh must look the same as its polygons drawn one by one
+    const auto render = [&renderer](const auto& draw) {
+        renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        draw();
+        renderer.updateScreen();
+        return renderer.readPixels();
+    };
+    const auto requireSameAsPolygons = [&]() {
+        const std::vector<uint8_t> from_mesh = render([&]() {
+            renderer.drawStaticMesh(mesh);
+        });
+        const std::vector<uint8_t> from_polygons = render([&]() {
+            for (Entry& entry : entries)
+                renderer.fillPolygon(entry.polygon, entry.color, entry.alpha);
+        });
+        REQUIRE(from_mesh == from_polygons);
+    };
+    const auto update = [&](size_t index, Entry entry) {
+        entries[index] = entry;
+        mesh.updatePolygon(index, entries[index].polygon, entry.color, entry.alpha);
+    };
+    requireSameAsPolygons();
+
+    SECTION("Updated with the same size") {
+        update(1, { regularPolygon({ 0.25f, 0.75f }, 0.2f, 5), { 0.0f, 1.0f, 1.0f }, 1.0f });
+        requireSameAsPolygons();
+    }
+    SECTION("Updated to more vertices") {
+        update(0, { regularPolygon({ -0.5f, 0.5f }, 0.45f, 12), { 1.0f, 0.0f, 1.0f }, 1.0f });
+        requireSameAsPolygons();
+        update(2, { regularPolygon({ 0.0f, 0.0f }, 0.5f, 9), { 1.0f, 1.0f, 1.0f }, 0.25f });
+        requireSameAsPolygons();
+    }
+    SECTION("Updated to fewer vertices") {
+        update(2, { regularPolygon({ 0.0f, -0.25f }, 0.5f, 3), { 0.0f, 0.0f, 1.0f }, 1.0f });
+        requireSameAsPolygons();
+        update(0, { regularPolygon({ -0.5f, 0.5f }, 0.4f, 3), { 1.0f, 0.0f, 0.0f }, 0.5f });
+        requireSameAsPolygons();
+    }
+    SECTION("Several updates between draws") {
+        update(3, { regularPolygon({ 0.5f, -0.5f }, 0.3f, 4), { 1.0f, 1.0f, 0.0f }, 1.0f });
+        update(0, { regularPolygon({ -0.5f, 0.5f }, 0.3f, 8), { 1.0f, 0.0f, 0.0f }, 1.0f });
+        update(1, { regularPolygon({ 0.5f, 0.5f }, 0.3f, 5), { 0.0f, 1.0f, 0.0f }, 0.75f });
+        requireSameAsPolygons();
+    }
+    SECTION("Buffers regrown") {
+        for (int i = 0; i < 32; ++i) {
+            const vec2 center{ -0.875f + 0.25f * (i % 8), -0.875f + 0.25f * (i / 8) };
+            entries.push_back({ regularPolygon(center, 0.1f, 3 + i % 5),
+                                { 1.0f, 0.5f, 0.0f }, 1.0f });
+            mesh.addPolygon(entries.back().polygon, entries.back().color, 1.0f);
+        }
+        requireSameAsPolygons();
+        // Shifts all the added polygons
+        update(1, { regularPolygon({ 0.5f, 0.5f }, 0.4f, 10), { 0.0f, 1.0f, 0.0f }, 1.0f });
+        requireSameAsPolygons();
+    }
+}
+
+TEST_CASE("Submitted command lists", "[sini::SimpleRenderer][sini::RenderCommandList]")
+{
+    Polygon concave{ { -0.9f, -0.9f }, { -0.1f, -0.9f }, { -0.5f, -0.5f },
+                     { -0.1f, -0.1f }, { -0.9f, -0.1f } };
+    // The same calls are recorded in a list and made directly, after some
+    // queued draws, so that the list's elements have to be rebased
+    const auto drawFirst = [](auto& target) {
+        target.fillRectangle({ -1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, 1.0f);
+        target.drawCircle({ 0.5f, 0.5f }, 0.4f, { 1.0f, 1.0f, 1.0f }, 1.0f);
+    };
+    const auto drawSecond = [&concave](auto& target) {
+        target.fillCircle({ 0.5f, 0.5f }, 0.3f, { 0.0f, 1.0f, 0.0f }, 0.5f);
+        target.fillPolygon(concave, { 0.0f, 0.0f, 1.0f }, 1.0f);
+        target.drawRectangle({ 0.1f, -0.9f }, { 0.9f, -0.1f }, { 1.0f, 1.0f, 0.0f }, 1.0f);
+        target.fillRectangle({ -0.75f, 0.25f }, { 0.75f, 0.75f }, { 0.0f, 1.0f, 1.0f }, 0.5f);
+    };
+
+    for (VertexStreaming streaming : { VertexStreaming::BUFFER_SUB_DATA,
+                                       VertexStreaming::RING_BUFFER })
+    {
+        RenderSettings settings;
+        settings.vertex_streaming = streaming;
+        SimpleRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f), settings };
+
+        renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        renderer.fillRectangle({ 0.0f, -1.0f }, { 1.0f, 0.0f }, { 0.5f, 0.5f, 0.5f }, 1.0f);
+        drawFirst(renderer);
+        drawSecond(renderer);
+        renderer.updateScreen();
+        const std::vector<uint8_t> direct = renderer.readPixels();
+
+        std::vector<RenderCommandList> lists(2);
+        for (RenderCommandList& list : lists)
+            list.setPixelsPerUnit(renderer.pixelsPerUnit());
+        drawFirst(lists[0]);
+        drawSecond(lists[1]);
+        renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        renderer.fillRectangle({ 0.0f, -1.0f }, { 1.0f, 0.0f }, { 0.5f, 0.5f, 0.5f }, 1.0f);
+        renderer.submit(lists[0]);
+        renderer.submit(std::vector<RenderCommandList>(lists.begin() + 1, lists.end()));
+        renderer.updateScreen();
+        REQUIRE(renderer.readPixels() == direct);
+        // Not all black
+        REQUIRE(closeTo(pixelAt(direct, 4, 4), { 255, 0, 0 }));
+    }
+}
+
+TEST_CASE("Frame stats and GPU timing", "[sini::SimpleRenderer]")
+{
+    SimpleRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f) };
+    FrameLog log;
+    renderer.setFrameLog(&log);
+
+    constexpr int n_frames = 2 * GpuTimer::n_frames + 1;
+    for (int i = 0; i < n_frames; ++i) {
+        renderer.clear();
+        renderer.fillRectangle({ -1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, 1.0f);
+        renderer.drawCircle({ 0.0f, 0.0f }, 0.5f, { 0.0f, 1.0f, 0.0f }, 1.0f);
+        renderer.updateScreen();
+        // Never more than a ring of frames in flight
+        REQUIRE(log.frames().size() + GpuTimer::n_frames >= size_t(i + 1));
+    }
+    const FrameStats& latest = renderer.frameStats();
+    REQUIRE(latest.frame_index == n_frames - 1);
+    REQUIRE(latest.gpu_draw_ms < 0.0);
+    renderer.setFrameLog(nullptr);
+
+    REQUIRE(log.frames().size() == n_frames);
+    const size_t circle_vertices = curveSegments(0.5f, renderer.pixelsPerUnit());
+    for (int i = 0; i < n_frames; ++i) {
+        const FrameStats& stats = log.frames()[i];
+        REQUIRE(stats.frame_index == uint64_t(i));
+        REQUIRE(stats.draw_calls == 2);
+        REQUIRE(stats.vertices == 4 + circle_vertices);
+        REQUIRE(stats.elements == 6 + 2 * circle_vertices);
+        REQUIRE(stats.gpu_draw_ms >= 0.0);
+        REQUIRE(stats.gpu_present_ms >= 0.0);
+        REQUIRE(stats.cpu_submit_ms > 0.0);
+    }
+    // The buffers are allocated up front
+    REQUIRE(log.frames()[0].buffer_growths == 0);
+}
+
+TEST_CASE("Asynchronous frame capture", "[sini::FrameCapture]")
+{
+    SimpleRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f) };
+    std::vector<CapturedFrame> frames;
+    FrameCapture capture{ [&frames](CapturedFrame frame) {
+        frames.push_back(std::move(frame));
+    } };
+    renderer.setFrameCapture(&capture);
+
+    constexpr int n_frames = 2 * FrameCapture::n_buffers + 1;
+    for (int i = 0; i < n_frames; ++i) {
+        renderer.clear(vec4(i / 255.0f, 0.0f, 0.0f, 1.0f));
+        renderer.fillRectangle({ -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, 1.0f);
+        renderer.updateScreen();
+        // Never more than a ring of frames in flight
+        REQUIRE(frames.size() + FrameCapture::n_buffers >= size_t(i + 1));
+    }
+    renderer.setFrameCapture(nullptr);
+    renderer.updateScreen();
+    capture.finish();
+
+    REQUIRE(frames.size() == n_frames);
+    for (int i = 0; i < n_frames; ++i) {
+        const CapturedFrame& frame = frames[i];
+        REQUIRE(frame.index == uint64_t(i));
+        REQUIRE(frame.dimensions == dims);
+        REQUIRE(frame.pixels.size() == 4 * dims.x * dims.y);
+        // Top left quadrant is green, the rest has the clear color
+        const size_t top_left = 4 * (16 * dims.x + 16),
+                     bottom_left = 4 * (48 * dims.x + 16);
+        REQUIRE(frame.pixels[top_left + 1] == 255);
+        REQUIRE(frame.pixels[bottom_left] == i);
+        REQUIRE(frame.pixels[bottom_left + 3] == 255);
+    }
+}
@@ -0,0 +1,93 @@
+#include <sini2D/geometry/Polygon.hpp>
+#include <sini2D/gl/PrimitiveVertices.hpp>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+
+using namespace sini;
+
+namespace {
+
+constexpr float pi = 3.1415926535f;
+
+vec2 positionOf(const ColorVertex& vertex)
+{
+    return vec2(vertex[0], vertex[1]);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("Curve level of detail", "[sini::PrimitiveVertices]")
+{
+    SECTION("Segments grow with the size on screen, in powers of two") {
+        REQUIRE(curveSegments(1.0f, 0.0f) == 64);
+        REQUIRE(curveSegments(0.001f, 100.0f) == 8);
+        REQUIRE(curveSegments(1000.0f, 1000.0f) == 1024);
+        int previous = 8;
+        for (float radius_px = 0.5f; radius_px < 1e4f; radius_px *= 1.5f) {
+            const int n = curveSegments(radius_px, 1.0f);
+            REQUIRE(n >= previous);
+            REQUIRE((n & (n - 1)) == 0);
+            // Chords within a quarter of a pixel, below the maximum detail
+            if (n < 1024)
+                REQUIRE(radius_px * (1.0f - std::cos(pi / n)) <= 0.2501f);
+            previous = n;
+        }
+        // Same segments for the same size on screen
+        REQUIRE(curveSegments(2.0f, 50.0f) == curveSegments(100.0f, 1.0f));
+    }
+    SECTION("Tessellations are shared per level of detail") {
+        for (int n = 8; n <= 1024; n *= 2) {
+            const Polygon& circle = unitCircle(n);
+            REQUIRE(&circle == &unitCircle(n));
+            REQUIRE(circle.vertices.size() == size_t(n));
+            REQUIRE(circle.triangle_mesh->size() == size_t(n - 2));
+        }
+        // Also for the fixed unit circle of unit shapes
+        REQUIRE(&unitCircle() == &unitCircle(curveSegments(1.0f, 0.0f)));
+    }
+    SECTION("Arcs") {
+        REQUIRE(numArcSegments(0.5f * pi, 64) == 16);
+        REQUIRE(numArcSegments(-0.5f * pi, 64) == 16);
+        REQUIRE(numArcSegments(10.0f * pi, 64) == 64);
+        REQUIRE(numArcSegments(1e-6f, 64) == 1);
+
+        // Clockwise from straight up to the right, ending exactly
+        const float sweep = -0.6f * pi;
+        const size_t m = numArcSegments(sweep, 32);
+        std::vector<ColorVertex> vertices(m + 1);
+        std::vector<GLuint> elements(2*m);
+        writeArc({ vertices.data(), elements.data(), 10 }, { 1.0f, 1.0f }, 2.0f,
+                 0.5f * pi, sweep, 32, { 1.0f, 0.0f, 0.0f }, 1.0f);
+        REQUIRE(positionOf(vertices.front()).x == Approx(1.0f).margin(1e-5f));
+        REQUIRE(positionOf(vertices.front()).y == Approx(3.0f));
+        REQUIRE(positionOf(vertices.back()).x == Approx(1.0f + 2.0f*std::cos(-0.1f * pi)));
+        REQUIRE(positionOf(vertices.back()).y == Approx(1.0f + 2.0f*std::sin(-0.1f * pi)));
+        REQUIRE(positionOf(vertices[1]).x > 1.0f);
+        REQUIRE(elements.front() == 10);
+        REQUIRE(elements.back() == 10 + m);
+    }
+    SECTION("Rounded rectangles stay within their bounds") {
+        const int n = 16;
+        std::vector<ColorVertex> vertices(n + 4);
+        std::vector<GLuint> elements(3*(n + 2));
+        // The corner radius is clamped to half of the height
+        writeFilledRoundedRectangle({ vertices.data(), elements.data(), 0 },
+            { 0.0f, 0.0f }, { 4.0f, 1.0f }, 2.0f, n, { 1.0f, 0.0f, 0.0f }, 1.0f);
+        for (const ColorVertex& vertex : vertices) {
+            const vec2 p = positionOf(vertex);
+            REQUIRE(p.x >= -1e-5f);
+            REQUIRE(p.x <= 4.0f + 1e-5f);
+            REQUIRE(p.y >= -1e-5f);
+            REQUIRE(p.y <= 1.0f + 1e-5f);
+        }
+        REQUIRE(positionOf(vertices[0]).x == Approx(4.0f));
+        REQUIRE(positionOf(vertices[0]).y == Approx(0.5f));
+        for (GLuint element : elements)
+            REQUIRE(element < GLuint(n + 4));
+    }
+}
@@ -0,0 +1,136 @@
+#include <sini2D/geometry/Polygon.hpp>
+#include <sini2D/gl/RenderCommandList.hpp>
+#include <sini2D/util/ThreadPool.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+
+using namespace sini;
+
+TEST_CASE("Render command list recording", "[sini::RenderCommandList]")
+{
+    RenderCommandList list;
+    const vec3 color{ 1.0f, 0.5f, 0.0f };
+
+    SECTION("Consecutive draw calls of the same kind are batched") {
+        list.fillRectangle({ 0.0f, 0.0f }, { 1.0f, 1.0f }, color, 1.0f);
+        list.fillRectangle({ 1.0f, 0.0f }, { 2.0f, 1.0f }, color, 0.5f);
+        list.drawRectangle({ 0.0f, 0.0f }, { 1.0f, 1.0f }, color, 1.0f);
+        list.fillRectangle({ 2.0f, 0.0f }, { 3.0f, 1.0f }, color, 1.0f);
+        REQUIRE(list.numBatches() == 3);
+        REQUIRE(list.numVertices() == 16);
+        REQUIRE(list.numElements() == 6 + 6 + 8 + 6);
+    }
+    SECTION("Cursors are relative to the batch") {
+        list.fillRectangle({ 0.0f, 0.0f }, { 1.0f, 1.0f }, color, 1.0f);
+        VertexCursor cursor = list.reserveTriangles(3, 3);
+        REQUIRE(cursor.first_vertex == 4);
+        cursor = list.reserveLines(2, 2);
+        REQUIRE(cursor.first_vertex == 0);
+        cursor.vertices[0] = ColorVertex(0.0f);
+        cursor.vertices[1] = ColorVertex(1.0f);
+        cursor.elements[0] = cursor.first_vertex;
+        cursor.elements[1] = cursor.first_vertex + 1;
+        REQUIRE(list.numBatches() == 2);
+    }
+    SECTION("Invisible and degenerate primitives are skipped") {
+        Polygon line{ { 0.0f, 0.0f }, { 1.0f, 1.0f } };
+        list.fillPolygon(line, color, 1.0f);
+        list.fillCircle({ 0.0f, 0.0f }, 1.0f, color, 0.0f);
+        REQUIRE(list.empty());
+    }
+    SECTION("Polygons and circles") {
+        Polygon square{ { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+        list.fillPolygon(square, color, 1.0f);
+        REQUIRE(square.triangle_mesh != nullptr);
+        REQUIRE(list.numElements() == 6);
+        list.drawPolygon(square, color, 1.0f);
+        REQUIRE(list.numElements() == 6 + 8);
+
+        list.clear();
+        REQUIRE(list.empty());
+        list.fillCircle({ 0.0f, 0.0f }, 2.0f, color, 1.0f);
+        const size_t n = curveSegments(2.0f, 0.0f);
+        REQUIRE(list.numVertices() == n);
+        REQUIRE(list.numElements() == 3*(n-2));
+    }
+    SECTION("Unit shapes") {
+        const mat3 rotated_square = {{ 0.0f, -1.0f, 2.0f },
+                                     { 1.0f,  0.0f, 0.0f },
+                                     { 0.0f,  0.0f, 1.0f }};
+        list.fillShape(Shape::SQUARE, rotated_square, color, 1.0f);
+        list.drawShape(Shape::SQUARE, rotated_square, color, 1.0f);
+        REQUIRE(list.numVertices() == 8);
+        REQUIRE(list.numElements() == 6 + 8);
+        list.fillShape(Shape::CIRCLE, mat3::identity(), color, 0.0f);
+        list.fillShape(Shape::CIRCLE, mat3::identity(), color, 1.0f);
+        REQUIRE(list.numVertices() == 8 + numShapeVertices(Shape::CIRCLE));
+        REQUIRE(list.numElements() == 6 + 8 + numFilledShapeElements(Shape::CIRCLE));
+    }
+    SECTION("Curves are tessellated for their size on screen") {
+        list.fillEllipse({ 0.0f, 0.0f }, { 1.0f, 2.0f }, color, 1.0f);
+        REQUIRE(list.numVertices() == 64);
+        list.clear();
+        list.setPixelsPerUnit(1.0f);
+        list.fillEllipse({ 0.0f, 0.0f }, { 1.0f, 2.0f }, color, 1.0f);
+        REQUIRE(list.numVertices() == 8);
+        REQUIRE(list.numElements() == 3*6);
+        list.setPixelsPerUnit(1000.0f);
+        list.drawArc({ 0.0f, 0.0f }, 1.0f, 0.0f, 3.1415926535f, color, 1.0f);
+        const size_t m = numArcSegments(3.1415926535f, curveSegments(1.0f, 1000.0f));
+        REQUIRE(list.numVertices() == 8 + m+1);
+        REQUIRE(list.numElements() == 3*6 + 2*m);
+        list.clear();
+        list.fillRoundedRectangle({ 0.0f, 0.0f }, { 1.0f, 1.0f }, 0.1f, color, 1.0f);
+        list.drawRoundedRectangle({ 0.0f, 0.0f }, { 1.0f, 1.0f }, 0.1f, color, 1.0f);
+        const size_t n = curveSegments(0.1f, 1000.0f);
+        REQUIRE(list.numVertices() == 2*(n+4));
+        REQUIRE(list.numElements() == 3*(n+2) + 2*(n+4));
+        // Corners as drawn, at most half of the shorter side
+        list.clear();
+        list.fillRoundedRectangle({ 0.0f, 0.0f }, { 1.0f, 1.0f }, 100.0f, color, 1.0f);
+        const size_t n_clamped = curveSegments(0.5f, 1000.0f);
+        REQUIRE(n_clamped < size_t(curveSegments(100.0f, 1000.0f)));
+        REQUIRE(list.numVertices() == n_clamped + 4);
+        // Circles too, unlike unit shapes
+        list.clear();
+        list.setPixelsPerUnit(1.0f);
+        list.fillCircle({ 0.0f, 0.0f }, 1.0f, color, 1.0f);
+        list.drawCircle({ 0.0f, 0.0f }, 1.0f, color, 1.0f);
+        REQUIRE(list.numVertices() == 2*8);
+        REQUIRE(list.numElements() == 3*6 + 2*8);
+    }
+}
+
+TEST_CASE("Render command lists recorded in parallel", "[sini::RenderCommandList]")
+{
+    constexpr size_t n_lists = 8,
+                     n_shapes = 1000;
+    std::vector<RenderCommandList> lists(n_lists);
+    ThreadPool thread_pool{ 3 };
+    thread_pool.parallelFor(n_lists, [&](size_t i) {
+        for (size_t j = 0; j < n_shapes; j++) {
+            const vec2 position{ static_cast<float>(i), static_cast<float>(j) };
+            if (j % 2 == 0)
+                lists[i].fillCircle(position, 0.5f, vec3(1.0f), 1.0f);
+            else
+                lists[i].fillRectangle(position, position + vec2(1.0f), vec3(1.0f), 0.5f);
+        }
+    });
+
+    RenderCommandList sequential;
+    for (size_t j = 0; j < n_shapes; j++) {
+        const vec2 position{ 0.0f, static_cast<float>(j) };
+        if (j % 2 == 0)
+            sequential.fillCircle(position, 0.5f, vec3(1.0f), 1.0f);
+        else
+            sequential.fillRectangle(position, position + vec2(1.0f), vec3(1.0f), 0.5f);
+    }
+    for (const RenderCommandList& list : lists) {
+        REQUIRE(list.numBatches() == 1);
+        REQUIRE(list.numVertices() == sequential.numVertices());
+        REQUIRE(list.numElements() == sequential.numElements());
+    }
+}
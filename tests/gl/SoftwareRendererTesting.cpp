@@ -0,0 +1,119 @@
+#include <sini2D/geometry/Polygon.hpp>
+#include <sini2D/gl/Camera.hpp>
+#include <sini2D/gl/SoftwareRenderer.hpp>
+#include <sini2D/util/ThreadPool.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+
+using namespace sini;
+
+namespace {
+
+const vec2i dims{ 64, 64 };
+
+vec3i pixelAt(const std::vector<uint8_t>& pixels, int x, int y)
+{
+    const size_t i = 3 * (size_t(y) * dims.x + x);
+    return vec3i(pixels[i], pixels[i+1], pixels[i+2]);
+}
+
+int countPixels(const std::vector<uint8_t>& pixels, vec3i color)
+{
+    int count = 0;
+    for (int y = 0; y < dims.y; ++y)
+        for (int x = 0; x < dims.x; ++x)
+            if (pixelAt(pixels, x, y) == color)
+                count++;
+    return count;
+}
+
+// The world is [-1, 1] x [-1, 1], with y pointing up
+std::vector<uint8_t> renderScene(ThreadPool& thread_pool)
+{
+    SoftwareRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f), thread_pool };
+    renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    Polygon polygon{ { -0.9f, -0.8f }, { 0.7f, -0.95f }, { 0.1f, -0.1f },
+                     { 0.8f, 0.9f }, { -0.6f, 0.3f } };
+    renderer.fillPolygon(polygon, { 0.2f, 0.4f, 0.6f }, 0.7f);
+    for (int i = 0; i < 20; ++i)
+        renderer.fillCircle({ -0.8f + 0.08f * i, 0.05f * i }, 0.013f * i,
+                            { 1.0f, 0.05f * i, 0.0f }, 0.3f);
+    renderer.drawPolygon(polygon, { 1.0f, 1.0f, 1.0f }, 0.5f);
+    renderer.drawCircle({ 0.3f, 0.3f }, 0.5f, { 0.0f, 1.0f, 0.0f }, 1.0f);
+    return renderer.readPixels();
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("Software rendering", "[sini::SoftwareRenderer]")
+{
+    ThreadPool thread_pool{ 0 };
+    SoftwareRenderer renderer{ dims, Camera({ 0.0f, 0.0f }, 1.0f, 2.0f), thread_pool };
+    renderer.clear(vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    const vec3 red{ 1.0f, 0.0f, 0.0f };
+
+    SECTION("Rows are read back from top to bottom") {
+        renderer.fillRectangle({ -1.0f, 0.0f }, { 0.0f, 1.0f }, red, 1.0f);
+        const std::vector<uint8_t> pixels = renderer.readPixels();
+        REQUIRE(pixels.size() == 3 * dims.x * dims.y);
+        REQUIRE(pixelAt(pixels, 16, 16) == vec3i(255, 0, 0));
+        REQUIRE(pixelAt(pixels, 16, 48) == vec3i(0, 0, 0));
+    }
+    SECTION("Pixel centers on shared edges are covered exactly once") {
+        // Edges on pixel boundaries, and a translucent diagonal shared by the
+        // rectangle's two triangles
+        renderer.fillRectangle({ -1.0f, 0.0f }, { 0.0f, 1.0f }, red, 0.5f);
+        renderer.fillRectangle({ 0.0f, 0.0f }, { 1.0f, 1.0f }, red, 0.5f);
+        const std::vector<uint8_t> pixels = renderer.readPixels();
+        REQUIRE(countPixels(pixels, { 128, 0, 0 }) == dims.x * dims.y / 2);
+    }
+    SECTION("Circles are filled") {
+        renderer.fillCircle({ 0.5f, 0.5f }, 0.25f, red, 1.0f);
+        const std::vector<uint8_t> pixels = renderer.readPixels();
+        REQUIRE(pixelAt(pixels, 48, 16) == vec3i(255, 0, 0));
+        REQUIRE(pixelAt(pixels, 62, 1) == vec3i(0, 0, 0));
+    }
+    SECTION("Unit shapes are transformed") {
+        // Square rotated by 45 degrees, i.e. a diamond with corners 0.5 from
+        // its center
+        const mat3 diamond = {{ 0.5f, -0.5f, 0.5f },
+                              { 0.5f,  0.5f, 0.5f },
+                              { 0.0f,  0.0f, 1.0f }};
+        renderer.fillShape(Shape::SQUARE, diamond, red, 1.0f);
+        const std::vector<uint8_t> pixels = renderer.readPixels();
+        REQUIRE(pixelAt(pixels, 48, 16) == vec3i(255, 0, 0));
+        REQUIRE(pixelAt(pixels, 48, 2) == vec3i(255, 0, 0));
+        REQUIRE(pixelAt(pixels, 34, 2) == vec3i(0, 0, 0));
+    }
+    SECTION("Curves") {
+        renderer.fillRoundedRectangle({ -1.0f, -1.0f }, { 0.0f, 0.0f }, 0.5f, red, 1.0f);
+        // Quarter of a circle, clockwise from straight up
+        renderer.fillArc({ 0.0f, 0.0f }, 1.0f, 0.5f * 3.1415926535f, -0.5f * 3.1415926535f,
+                         red, 1.0f);
+        const std::vector<uint8_t> pixels = renderer.readPixels();
+        REQUIRE(pixelAt(pixels, 16, 48) == vec3i(255, 0, 0));
+        REQUIRE(pixelAt(pixels, 0, 48) == vec3i(255, 0, 0));
+        REQUIRE(pixelAt(pixels, 1, 62) == vec3i(0, 0, 0));
+        REQUIRE(pixelAt(pixels, 40, 24) == vec3i(255, 0, 0));
+        REQUIRE(pixelAt(pixels, 62, 1) == vec3i(0, 0, 0));
+        REQUIRE(pixelAt(pixels, 16, 16) == vec3i(0, 0, 0));
+    }
+    SECTION("Outlines are one pixel wide") {
+        // Through pixel centers, half a pixel (1/64) from pixel boundaries
+        const float h = 1.0f / 64.0f;
+        renderer.drawRectangle({ -0.5f + h, -0.5f + h }, { 0.5f + h, 0.5f + h }, red, 1.0f);
+        const std::vector<uint8_t> pixels = renderer.readPixels();
+        REQUIRE(pixelAt(pixels, 16, 32) == vec3i(255, 0, 0));
+        REQUIRE(pixelAt(pixels, 17, 32) == vec3i(0, 0, 0));
+        REQUIRE(pixelAt(pixels, 32, 32) == vec3i(0, 0, 0));
+    }
+    SECTION("Images are the same for any number of threads") {
+        ThreadPool four_threads{ 4 };
+        REQUIRE(renderScene(thread_pool) == renderScene(four_threads));
+    }
+}
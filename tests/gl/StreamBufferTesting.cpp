@@ -0,0 +1,73 @@
+#include <sini2D/gl/HeadlessContext.hpp>
+#include <sini2D/gl/StreamBuffer.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+
+using namespace sini;
+
+TEST_CASE("Stream buffer ring", "[sini::StreamBuffer]")
+{
+    HeadlessContext context{ 4, 2 };
+    glewInit();
+
+    // Ranges that don't divide the segments, so that most segments are
+    // entered by a range that started in the previous one
+    constexpr size_t segment_size = 4096,
+                     range_size = 1536,
+                     n_ranges = 8 * StreamBuffer::n_segments * segment_size / range_size;
+    constexpr size_t range_values = range_size / sizeof(uint32_t);
+
+    // Each range is copied by the GPU to its own place in 'copies', behind a
+    // large clear, so that the GPU lags behind and the ring is overwritten
+    // while copies of earlier laps are still queued
+    GLuint copies, framebuffer, renderbuffer;
+    glGenBuffers(1, &copies);
+    glBindBuffer(GL_COPY_READ_BUFFER, copies);
+    glBufferData(GL_COPY_READ_BUFFER, n_ranges * range_size, nullptr, GL_STATIC_READ);
+    glGenRenderbuffers(1, &renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, 2048, 2048);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                              renderbuffer);
+
+    for (StreamBuffer::Mode mode : { StreamBuffer::Mode::PERSISTENT_MAPPING,
+                                     StreamBuffer::Mode::ORPHANING })
+    {
+        StreamBuffer stream{ segment_size, mode };
+        for (size_t i = 0; i < n_ranges; i++) {
+            uint32_t* values = static_cast<uint32_t*>(stream.map(range_size));
+            for (size_t j = 0; j < range_values; j++)
+                values[j] = static_cast<uint32_t>(i * range_values + j);
+            stream.commit(range_size);
+
+            glClearColor(float(i % 2), 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glBindBuffer(GL_COPY_READ_BUFFER, stream.handle());
+            glBindBuffer(GL_COPY_WRITE_BUFFER, copies);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                                stream.offset(), i * range_size, range_size);
+            stream.fence();
+        }
+
+        std::vector<uint32_t> copied(n_ranges * range_values);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, copies);
+        glGetBufferSubData(GL_COPY_WRITE_BUFFER, 0, n_ranges * range_size, copied.data());
+        size_t n_wrong = 0;
+        for (size_t k = 0; k < copied.size(); k++)
+            n_wrong += copied[k] != k;
+        REQUIRE(n_wrong == 0);
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteRenderbuffers(1, &renderbuffer);
+    glDeleteBuffers(1, &copies);
+}
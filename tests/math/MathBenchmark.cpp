@@ -0,0 +1,129 @@
+// Compares the SIMD versions of some float vector and matrix operations with
+// the generic (scalar) templates, which are called with explicit template
+// arguments. Build with SINI_2D_ENABLE_SIMD for the comparison to make sense.
+// Also compares bulk transformation of points stored as std::vector<vec2> and
+// as a Vec2Array.
+#include <sini2D/math/Matrix.hpp>
+#include <sini2D/math/VectorArray.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+using namespace sini;
+
+constexpr int n_operands = 1024;
+constexpr int n_repetitions = 2000;
+
+template<typename Operation>
+double averageTimeNs(Operation operation)
+{
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < n_repetitions; r++)
+        for (int i = 0; i < n_operands; i++)
+            operation(i);
+    const auto end_time = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double, std::nano> elapsed_time = end_time - start_time;
+    return elapsed_time.count() / (n_repetitions * n_operands);
+}
+
+void printRow(const char* operation, double scalar_time, double simd_time)
+{
+    constexpr int col_width = 18;
+    std::cout << std::left << std::setw(col_width) << operation
+              << std::setw(col_width) << scalar_time
+              << std::setw(col_width) << simd_time
+              << scalar_time / simd_time << "x" << std::endl;
+}
+
+
+int main()
+{
+#ifndef SINI_SIMD
+    std::cout << "Note: built without SIMD, both columns use the scalar versions" << std::endl;
+#endif
+    std::default_random_engine rand_engine{ 2207 };
+    std::uniform_real_distribution<float> dist{ -1.0f, 1.0f };
+    std::vector<mat4> mat4s(n_operands);
+    std::vector<mat3> mat3s(n_operands);
+    std::vector<vec4> vec4s(n_operands);
+    std::vector<vec3> vec3s(n_operands);
+    for (int i = 0; i < n_operands; i++) {
+        for (int j = 0; j < 16; j++) mat4s[i].data()[j] = dist(rand_engine);
+        for (int j = 0; j < 9; j++) mat3s[i].data()[j] = dist(rand_engine);
+        for (int j = 0; j < 4; j++) vec4s[i][j] = dist(rand_engine);
+        for (int j = 0; j < 3; j++) vec3s[i][j] = dist(rand_engine);
+    }
+    // Results are accumulated so that the work can't be optimized away
+    mat4 mat4_sink{ 0.0f };
+    vec4 vec4_sink{ 0.0f };
+    vec3 vec3_sink{ 0.0f };
+    float float_sink = 0.0f;
+    const int last = n_operands - 1;
+
+    std::cout << "Vector/matrix math benchmark (ns per operation)" << std::endl
+              << "--------------------------------------------------------------" << std::endl
+              << std::left << std::setw(18) << "operation" << std::setw(18) << "scalar"
+              << std::setw(18) << "SIMD" << "speedup" << std::endl;
+
+    printRow("mat4 * mat4",
+        averageTimeNs([&](int i) { mat4_sink += operator*<float,4,4,4>(mat4s[i], mat4s[last - i]); }),
+        averageTimeNs([&](int i) { mat4_sink += mat4s[i] * mat4s[last - i]; }));
+    printRow("mat4 * vec4",
+        averageTimeNs([&](int i) { vec4_sink += operator*<float,4,4>(mat4s[i], vec4s[i]); }),
+        averageTimeNs([&](int i) { vec4_sink += mat4s[i] * vec4s[i]; }));
+    printRow("mat3 * vec3",
+        averageTimeNs([&](int i) { vec3_sink += operator*<float,3,3>(mat3s[i], vec3s[i]); }),
+        averageTimeNs([&](int i) { vec3_sink += mat3s[i] * vec3s[i]; }));
+    printRow("dot(vec4)",
+        averageTimeNs([&](int i) { float_sink += dot<float,4>(vec4s[i], vec4s[last - i]); }),
+        averageTimeNs([&](int i) { float_sink += dot(vec4s[i], vec4s[last - i]); }));
+    printRow("normalize(vec4)",
+        averageTimeNs([&](int i) { vec4_sink += normalize<float,4>(vec4s[i]); }),
+        averageTimeNs([&](int i) { vec4_sink += normalize(vec4s[i]); }));
+    printRow("inverse(mat4)",
+        averageTimeNs([&](int i) { mat4_sink += inverse<float>(mat4s[i]); }),
+        averageTimeNs([&](int i) { mat4_sink += inverse(mat4s[i]); }));
+
+    // Bulk affine transformation of 1M points
+    constexpr int n_points = 1000000;
+    constexpr int n_transforms = 20;
+    std::vector<vec2> points(n_points);
+    for (vec2& point : points)
+        point = vec2(dist(rand_engine), dist(rand_engine));
+    Vec2Array point_array{ points };
+    const mat3 affine{{ 0.8f, -0.6f,  0.1f },
+                      { 0.6f,  0.8f, -0.2f },
+                      { 0.0f,  0.0f,  1.0f }};
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < n_transforms; r++) {
+        for (vec2& point : points) {
+            const vec3 transformed = affine * vec3(point.x, point.y, 1.0f);
+            point = vec2(transformed.x, transformed.y);
+        }
+    }
+    auto end_time = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double, std::milli> aos_time = end_time - start_time;
+
+    start_time = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < n_transforms; r++)
+        eqTransform(point_array, affine);
+    end_time = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double, std::milli> soa_time = end_time - start_time;
+
+    std::cout << std::endl << "Affine transformation of 1M points (ms)" << std::endl
+              << "--------------------------------------------------------------" << std::endl
+              << std::left << std::setw(18) << "std::vector<vec2>" << std::setw(18) << "Vec2Array"
+              << "speedup" << std::endl
+              << std::setw(18) << aos_time.count() / n_transforms
+              << std::setw(18) << soa_time.count() / n_transforms
+              << aos_time / soa_time << "x" << std::endl;
+    float_sink += points[0].x + point_array.x()[0];
+
+    std::cout << std::endl << "(checksum "
+              << float_sink + mat4_sink.e00 + vec4_sink.x + vec3_sink.x << ")" << std::endl;
+}
@@ -1271,6 +1271,77 @@ TEST_CASE("Inverse matrix", "[sini::Matrix]")
         };
         REQUIRE( approxEqual(inverse(m2), m2_inv, tol) );
     }
+    SECTION("Non-symmetric 3x3 matrix") {
+        mat3 m3{
+            { 2.0f, 0.0f, 1.0f },
+            { 1.0f, 1.0f, 0.0f },
+            { 0.0f, 3.0f, 1.0f }
+        }, m3_inv{ // According to WolframAlpha.com
+            {  0.2f,  0.6f, -0.2f },
+            { -0.2f,  0.4f,  0.2f },
+            {  0.6f, -1.2f,  0.4f }
+        };
+        REQUIRE( approxEqual(inverse(m3), m3_inv, 1e-6f) );
+    }
+    SECTION("4x4 matrix") {
+        mat4 m4{
+            { 1.0f, 0.0f, 2.0f, 0.0f },
+            { 0.0f, 1.0f, 0.0f, 3.0f },
+            { 0.0f, 0.0f, 1.0f, 0.0f },
+            { 4.0f, 0.0f, 0.0f, 1.0f }
+        }, m4_inv{
+            {  1.0f, 0.0f,  -2.0f,  0.0f },
+            { 12.0f, 1.0f, -24.0f, -3.0f },
+            {  0.0f, 0.0f,   1.0f,  0.0f },
+            { -4.0f, 0.0f,   8.0f,  1.0f }
+        };
+        REQUIRE( approxEqual(inverse(m4), m4_inv, 1e-6f) );
+        REQUIRE( approxEqual(m4 * inverse(m4), mat4::identity(), 1e-6f) );
+    }
+    SECTION("Singular 4x4 matrix") {
+        mat4 m5{
+            { 1.0f, 2.0f, 3.0f, 4.0f },
+            { 2.0f, 4.0f, 6.0f, 8.0f },
+            { 0.0f, 1.0f, 0.0f, 1.0f },
+            { 1.0f, 0.0f, 1.0f, 0.0f }
+        };
+        REQUIRE(inverse(m5) == mat4(0.0f));
+    }
+}
+
+TEST_CASE("Float matrix products", "[sini::Matrix]")
+{
+    // 4x4 and 3x3 float products may be computed with SIMD instructions, see
+    // sini2D/math/Simd.hpp
+    mat4 m1{
+        {  1.0f,  2.0f,  3.0f,  4.0f },
+        {  5.0f,  6.0f,  7.0f,  8.0f },
+        {  9.0f, 10.0f, 11.0f, 12.0f },
+        { 13.0f, 14.0f, 15.0f, 16.0f }
+    }, m2{
+        {  1.0f, 0.0f, -1.0f, 2.0f },
+        {  0.0f, 1.0f,  0.0f, 0.0f },
+        {  2.0f, 0.0f,  1.0f, 0.0f },
+        { -1.0f, 1.0f,  0.0f, 1.0f }
+    };
+    SECTION("4x4 matrix multiplication") {
+        REQUIRE(m1 * m2 == mat4({  3.0f,  6.0f,  2.0f,  6.0f },
+                                { 11.0f, 14.0f,  2.0f, 18.0f },
+                                { 19.0f, 22.0f,  2.0f, 30.0f },
+                                { 27.0f, 30.0f,  2.0f, 42.0f }));
+        REQUIRE(m1 * mat4::identity() == m1);
+    }
+    SECTION("4x4 matrix-vector multiplication") {
+        REQUIRE(m1 * vec4(1.0f, -1.0f, 2.0f, 0.5f) == vec4(7.0f, 17.0f, 27.0f, 37.0f));
+    }
+    SECTION("3x3 matrix-vector multiplication") {
+        mat3 m3{
+            { 1.0f, 2.0f, 3.0f },
+            { 4.0f, 5.0f, 6.0f },
+            { 7.0f, 8.0f, 9.0f }
+        };
+        REQUIRE(m3 * vec3(1.0f, -1.0f, 2.0f) == vec3(5.0f, 11.0f, 17.0f));
+    }
 }
 
 TEST_CASE("Matrix Abs", "[sini::Matrix]")
@@ -0,0 +1,70 @@
+#include <sini2D/gl/Camera.hpp>
+#include <sini2D/math/Transform.hpp>
+#include <sini2D/math/VectorUtilities.hpp>
+#include <sini2D/util/ThreadPool.hpp>
+#include <sini2D/util/testutil.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+
+using namespace sini;
+
+// Odd number of points, to also cover the remainder after the SIMD loops
+std::vector<vec2> testPoints(size_t n_points)
+{
+    std::vector<vec2> points(n_points);
+    for (size_t i = 0; i < n_points; i++)
+        points[i] = vec2(0.01f*i - 3.0f, 2.0f - 0.003f*i);
+    return points;
+}
+
+void requirePointsTransformed(const mat3& transf, const std::vector<vec2>& points,
+                              const std::vector<vec2>& transformed)
+{
+    REQUIRE(points.size() == transformed.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        const vec3 expected = transf * vec3(points[i].x, points[i].y, 1.0f);
+        REQUIRE_APPROX_EQUAL(transformed[i], vec2(expected.x, expected.y), 1e-5f);
+    }
+}
+
+TEST_CASE("Transform points", "[sini::transformPoints]")
+{
+    const mat3 transf = Camera{ { 3.0f, -1.0f }, 1.5f, 4.0f, 0.3f }.worldToCameraViewMatrix();
+    const std::vector<vec2> points = testPoints(1001);
+
+    SECTION("Out of place") {
+        std::vector<vec2> transformed(points.size());
+        transformPoints(transf, points.data(), transformed.data(), points.size());
+        requirePointsTransformed(transf, points, transformed);
+    }
+    SECTION("In place") {
+        std::vector<vec2> transformed = points;
+        transformPoints(transf, transformed.data(), transformed.size());
+        requirePointsTransformed(transf, points, transformed);
+    }
+    SECTION("No points") {
+        transformPoints(transf, nullptr, nullptr, 0);
+    }
+}
+
+TEST_CASE("Transform points in parallel", "[sini::transformPoints]")
+{
+    const mat3 transf{{ 0.0f, -2.0f,  1.0f },
+                      { 2.0f,  0.0f, -1.0f },
+                      { 0.0f,  0.0f,  1.0f }};
+    // Several chunks, the last one partial
+    const std::vector<vec2> points = testPoints(300001);
+    ThreadPool thread_pool{ 3 };
+
+    std::vector<vec2> transformed(points.size());
+    transformPoints(transf, points.data(), transformed.data(), points.size(), thread_pool);
+    requirePointsTransformed(transf, points, transformed);
+
+    std::vector<vec2> transformed_in_place = points;
+    transformPoints(transf, transformed_in_place.data(), transformed_in_place.size(),
+                    thread_pool);
+    REQUIRE(transformed_in_place == transformed);
+}
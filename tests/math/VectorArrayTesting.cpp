@@ -0,0 +1,103 @@
+#include <sini2D/math/VectorArray.hpp>
+#include <sini2D/math/VectorUtilities.hpp>
+#include <sini2D/util/testutil.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+
+using namespace sini;
+
+TEST_CASE("Vector array construction and conversion", "[sini::VectorArray]")
+{
+    std::vector<vec2> vectors{{ 1.0f, 2.0f }, { 3.0f, 4.0f }, { 5.0f, 6.0f }};
+
+    SECTION("Zero vectors") {
+        Vec3Array arr(4);
+        REQUIRE(arr.size() == 4);
+        for (size_t i = 0; i < arr.size(); i++)
+            REQUIRE(arr[i] == vec3(0.0f));
+    }
+    SECTION("From std::vector") {
+        Vec2Array arr{ vectors };
+        REQUIRE(arr.size() == 3);
+        REQUIRE(arr.x()[1] == 3.0f);
+        REQUIRE(arr.y()[2] == 6.0f);
+        REQUIRE(arr[0] == vec2(1.0f, 2.0f));
+        REQUIRE(arr.toVector() == vectors);
+    }
+    SECTION("Lanes are aligned") {
+        Vec3Array arr{ 5 };
+        REQUIRE(reinterpret_cast<std::uintptr_t>(arr.x()) % 32 == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(arr.y()) % 32 == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(arr.z()) % 32 == 0);
+    }
+    SECTION("Set and push_back") {
+        Vec2Array arr{ vectors };
+        arr.set(1, vec2(-1.0f, -2.0f));
+        arr.push_back(vec2(7.0f, 8.0f));
+        REQUIRE(arr.size() == 4);
+        REQUIRE(arr[1] == vec2(-1.0f, -2.0f));
+        REQUIRE(arr[3] == vec2(7.0f, 8.0f));
+    }
+}
+
+TEST_CASE("Vector array bulk operations", "[sini::VectorArray]")
+{
+    // Enough vectors for the vectorized loops to also have remainders
+    std::vector<vec2> vectors;
+    for (int i = 0; i < 37; i++)
+        vectors.push_back(vec2(static_cast<float>(i) + 1.0f, 2.0f - 0.5f*i));
+    Vec2Array arr{ vectors };
+
+    SECTION("Addition and scaling") {
+        arr += arr;
+        arr += vec2(1.0f, -1.0f);
+        arr *= 0.5f;
+        for (size_t i = 0; i < vectors.size(); i++)
+            REQUIRE(arr[i] == 0.5f * (2.0f * vectors[i] + vec2(1.0f, -1.0f)));
+        arr -= arr;
+        REQUIRE(arr[7] == vec2(0.0f));
+    }
+    SECTION("Rotation") {
+        mat2 rotation{{ 0.0f, -1.0f },
+                      { 1.0f,  0.0f }};
+        eqTransform(arr, rotation);
+        for (size_t i = 0; i < vectors.size(); i++)
+            REQUIRE(arr[i] == rotation * vectors[i]);
+    }
+    SECTION("Affine transformation") {
+        mat3 affine{{ 2.0f, 0.0f,  3.0f },
+                    { 0.0f, 1.0f, -4.0f },
+                    { 0.0f, 0.0f,  1.0f }};
+        eqTransform(arr, affine);
+        for (size_t i = 0; i < vectors.size(); i++)
+            REQUIRE(arr[i] == vec2(2.0f*vectors[i].x + 3.0f, vectors[i].y - 4.0f));
+    }
+    SECTION("Length, dot and normalization") {
+        std::vector<float> lengths(arr.size()), dots(arr.size());
+        length(arr, lengths.data());
+        dot(arr, arr, dots.data());
+        eqNormalize(arr);
+        for (size_t i = 0; i < vectors.size(); i++) {
+            REQUIRE_APPROX_EQUAL(lengths[i], length(vectors[i]), 1e-5f);
+            REQUIRE_APPROX_EQUAL(dots[i], dot(vectors[i], vectors[i]), 1e-5f);
+            REQUIRE_APPROX_EQUAL(arr[i], normalize(vectors[i]), 1e-6f);
+        }
+    }
+    SECTION("3D transformation") {
+        Vec3Array arr3(3);
+        arr3.set(0, vec3(1.0f, 0.0f, 0.0f));
+        arr3.set(1, vec3(0.0f, 1.0f, 0.0f));
+        arr3.set(2, vec3(1.0f, 2.0f, 3.0f));
+        mat3 m{{ 1.0f, 2.0f, 3.0f },
+               { 4.0f, 5.0f, 6.0f },
+               { 7.0f, 8.0f, 9.0f }};
+        eqTransform(arr3, m);
+        REQUIRE(arr3[0] == vec3(1.0f, 4.0f, 7.0f));
+        REQUIRE(arr3[1] == vec3(2.0f, 5.0f, 8.0f));
+        REQUIRE(arr3[2] == vec3(14.0f, 32.0f, 50.0f));
+    }
+}
@@ -479,6 +479,14 @@ TEST_CASE("Dot/scalar product", "[sini::Vector]")
 
     REQUIRE(v1 == vec3i( 3, 5, 7));
     REQUIRE(v2 == vec3i(-1, 0, 1));
+
+    SECTION("4D float vectors") {
+        // May be computed with SIMD instructions, see sini2D/math/Simd.hpp
+        vec4 v3{ 1.0f, -2.0f, 3.0f, 0.5f },
+             v4{ 2.0f,  1.0f, 1.0f, 4.0f };
+        REQUIRE(dot(v3, v4) == 5.0f);
+        REQUIRE((v4 | v3) == 5.0f);
+    }
 }
 
 TEST_CASE("Cross product", "[sini::Vector]")
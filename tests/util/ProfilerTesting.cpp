@@ -0,0 +1,77 @@
+#include <sini2D/util/Profiler.hpp>
+
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+
+using namespace sini;
+
+namespace {
+
+size_t countOccurrences(const std::string& text, const std::string& pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + 1))
+        count++;
+    return count;
+}
+
+std::string chromeTrace()
+{
+    std::stringstream trace;
+    Profiler::writeChromeTrace(trace);
+    return trace.str();
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("Profile scopes", "[sini::Profiler]")
+{
+    Profiler::clear();
+
+    SECTION("Nested scopes on several threads") {
+        {
+            SINI_PROFILE_SCOPE("outer");
+            for (int i = 0; i < 3; i++) {
+                SINI_PROFILE_SCOPE("inner \"quoted\"");
+            }
+        }
+        std::thread thread{ []() {
+            Profiler::setThreadName("test thread");
+            SINI_PROFILE_SCOPE("other thread");
+        } };
+        thread.join();
+
+        // Scopes of finished threads are kept
+        const std::string trace = chromeTrace();
+        REQUIRE(trace.rfind("{\"traceEvents\":[", 0) == 0);
+        REQUIRE(countOccurrences(trace, "\"ph\":\"X\"") == 5);
+        REQUIRE(countOccurrences(trace, "{\"name\":\"outer\"") == 1);
+        REQUIRE(countOccurrences(trace, "{\"name\":\"inner \\\"quoted\\\"\"") == 3);
+        REQUIRE(countOccurrences(trace, "{\"name\":\"other thread\"") == 1);
+        REQUIRE(countOccurrences(trace, "\"args\":{\"name\":\"test thread\"}") == 1);
+    }
+    SECTION("Older scopes are overwritten") {
+        for (size_t i = 0; i < Profiler::events_per_thread + 10; i++) {
+            SINI_PROFILE_SCOPE("scope");
+        }
+        REQUIRE(countOccurrences(chromeTrace(), "\"ph\":\"X\"") == Profiler::events_per_thread);
+    }
+    SECTION("Clearing") {
+        {
+            SINI_PROFILE_SCOPE("cleared");
+        }
+        Profiler::clear();
+        {
+            SINI_PROFILE_SCOPE("kept");
+        }
+        const std::string trace = chromeTrace();
+        REQUIRE(countOccurrences(trace, "\"ph\":\"X\"") == 1);
+        REQUIRE(countOccurrences(trace, "\"kept\"") == 1);
+    }
+}
@@ -0,0 +1,44 @@
+#include <sini2D/util/ThreadPool.hpp>
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace sini;
+
+TEST_CASE("Thread pool parallel for", "[sini::ThreadPool]")
+{
+    SECTION("All tasks are run exactly once") {
+        for (uint32_t n_threads : { 0u, 1u, 4u }) {
+            ThreadPool thread_pool{ n_threads };
+            REQUIRE(thread_pool.numThreads() == n_threads);
+
+            std::vector<std::atomic<int>> n_calls(1000);
+            for (int repetition = 0; repetition < 10; repetition++)
+                thread_pool.parallelFor(n_calls.size(), [&](size_t i) { n_calls[i]++; });
+            for (const std::atomic<int>& n : n_calls)
+                REQUIRE(n == 10);
+        }
+    }
+    SECTION("No tasks") {
+        ThreadPool thread_pool{ 2 };
+        thread_pool.parallelFor(0, [](size_t) { FAIL("No task should be run"); });
+    }
+    SECTION("Exceptions are propagated") {
+        ThreadPool thread_pool{ 2 };
+        std::atomic<int> n_finished{ 0 };
+        REQUIRE_THROWS_AS(thread_pool.parallelFor(100, [&](size_t i) {
+            if (i == 42) throw std::runtime_error("task failed");
+            n_finished++;
+        }), const std::runtime_error&);
+        // The other tasks are still run
+        REQUIRE(n_finished == 99);
+
+        // and the pool is still usable
+        thread_pool.parallelFor(10, [&](size_t) { n_finished++; });
+        REQUIRE(n_finished == 109);
+    }
+}